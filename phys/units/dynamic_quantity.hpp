@@ -0,0 +1,840 @@
+/**
+ * \file dynamic_quantity.hpp
+ *
+ * \brief   Quantities with dimensions known at run time, and their conversion to static quantities.
+ * \author  Martin Moene
+ * \date    16 October 2026
+ * \since   1.2
+ *
+ * This code is provided as-is, with no warrantee of correctness.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+/*
+ * A dimension_key packs the seven exponents of a dimensions<> type into the
+ * bytes of a 64-bit integer. Comparing dimensions is a single integer
+ * comparison; multiplication and division add and subtract all exponents
+ * at once (SWAR: SIMD within a register).
+ *
+ * A dynamic_quantity<T> holds a magnitude in SI units and a dimension_key.
+ * Its arithmetic checks the keys at run time and throws dimension_error on
+ * a mismatch. quantity_cast<Dims>() converts it to quantity<Dims, T>. A
+ * static quantity mixes with a dynamic_quantity in arithmetic and
+ * comparisons as a dynamic_quantity of its dimensions.
+ *
+ * Data whose units are only known after reading a file header typically
+ * come in columns. A dynamic_vector<T> is such a column: many magnitudes
+ * with one dimension_key. quantity_cast<Dims>() of a dynamic_vector checks
+ * the key once and yields a quantity_vector<Dims, T>; from an rvalue it takes
+ * over the storage without copying. dispatch<Dims...>( key, f ) selects the
+ * static dimensions that match a key without a hand-written switch:
+ *
+ *   dispatch< length_d, speed_d >( column.key(), [&]( auto d )  // C++14
+ *   {
+ *       process( quantity_cast< decltype( d ) >( column ) );
+ *   } );
+ */
+
+#ifndef PHYS_UNITS_DYNAMIC_QUANTITY_HPP_INCLUDED
+#define PHYS_UNITS_DYNAMIC_QUANTITY_HPP_INCLUDED
+
+#include "phys/units/quantity.hpp"
+#include "phys/units/quantity_io_input.hpp"
+#include "phys/units/quantity_vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// namespace phys.
+
+namespace phys {
+
+/// namespace units.
+
+namespace units {
+
+/// dimension error, e.g. when adding quantities of different dimensions at run time.
+
+struct dimension_error : public quantity_error
+{
+    dimension_error( std::string const text )
+        : quantity_error( text ) { }
+};
+
+/**
+ * \brief class "dimension_key" holds the exponents of the seven base
+ * dimensions as signed bytes of a 64-bit integer.
+ */
+class dimension_key
+{
+public:
+    /// dimensionless.
+
+    constexpr dimension_key() : m_bits() { }
+
+    /**
+     * the key of dimensions type Dims.
+     */
+    template< typename Dims >
+    static constexpr dimension_key of()
+    {
+        return dimension_key( pack( Dims::dim1, 0 ) | pack( Dims::dim2, 1 ) | pack( Dims::dim3, 2 ) |
+                              pack( Dims::dim4, 3 ) | pack( Dims::dim5, 4 ) | pack( Dims::dim6, 5 ) |
+                              pack( Dims::dim7, 6 ) );
+    }
+
+    /**
+     * the key of the given exponents of length, mass, time, current, temperature, amount and intensity;
+     * throws dimension_error if an exponent does not fit a signed byte.
+     */
+    static dimension_key from_exponents( int const ( & exponents )[7] )
+    {
+        std::uint64_t bits = 0;
+
+        for ( int i = 0; i < 7; ++i )
+        {
+            if ( exponents[i] < -128 || exponents[i] > 127 )
+                throw dimension_error( "dimension_key: exponent out of range" );
+
+            bits |= pack( exponents[i], i );
+        }
+        return dimension_key( bits );
+    }
+
+    /**
+     * the exponent of base dimension i, 0 (length) .. 6 (luminous intensity).
+     */
+    constexpr int exponent( int const i ) const
+    {
+        return int( ( ( m_bits >> 8 * i ) & 0xff ) ^ 0x80 ) - 0x80;
+    }
+
+    /**
+     * the packed exponents.
+     */
+    constexpr std::uint64_t bits() const { return m_bits; }
+
+    constexpr bool is_dimensionless() const { return m_bits == 0; }
+
+    /**
+     * the key of the product of quantities with keys x and y.
+     */
+    friend dimension_key operator*( dimension_key const x, dimension_key const y )
+    {
+        std::uint64_t const sum = ( ( x.m_bits & ~high ) + ( y.m_bits & ~high ) ) ^ ( ( x.m_bits ^ y.m_bits ) & high );
+
+        check( ~( x.m_bits ^ y.m_bits ) & ( x.m_bits ^ sum ) & high );
+
+        return dimension_key( sum );
+    }
+
+    /**
+     * the key of the quotient of quantities with keys x and y.
+     */
+    friend dimension_key operator/( dimension_key const x, dimension_key const y )
+    {
+        std::uint64_t const difference = ( ( x.m_bits | high ) - ( y.m_bits & ~high ) ) ^ ( ( x.m_bits ^ ~y.m_bits ) & high );
+
+        check( ( x.m_bits ^ y.m_bits ) & ( x.m_bits ^ difference ) & high );
+
+        return dimension_key( difference );
+    }
+
+    friend constexpr bool operator==( dimension_key const x, dimension_key const y ) { return x.m_bits == y.m_bits; }
+
+    friend constexpr bool operator!=( dimension_key const x, dimension_key const y ) { return x.m_bits != y.m_bits; }
+
+private:
+    /// the sign bits of the seven bytes.
+
+    static constexpr std::uint64_t high = 0x0080808080808080u;
+
+    static constexpr std::uint64_t pack( int const exponent, int const i )
+    {
+        return std::uint64_t( static_cast<std::uint8_t>( exponent ) ) << 8 * i;
+    }
+
+    static void check( std::uint64_t const overflow )
+    {
+        if ( overflow )
+            throw dimension_error( "dimension_key: exponent out of range" );
+    }
+
+    constexpr explicit dimension_key( std::uint64_t const bits ) : m_bits( bits ) { }
+
+private:
+    std::uint64_t m_bits;
+};
+
+/// N-th power of the dimensions of key; throws dimension_error if an exponent does not fit.
+
+inline dimension_key dimension_power( dimension_key const key, int const n )
+{
+    int exponents[7];
+
+    for ( int i = 0; i < 7; ++i )
+        exponents[i] = key.exponent( i ) * n;
+
+    return dimension_key::from_exponents( exponents );
+}
+
+/// N-th root of the dimensions of key; throws dimension_error if an exponent is not a multiple of n.
+
+inline dimension_key dimension_root( dimension_key const key, int const n )
+{
+    int exponents[7];
+
+    for ( int i = 0; i < 7; ++i )
+    {
+        if ( key.exponent( i ) % n != 0 )
+            throw dimension_error( "dimension_key: root result dimensions must be integral" );
+
+        exponents[i] = key.exponent( i ) / n;
+    }
+    return dimension_key::from_exponents( exponents );
+}
+
+/**
+ * the dimensions of key in SI base units as unit_info<>::symbol() writes
+ * them, e.g. "m kg+2 s-2"; empty if dimensionless. from_chars() reads it back.
+ */
+inline std::string to_string( dimension_key const key )
+{
+    static char const * const symbols[] =
+    {
+        detail::base_seq<1>::type::value, detail::base_seq<2>::type::value, detail::base_seq<3>::type::value,
+        detail::base_seq<4>::type::value, detail::base_seq<5>::type::value, detail::base_seq<6>::type::value,
+        detail::base_seq<7>::type::value,
+    };
+
+    std::string result;
+
+    for ( int i = 0; i < 7; ++i )
+    {
+        if ( key.exponent( i ) == 0 )
+            continue;
+
+        if ( !result.empty() )
+            result += ' ';
+
+        result += symbols[i];
+
+        if ( key.exponent( i ) > 1 )
+            result += '+';
+
+        if ( key.exponent( i ) != 1 )
+            result += std::to_string( key.exponent( i ) );
+    }
+    return result;
+}
+
+/*
+ * declare now, define later.
+ */
+template< typename T = Rep >
+class dynamic_quantity;
+
+/// namespace detail.
+
+namespace detail {
+
+/**
+ * a dynamic_quantity is a quantity for the scalar operators of quantity.hpp.
+ */
+template< typename T >
+struct is_quantity< dynamic_quantity<T> > : std::true_type {};
+
+inline void require_same( dimension_key const x, dimension_key const y )
+{
+    if ( x != y )
+        throw dimension_error( "dynamic_quantity: dimensions '" + to_string( x ) + "' and '" + to_string( y ) + "' differ" );
+}
+
+template< typename F >
+bool dispatch_key( dimension_key const, F & )
+{
+    return false;
+}
+
+template< typename D, typename... Ds, typename F >
+bool dispatch_key( dimension_key const key, F & f )
+{
+    return key == dimension_key::of<D>() ? ( f( D() ), true ) : dispatch_key<Ds...>( key, f );
+}
+
+} // namespace detail
+
+/**
+ * call f( Dims() ) for the first of Dims... whose key equals key;
+ * returns false if there is none.
+ */
+template< typename... Dims, typename F >
+bool dispatch( dimension_key const key, F f )
+{
+    return detail::dispatch_key<Dims...>( key, f );
+}
+
+/**
+ * \brief class "dynamic_quantity" associates a magnitude with dimensions that
+ * are known at run time only; arithmetic checks them and throws dimension_error.
+ */
+template< typename T /*= Rep */ >
+class dynamic_quantity
+{
+public:
+    typedef T value_type;
+
+    /// dimensionless zero.
+
+    dynamic_quantity() : m_value(), m_key() { }
+
+    /**
+     * from a static quantity.
+     */
+    template< typename D, typename X >
+    dynamic_quantity( quantity<D, X> const & x )
+    : m_value( x.magnitude() ), m_key( dimension_key::of<D>() ) { }
+
+    /**
+     * from a magnitude in SI units and a key;
+     * requires magnitude_tag to prevent constructing a quantity from a raw magnitude.
+     */
+    template< typename X >
+    dynamic_quantity( detail::magnitude_tag_t, X const x, dimension_key const key )
+    : m_value( x ), m_key( key ) { }
+
+    /**
+     * the quantity's magnitude, in SI units.
+     */
+    value_type magnitude() const { return m_value; }
+
+    /**
+     * the quantity's dimensions.
+     */
+    dimension_key dimension() const { return m_key; }
+
+    /**
+     * true if the quantity has dimensions Dims.
+     */
+    template< typename Dims >
+    bool has_dimensions() const { return m_key == dimension_key::of<Dims>(); }
+
+    /// dquan += dquan
+
+    template< typename Y >
+    dynamic_quantity & operator+=( dynamic_quantity<Y> const & y )
+    {
+        detail::require_same( m_key, y.dimension() );
+        return m_value += y.magnitude(), *this;
+    }
+
+    /// dquan -= dquan
+
+    template< typename Y >
+    dynamic_quantity & operator-=( dynamic_quantity<Y> const & y )
+    {
+        detail::require_same( m_key, y.dimension() );
+        return m_value -= y.magnitude(), *this;
+    }
+
+    /// dquan += quan
+
+    template< typename D, typename Y >
+    dynamic_quantity & operator+=( quantity<D, Y> const & y )
+    {
+        return *this += dynamic_quantity<Y>( y );
+    }
+
+    /// dquan -= quan
+
+    template< typename D, typename Y >
+    dynamic_quantity & operator-=( quantity<D, Y> const & y )
+    {
+        return *this -= dynamic_quantity<Y>( y );
+    }
+
+    /// dquan *= num
+
+    template< typename Y, typename = typename std::enable_if< std::is_arithmetic<Y>::value >::type >
+    dynamic_quantity & operator*=( Y const & y )
+    {
+        return m_value *= y, *this;
+    }
+
+    /// dquan /= num
+
+    template< typename Y, typename = typename std::enable_if< std::is_arithmetic<Y>::value >::type >
+    dynamic_quantity & operator/=( Y const & y )
+    {
+        return m_value /= y, *this;
+    }
+
+private:
+    T m_value;
+    dimension_key m_key;
+};
+
+/**
+ * the static quantity with dimensions Dims; throws dimension_error if x has other dimensions.
+ */
+template< typename Dims, typename T >
+quantity<Dims, T> quantity_cast( dynamic_quantity<T> const & x )
+{
+    detail::require_same( x.dimension(), dimension_key::of<Dims>() );
+
+    return quantity<Dims, T>( detail::magnitude_tag, x.magnitude() );
+}
+
+// Arithmetic operators
+
+/// + dquan
+
+template< typename X >
+dynamic_quantity<X> operator+( dynamic_quantity<X> const & x )
+{
+    return x;
+}
+
+/// - dquan
+
+template< typename X >
+dynamic_quantity<X> operator-( dynamic_quantity<X> const & x )
+{
+    return dynamic_quantity<X>( detail::magnitude_tag, -x.magnitude(), x.dimension() );
+}
+
+/// dquan + dquan
+
+template< typename X, typename Y >
+dynamic_quantity< detail::PromoteAdd<X, Y> >
+operator+( dynamic_quantity<X> const & x, dynamic_quantity<Y> const & y )
+{
+    detail::require_same( x.dimension(), y.dimension() );
+
+    return dynamic_quantity< detail::PromoteAdd<X, Y> >( detail::magnitude_tag, x.magnitude() + y.magnitude(), x.dimension() );
+}
+
+/// dquan - dquan
+
+template< typename X, typename Y >
+dynamic_quantity< detail::PromoteAdd<X, Y> >
+operator-( dynamic_quantity<X> const & x, dynamic_quantity<Y> const & y )
+{
+    detail::require_same( x.dimension(), y.dimension() );
+
+    return dynamic_quantity< detail::PromoteAdd<X, Y> >( detail::magnitude_tag, x.magnitude() - y.magnitude(), x.dimension() );
+}
+
+/// dquan * dquan
+
+template< typename X, typename Y >
+dynamic_quantity< detail::PromoteMul<X, Y> >
+operator*( dynamic_quantity<X> const & x, dynamic_quantity<Y> const & y )
+{
+    return dynamic_quantity< detail::PromoteMul<X, Y> >( detail::magnitude_tag, x.magnitude() * y.magnitude(), x.dimension() * y.dimension() );
+}
+
+/// dquan / dquan
+
+template< typename X, typename Y >
+dynamic_quantity< detail::PromoteMul<X, Y> >
+operator/( dynamic_quantity<X> const & x, dynamic_quantity<Y> const & y )
+{
+    return dynamic_quantity< detail::PromoteMul<X, Y> >( detail::magnitude_tag, x.magnitude() / y.magnitude(), x.dimension() / y.dimension() );
+}
+
+/// dquan * num
+
+template< typename X, typename Y, typename = typename std::enable_if< std::is_arithmetic<Y>::value >::type >
+dynamic_quantity< detail::PromoteMul<X, Y> >
+operator*( dynamic_quantity<X> const & x, Y const & y )
+{
+    return dynamic_quantity< detail::PromoteMul<X, Y> >( detail::magnitude_tag, x.magnitude() * y, x.dimension() );
+}
+
+/// num * dquan
+
+template< typename X, typename Y, typename = typename std::enable_if< std::is_arithmetic<X>::value >::type >
+dynamic_quantity< detail::PromoteMul<X, Y> >
+operator*( X const & x, dynamic_quantity<Y> const & y )
+{
+    return dynamic_quantity< detail::PromoteMul<X, Y> >( detail::magnitude_tag, x * y.magnitude(), y.dimension() );
+}
+
+/// dquan / num
+
+template< typename X, typename Y, typename = typename std::enable_if< std::is_arithmetic<Y>::value >::type >
+dynamic_quantity< detail::PromoteMul<X, Y> >
+operator/( dynamic_quantity<X> const & x, Y const & y )
+{
+    return dynamic_quantity< detail::PromoteMul<X, Y> >( detail::magnitude_tag, x.magnitude() / y, x.dimension() );
+}
+
+/// num / dquan
+
+template< typename X, typename Y, typename = typename std::enable_if< std::is_arithmetic<X>::value >::type >
+dynamic_quantity< detail::PromoteMul<X, Y> >
+operator/( X const & x, dynamic_quantity<Y> const & y )
+{
+    return dynamic_quantity< detail::PromoteMul<X, Y> >( detail::magnitude_tag, x / y.magnitude(), dimension_key() / y.dimension() );
+}
+
+// Mixed operators with a static quantity, which converts to a dynamic_quantity.
+
+/// dquan + quan
+
+template< typename X, typename D, typename Y >
+dynamic_quantity< detail::PromoteAdd<X, Y> >
+operator+( dynamic_quantity<X> const & x, quantity<D, Y> const & y )
+{
+    return x + dynamic_quantity<Y>( y );
+}
+
+/// quan + dquan
+
+template< typename D, typename X, typename Y >
+dynamic_quantity< detail::PromoteAdd<X, Y> >
+operator+( quantity<D, X> const & x, dynamic_quantity<Y> const & y )
+{
+    return dynamic_quantity<X>( x ) + y;
+}
+
+/// dquan - quan
+
+template< typename X, typename D, typename Y >
+dynamic_quantity< detail::PromoteAdd<X, Y> >
+operator-( dynamic_quantity<X> const & x, quantity<D, Y> const & y )
+{
+    return x - dynamic_quantity<Y>( y );
+}
+
+/// quan - dquan
+
+template< typename D, typename X, typename Y >
+dynamic_quantity< detail::PromoteAdd<X, Y> >
+operator-( quantity<D, X> const & x, dynamic_quantity<Y> const & y )
+{
+    return dynamic_quantity<X>( x ) - y;
+}
+
+/// dquan * quan
+
+template< typename X, typename D, typename Y >
+dynamic_quantity< detail::PromoteMul<X, Y> >
+operator*( dynamic_quantity<X> const & x, quantity<D, Y> const & y )
+{
+    return x * dynamic_quantity<Y>( y );
+}
+
+/// quan * dquan
+
+template< typename D, typename X, typename Y >
+dynamic_quantity< detail::PromoteMul<X, Y> >
+operator*( quantity<D, X> const & x, dynamic_quantity<Y> const & y )
+{
+    return dynamic_quantity<X>( x ) * y;
+}
+
+/// dquan / quan
+
+template< typename X, typename D, typename Y >
+dynamic_quantity< detail::PromoteMul<X, Y> >
+operator/( dynamic_quantity<X> const & x, quantity<D, Y> const & y )
+{
+    return x / dynamic_quantity<Y>( y );
+}
+
+/// quan / dquan
+
+template< typename D, typename X, typename Y >
+dynamic_quantity< detail::PromoteMul<X, Y> >
+operator/( quantity<D, X> const & x, dynamic_quantity<Y> const & y )
+{
+    return dynamic_quantity<X>( x ) / y;
+}
+
+/// absolute value.
+
+template< typename X >
+dynamic_quantity<X> abs( dynamic_quantity<X> const & x )
+{
+    using std::abs;
+
+    return dynamic_quantity<X>( detail::magnitude_tag, abs( x.magnitude() ), x.dimension() );
+}
+
+/// N-th power.
+
+template< int N, typename X >
+dynamic_quantity<X> nth_power( dynamic_quantity<X> const & x )
+{
+    return dynamic_quantity<X>( detail::magnitude_tag, detail::magnitude_power<N>::of( x.magnitude() ), dimension_power( x.dimension(), N ) );
+}
+
+/// square root; throws dimension_error if the result dimensions are not integral.
+
+template< typename X >
+dynamic_quantity<X> sqrt( dynamic_quantity<X> const & x )
+{
+    return dynamic_quantity<X>( detail::magnitude_tag, detail::magnitude_root<2>::of( x.magnitude() ), dimension_root( x.dimension(), 2 ) );
+}
+
+// Comparison operators; throw dimension_error for different dimensions.
+
+/// equality.
+
+template< typename X, typename Y >
+bool operator==( dynamic_quantity<X> const & x, dynamic_quantity<Y> const & y )
+{
+    return detail::require_same( x.dimension(), y.dimension() ), x.magnitude() == y.magnitude();
+}
+
+/// inequality.
+
+template< typename X, typename Y >
+bool operator!=( dynamic_quantity<X> const & x, dynamic_quantity<Y> const & y )
+{
+    return !( x == y );
+}
+
+/// less-than.
+
+template< typename X, typename Y >
+bool operator<( dynamic_quantity<X> const & x, dynamic_quantity<Y> const & y )
+{
+    return detail::require_same( x.dimension(), y.dimension() ), x.magnitude() < y.magnitude();
+}
+
+/// less-equal.
+
+template< typename X, typename Y >
+bool operator<=( dynamic_quantity<X> const & x, dynamic_quantity<Y> const & y )
+{
+    return !( y < x );
+}
+
+/// greater-than.
+
+template< typename X, typename Y >
+bool operator>( dynamic_quantity<X> const & x, dynamic_quantity<Y> const & y )
+{
+    return y < x;
+}
+
+/// greater-equal.
+
+template< typename X, typename Y >
+bool operator>=( dynamic_quantity<X> const & x, dynamic_quantity<Y> const & y )
+{
+    return !( x < y );
+}
+
+// Mixed comparison operators with a static quantity; throw dimension_error for different dimensions.
+
+/// equality
+
+template< typename X, typename D, typename Y >
+bool operator==( dynamic_quantity<X> const & x, quantity<D, Y> const & y )
+{
+    return x == dynamic_quantity<Y>( y );
+}
+
+template< typename D, typename X, typename Y >
+bool operator==( quantity<D, X> const & x, dynamic_quantity<Y> const & y )
+{
+    return dynamic_quantity<X>( x ) == y;
+}
+
+/// inequality
+
+template< typename X, typename D, typename Y >
+bool operator!=( dynamic_quantity<X> const & x, quantity<D, Y> const & y )
+{
+    return x != dynamic_quantity<Y>( y );
+}
+
+template< typename D, typename X, typename Y >
+bool operator!=( quantity<D, X> const & x, dynamic_quantity<Y> const & y )
+{
+    return dynamic_quantity<X>( x ) != y;
+}
+
+/// less-than
+
+template< typename X, typename D, typename Y >
+bool operator<( dynamic_quantity<X> const & x, quantity<D, Y> const & y )
+{
+    return x < dynamic_quantity<Y>( y );
+}
+
+template< typename D, typename X, typename Y >
+bool operator<( quantity<D, X> const & x, dynamic_quantity<Y> const & y )
+{
+    return dynamic_quantity<X>( x ) < y;
+}
+
+/// less-equal
+
+template< typename X, typename D, typename Y >
+bool operator<=( dynamic_quantity<X> const & x, quantity<D, Y> const & y )
+{
+    return x <= dynamic_quantity<Y>( y );
+}
+
+template< typename D, typename X, typename Y >
+bool operator<=( quantity<D, X> const & x, dynamic_quantity<Y> const & y )
+{
+    return dynamic_quantity<X>( x ) <= y;
+}
+
+/// greater-than
+
+template< typename X, typename D, typename Y >
+bool operator>( dynamic_quantity<X> const & x, quantity<D, Y> const & y )
+{
+    return x > dynamic_quantity<Y>( y );
+}
+
+template< typename D, typename X, typename Y >
+bool operator>( quantity<D, X> const & x, dynamic_quantity<Y> const & y )
+{
+    return dynamic_quantity<X>( x ) > y;
+}
+
+/// greater-equal
+
+template< typename X, typename D, typename Y >
+bool operator>=( dynamic_quantity<X> const & x, quantity<D, Y> const & y )
+{
+    return x >= dynamic_quantity<Y>( y );
+}
+
+template< typename D, typename X, typename Y >
+bool operator>=( quantity<D, X> const & x, dynamic_quantity<Y> const & y )
+{
+    return dynamic_quantity<X>( x ) >= y;
+}
+
+/**
+ * \brief class "dynamic_vector" is a column of magnitudes with one set of
+ * dimensions known at run time, e.g. read from a file header.
+ */
+template< typename T = Rep >
+class dynamic_vector
+{
+public:
+    typedef T magnitude_type;
+
+    typedef dynamic_quantity<T> value_type;
+
+    typedef std::size_t size_type;
+
+    typedef std::vector< T, detail::aligned_allocator<T> > storage_type;
+
+    /**
+     * empty column with the given dimensions.
+     */
+    explicit dynamic_vector( dimension_key const key ) : m_key( key ), m_data() { }
+
+    /**
+     * n zero-valued elements with the given dimensions.
+     */
+    dynamic_vector( dimension_key const key, size_type const n ) : m_key( key ), m_data( n ) { }
+
+    dimension_key key() const { return m_key; }
+
+    size_type size() const { return m_data.size(); }
+
+    bool empty() const { return m_data.empty(); }
+
+    void reserve( size_type const n ) { m_data.reserve( n ); }
+
+    /**
+     * append q; throws dimension_error if its dimensions differ from the column's.
+     */
+    void push_back( value_type const & q )
+    {
+        detail::require_same( m_key, q.dimension() );
+        m_data.push_back( q.magnitude() );
+    }
+
+    value_type operator[]( size_type const i ) const { return value_type( detail::magnitude_tag, m_data[i], m_key ); }
+
+    /**
+     * the raw magnitudes in SI units, e.g. to fill the column without a check per element.
+     */
+    magnitude_type       * magnitudes()       { return m_data.data(); }
+    magnitude_type const * magnitudes() const { return m_data.data(); }
+
+    /**
+     * give up the storage, e.g. to a quantity_vector.
+     */
+    storage_type release() { return std::move( m_data ); }
+
+private:
+    dimension_key m_key;
+    storage_type m_data;
+};
+
+/**
+ * the column as quantity_vector<Dims, T>, a copy; checks the dimensions once
+ * and throws dimension_error if they differ from Dims.
+ */
+template< typename Dims, typename T >
+quantity_vector<Dims, T> quantity_cast( dynamic_vector<T> const & v )
+{
+    detail::require_same( v.key(), dimension_key::of<Dims>() );
+
+    return quantity_vector<Dims, T>( detail::magnitude_tag, v.magnitudes(), v.magnitudes() + v.size() );
+}
+
+/**
+ * the column as quantity_vector<Dims, T>, taking over its storage; checks the
+ * dimensions once and throws dimension_error if they differ from Dims.
+ */
+template< typename Dims, typename T >
+quantity_vector<Dims, T> quantity_cast( dynamic_vector<T> && v )
+{
+    detail::require_same( v.key(), dimension_key::of<Dims>() );
+
+    return quantity_vector<Dims, T>( detail::magnitude_tag, v.release() );
+}
+
+/**
+ * parse a quantity of any dimensions from text at [first, last), e.g. "12.5 km/h".
+ */
+template< typename T >
+from_chars_result from_chars( char const * first, char const * last, dynamic_quantity<T> & q )
+{
+    T magnitude = T();
+    detail::unit_value unit;
+
+    from_chars_result const result = detail::parse_quantity( first, last, magnitude, unit );
+
+    if ( result.ec != std::errc() )
+        return result;
+
+    for ( int const exponent : unit.dims )
+    {
+        if ( exponent < -128 || exponent > 127 )
+            return { result.ptr, std::errc::result_out_of_range };
+    }
+
+    q = dynamic_quantity<T>( detail::magnitude_tag, magnitude, dimension_key::from_exponents( unit.dims ) );
+
+    return result;
+}
+
+}} // namespace phys::units
+
+#endif // PHYS_UNITS_DYNAMIC_QUANTITY_HPP_INCLUDED
+
+/*
+ * end of file
+ */
@@ -0,0 +1,403 @@
+/**
+ * \file fixed_point.hpp
+ *
+ * \brief   Saturating binary fixed-point numbers for quantities on targets without FPU.
+ * \author  Martin Moene
+ * \date    16 October 2026
+ * \since   1.2
+ *
+ * This code is provided as-is, with no warrantee of correctness.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+/*
+ * A fixed_point<FracBits, Int> holds a number in Q-format: an integer of
+ * type Int that counts units of 2^-FracBits. For example q16_16 holds values
+ * in [-32768, 32768) with a resolution of 1/65536 in an std::int32_t.
+ *
+ * fixed_point serves as representation type of quantity, e.g.
+ * quantity<speed_d, q16_16>. All arithmetic is done in integers:
+ *
+ * - addition and subtraction saturate at the limits of Int;
+ * - multiplication takes the product in the next wider integer type and
+ *   shifts it back with rounding to nearest, then saturates;
+ * - division shifts the dividend up in the wider type, truncates towards
+ *   zero and saturates; division by zero gives the limit of the sign of the
+ *   dividend, or zero for zero;
+ * - abs(), sqrt() and cbrt() are found by argument-dependent lookup and make
+ *   abs(), sqrt(), nth_root<2^k>() and nth_root<3>() of quantity work; other
+ *   roots require floating point and do not compile.
+ *
+ * Numbers of different FracBits and floating-point numbers do not mix in
+ * arithmetic. Conversions are explicit, or implicit in the initialization of
+ * a quantity from a quantity with another representation. Initialize from
+ * constexpr floating-point quantities so that the conversion takes place at
+ * compile time:
+ *
+ *   constexpr quantity<length_d, q16_16> step = 2.5 * milli * meter;
+ *
+ * Right shifts of negative numbers are assumed to be arithmetic, as they are
+ * with all supported compilers.
+ */
+
+#ifndef PHYS_UNITS_FIXED_POINT_HPP_INCLUDED
+#define PHYS_UNITS_FIXED_POINT_HPP_INCLUDED
+
+#include "phys/units/quantity.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/// namespace phys.
+
+namespace phys {
+
+/// namespace units.
+
+namespace units {
+
+/// namespace detail.
+
+namespace detail {
+
+/**
+ * the integer type that holds the product of two Int.
+ */
+template< typename Int >
+struct wider;
+
+template<> struct wider< std::int8_t  > { typedef std::int16_t type; };
+template<> struct wider< std::int16_t > { typedef std::int32_t type; };
+template<> struct wider< std::int32_t > { typedef std::int64_t type; };
+
+/**
+ * x clamped to the range of Int.
+ */
+template< typename Int, typename W >
+constexpr Int saturate( W const x )
+{
+    return x > std::numeric_limits<Int>::max() ? std::numeric_limits<Int>::max()
+         : x < std::numeric_limits<Int>::min() ? std::numeric_limits<Int>::min()
+         : static_cast<Int>( x );
+}
+
+/**
+ * floating-point x in units of 2^-F, rounded to nearest and clamped to the range of Int; NaN gives zero.
+ */
+template< typename Int, int F, typename X >
+constexpr Int fixed_from_floating( X const x )
+{
+    return x != x ? Int( 0 )
+         : x * X( std::intmax_t( 1 ) << F ) >= X( std::numeric_limits<Int>::max() ) ? std::numeric_limits<Int>::max()
+         : x * X( std::intmax_t( 1 ) << F ) <= X( std::numeric_limits<Int>::min() ) ? std::numeric_limits<Int>::min()
+         : static_cast<Int>( x * X( std::intmax_t( 1 ) << F ) + ( x < 0 ? X( -0.5 ) : X( 0.5 ) ) );
+}
+
+/**
+ * integer square root of x, rounded down.
+ */
+inline std::uint64_t isqrt( std::uint64_t x )
+{
+    std::uint64_t result = 0;
+    std::uint64_t bit = std::uint64_t( 1 ) << 62;
+
+    while ( bit > x )
+    {
+        bit >>= 2;
+    }
+
+    for ( ; bit != 0; bit >>= 2 )
+    {
+        if ( x >= result + bit )
+        {
+            x -= result + bit;
+            result = ( result >> 1 ) + bit;
+        }
+        else
+        {
+            result >>= 1;
+        }
+    }
+    return result;
+}
+
+/**
+ * integer cube root of x, rounded down.
+ */
+inline std::uint64_t icbrt( std::uint64_t x )
+{
+    std::uint64_t result = 0;
+
+    for ( int shift = 63; shift >= 0; shift -= 3 )
+    {
+        result <<= 1;
+
+        std::uint64_t const b = 3 * result * ( result + 1 ) + 1;
+
+        if ( ( x >> shift ) >= b )
+        {
+            x -= b << shift;
+            ++result;
+        }
+    }
+    return result;
+}
+
+} // namespace detail
+
+/**
+ * \brief class "fixed_point" is a signed binary fixed-point number with
+ * FracBits fraction bits in an integer of type Int, with saturating arithmetic.
+ */
+template< int FracBits, typename Int = std::int32_t >
+class fixed_point
+{
+public:
+    typedef Int raw_type;
+
+    typedef typename detail::wider<Int>::type wide_type;
+
+    static constexpr int frac_bits = FracBits;
+
+    constexpr fixed_point() : m_raw() { }
+
+    /**
+     * the number x, saturated.
+     */
+    constexpr explicit fixed_point( int const x )
+    : m_raw( detail::saturate<Int>( std::intmax_t( x ) * ( std::intmax_t( 1 ) << FracBits ) ) ) { }
+
+    /**
+     * the floating-point number x, rounded to nearest and saturated.
+     */
+    template< typename X, typename = typename std::enable_if< std::is_floating_point<X>::value >::type >
+    constexpr explicit fixed_point( X const x )
+    : m_raw( detail::fixed_from_floating<Int, FracBits>( x ) ) { }
+
+    /**
+     * the number with the given integer representation, i.e. raw * 2^-FracBits.
+     */
+    static constexpr fixed_point from_raw( Int const raw ) { return fixed_point( raw_tag(), raw ); }
+
+    /**
+     * the integer representation.
+     */
+    constexpr Int raw() const { return m_raw; }
+
+    /**
+     * conversion to floating point.
+     */
+    template< typename X, typename = typename std::enable_if< std::is_floating_point<X>::value >::type >
+    constexpr explicit operator X() const { return X( m_raw ) / X( std::intmax_t( 1 ) << FracBits ); }
+
+    /// fix += fix
+
+    fixed_point & operator+=( fixed_point const & y ) { return *this = *this + y; }
+
+    /// fix -= fix
+
+    fixed_point & operator-=( fixed_point const & y ) { return *this = *this - y; }
+
+    /// fix *= fix or integer
+
+    template< typename Y >
+    fixed_point & operator*=( Y const & y ) { return *this = *this * y; }
+
+    /// fix /= fix or integer
+
+    template< typename Y >
+    fixed_point & operator/=( Y const & y ) { return *this = *this / y; }
+
+private:
+    struct raw_tag {};
+
+    constexpr fixed_point( raw_tag, Int const raw ) : m_raw( raw ) { }
+
+private:
+    Int m_raw;
+
+    static_assert( std::is_signed<Int>::value, "fixed_point requires a signed integer type" );
+    static_assert( FracBits > 0 && FracBits < std::numeric_limits<Int>::digits, "fixed_point requires 0 < FracBits < digits of Int" );
+};
+
+/// Q16.16: 16 integer and 16 fraction bits in 32 bits.
+
+typedef fixed_point<16, std::int32_t> q16_16;
+
+/// Q8.8: 8 integer and 8 fraction bits in 16 bits.
+
+typedef fixed_point< 8, std::int16_t> q8_8;
+
+/// namespace detail.
+
+namespace detail {
+
+template< typename Y >
+using EnableIfInt = typename std::enable_if< std::is_integral<Y>::value && sizeof( Y ) <= sizeof( int ) >::type;
+
+} // namespace detail
+
+// Arithmetic operators
+
+/// + fix
+
+template< int F, typename I >
+constexpr fixed_point<F, I> operator+( fixed_point<F, I> const & x )
+{
+    return x;
+}
+
+/// - fix, saturated.
+
+template< int F, typename I >
+constexpr fixed_point<F, I> operator-( fixed_point<F, I> const & x )
+{
+    return fixed_point<F, I>::from_raw( detail::saturate<I>( -typename fixed_point<F, I>::wide_type( x.raw() ) ) );
+}
+
+/// fix + fix, saturated.
+
+template< int F, typename I >
+constexpr fixed_point<F, I> operator+( fixed_point<F, I> const & x, fixed_point<F, I> const & y )
+{
+    return fixed_point<F, I>::from_raw( detail::saturate<I>( typename fixed_point<F, I>::wide_type( x.raw() ) + y.raw() ) );
+}
+
+/// fix - fix, saturated.
+
+template< int F, typename I >
+constexpr fixed_point<F, I> operator-( fixed_point<F, I> const & x, fixed_point<F, I> const & y )
+{
+    return fixed_point<F, I>::from_raw( detail::saturate<I>( typename fixed_point<F, I>::wide_type( x.raw() ) - y.raw() ) );
+}
+
+/// fix * fix, rounded to nearest and saturated.
+
+template< int F, typename I >
+constexpr fixed_point<F, I> operator*( fixed_point<F, I> const & x, fixed_point<F, I> const & y )
+{
+    typedef typename fixed_point<F, I>::wide_type W;
+
+    return fixed_point<F, I>::from_raw( detail::saturate<I>( ( W( x.raw() ) * y.raw() + ( W( 1 ) << ( F - 1 ) ) ) >> F ) );
+}
+
+/// fix * int, saturated.
+
+template< int F, typename I, typename Y, typename = detail::EnableIfInt<Y> >
+constexpr fixed_point<F, I> operator*( fixed_point<F, I> const & x, Y const & y )
+{
+    return fixed_point<F, I>::from_raw( detail::saturate<I>( std::intmax_t( x.raw() ) * y ) );
+}
+
+/// int * fix, saturated.
+
+template< int F, typename I, typename X, typename = detail::EnableIfInt<X> >
+constexpr fixed_point<F, I> operator*( X const & x, fixed_point<F, I> const & y )
+{
+    return y * x;
+}
+
+/// fix / fix, truncated and saturated.
+
+template< int F, typename I >
+constexpr fixed_point<F, I> operator/( fixed_point<F, I> const & x, fixed_point<F, I> const & y )
+{
+    typedef typename fixed_point<F, I>::wide_type W;
+
+    return fixed_point<F, I>::from_raw(
+        y.raw() != 0 ? detail::saturate<I>( W( x.raw() ) * ( W( 1 ) << F ) / y.raw() )
+        : x.raw() > 0 ? std::numeric_limits<I>::max()
+        : x.raw() < 0 ? std::numeric_limits<I>::min() : I( 0 ) );
+}
+
+/// fix / int, truncated and saturated.
+
+template< int F, typename I, typename Y, typename = detail::EnableIfInt<Y> >
+constexpr fixed_point<F, I> operator/( fixed_point<F, I> const & x, Y const & y )
+{
+    return fixed_point<F, I>::from_raw(
+        y != 0 ? detail::saturate<I>( std::intmax_t( x.raw() ) / y )
+        : x.raw() > 0 ? std::numeric_limits<I>::max()
+        : x.raw() < 0 ? std::numeric_limits<I>::min() : I( 0 ) );
+}
+
+/// int / fix, truncated and saturated.
+
+template< int F, typename I, typename X, typename = detail::EnableIfInt<X> >
+constexpr fixed_point<F, I> operator/( X const & x, fixed_point<F, I> const & y )
+{
+    return fixed_point<F, I>( x ) / y;
+}
+
+// Comparison operators
+
+/// equality.
+
+template< int F, typename I >
+constexpr bool operator==( fixed_point<F, I> const & x, fixed_point<F, I> const & y ) { return x.raw() == y.raw(); }
+
+/// inequality.
+
+template< int F, typename I >
+constexpr bool operator!=( fixed_point<F, I> const & x, fixed_point<F, I> const & y ) { return x.raw() != y.raw(); }
+
+/// less-than.
+
+template< int F, typename I >
+constexpr bool operator<( fixed_point<F, I> const & x, fixed_point<F, I> const & y ) { return x.raw() < y.raw(); }
+
+/// less-equal.
+
+template< int F, typename I >
+constexpr bool operator<=( fixed_point<F, I> const & x, fixed_point<F, I> const & y ) { return x.raw() <= y.raw(); }
+
+/// greater-than.
+
+template< int F, typename I >
+constexpr bool operator>( fixed_point<F, I> const & x, fixed_point<F, I> const & y ) { return x.raw() > y.raw(); }
+
+/// greater-equal.
+
+template< int F, typename I >
+constexpr bool operator>=( fixed_point<F, I> const & x, fixed_point<F, I> const & y ) { return x.raw() >= y.raw(); }
+
+// Functions
+
+/// absolute value, saturated.
+
+template< int F, typename I >
+constexpr fixed_point<F, I> abs( fixed_point<F, I> const & x )
+{
+    return x.raw() < 0 ? -x : x;
+}
+
+/// square root, rounded down; zero for negative x.
+
+template< int F, typename I >
+fixed_point<F, I> sqrt( fixed_point<F, I> const & x )
+{
+    return fixed_point<F, I>::from_raw( x.raw() <= 0 ? I( 0 ) :
+        static_cast<I>( detail::isqrt( std::uint64_t( x.raw() ) << F ) ) );
+}
+
+/// cube root, rounded towards zero.
+
+template< int F, typename I >
+fixed_point<F, I> cbrt( fixed_point<F, I> const & x )
+{
+    static_assert( std::numeric_limits<I>::digits + 2 * F <= 64, "cbrt() of fixed_point requires digits of Int + 2 * FracBits <= 64" );
+
+    return fixed_point<F, I>::from_raw( x.raw() < 0 ? I( -cbrt( -x ).raw() ) :
+        static_cast<I>( detail::icbrt( std::uint64_t( x.raw() ) << 2 * F ) ) );
+}
+
+}} // namespace phys::units
+
+#endif // PHYS_UNITS_FIXED_POINT_HPP_INCLUDED
+
+/*
+ * end of file
+ */
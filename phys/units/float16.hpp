@@ -0,0 +1,284 @@
+/**
+ * \file float16.hpp
+ *
+ * \brief   16-bit floating-point storage types half and bfloat16 for quantities.
+ * \author  Martin Moene
+ * \date    16 October 2026
+ * \since   1.2
+ *
+ * This code is provided as-is, with no warrantee of correctness.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+/*
+ * half (IEEE 754 binary16: 5 exponent bits, 10 fraction bits) and bfloat16
+ * (8 exponent bits, 7 fraction bits) halve the memory of float magnitudes.
+ * They are storage types: quantity<pressure_d, half> takes two bytes, but
+ * all arithmetic converts to float, so that quantity<pressure_d, half> plus
+ * quantity<pressure_d, half> is a quantity<pressure_d, float>. Assigning the
+ * result to a half quantity rounds it to nearest even, once, also from double.
+ *
+ * The conversions are emulated with integer and float operations without
+ * branches, so that loops over arrays, such as convert(), vectorize.
+ * half keeps about three significant digits, with a largest value of 65504
+ * and subnormal numbers down to 6e-8; bfloat16 has the range of float with
+ * about two significant digits.
+ */
+
+#ifndef PHYS_UNITS_FLOAT16_HPP_INCLUDED
+#define PHYS_UNITS_FLOAT16_HPP_INCLUDED
+
+#include "phys/units/quantity.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/// namespace phys.
+
+namespace phys {
+
+/// namespace units.
+
+namespace units {
+
+/// namespace detail.
+
+namespace detail {
+
+inline std::uint32_t bits_of( float const x )
+{
+    std::uint32_t u;
+    std::memcpy( &u, &x, sizeof u );
+    return u;
+}
+
+inline float float_of( std::uint32_t const u )
+{
+    float x;
+    std::memcpy( &x, &u, sizeof x );
+    return x;
+}
+
+/**
+ * binary16 bits of x, rounded to nearest even; NaN stays (quiet) NaN.
+ *
+ * The floating-point unit does the rounding: scaling |x| up and down by
+ * 2^112 and 2^-110 turns values too large for half into infinity, adding
+ * a power of two aligned to the exponent of x rounds the fraction to the
+ * ten bits of half, or fewer for subnormal results. The selection of NaN
+ * uses a mask: with a conditional, GCC moves the floating-point operations
+ * into a branch and no longer vectorizes at -O2.
+ */
+inline std::uint16_t half_from_float( float const x )
+{
+    std::uint32_t const u    = bits_of( x );
+    std::uint32_t const u2   = u + u;
+    std::uint32_t const sign = u & 0x80000000u;
+
+    float const base = float_of( u & 0x7fffffffu ) * float_of( 239u << 23 ) * float_of( 17u << 23 );
+
+    std::uint32_t const exponent = u2 & 0xff000000u;
+    std::uint32_t const bias     = exponent < 0x71000000u ? 0x71000000u : exponent;
+
+    std::uint32_t const rounded  = bits_of( float_of( ( bias >> 1 ) + 0x07800000u ) + base );
+    std::uint32_t const nonsign  = ( ( rounded >> 13 ) & 0x7c00u ) + ( rounded & 0x0fffu );
+
+    std::uint32_t const is_nan   = 0u - std::uint32_t( u2 > 0xff000000u );
+
+    return static_cast<std::uint16_t>( sign >> 16 | ( is_nan & 0x7e00u ) | ( ~is_nan & nonsign ) );
+}
+
+/**
+ * the value of binary16 bits h; exact.
+ *
+ * Normal numbers shift into place and the multiplication by 2^-112 rebiases
+ * the exponent, also of infinity and NaN; subnormal numbers are the
+ * difference of a float with the fraction in its lowest bits and 0.5.
+ * As above, a mask selects the result.
+ */
+inline float float_from_half( std::uint16_t const h )
+{
+    std::uint32_t const w    = std::uint32_t( h ) << 16;
+    std::uint32_t const w2   = w + w;
+    std::uint32_t const sign = w & 0x80000000u;
+
+    float const normal    = float_of( ( w2 >> 4 ) + ( 0xe0u << 23 ) ) * float_of( 15u << 23 );
+    float const subnormal = float_of( ( w2 >> 17 ) | ( 126u << 23 ) ) - 0.5f;
+
+    std::uint32_t const is_subnormal = 0u - std::uint32_t( w2 < ( 1u << 27 ) );
+
+    return float_of( sign | ( is_subnormal & bits_of( subnormal ) ) | ( ~is_subnormal & bits_of( normal ) ) );
+}
+
+/**
+ * bfloat16 bits of x, rounded to nearest even; NaN stays (quiet) NaN.
+ */
+inline std::uint16_t bfloat16_from_float( float const x )
+{
+    std::uint32_t const u = bits_of( x );
+
+    std::uint32_t const b = ( u & 0x7fffffffu ) > 0x7f800000u
+        ? ( u >> 16 ) | 0x40u
+        : ( u + 0x7fffu + ( ( u >> 16 ) & 1 ) ) >> 16;
+
+    return static_cast<std::uint16_t>( b );
+}
+
+/**
+ * the value of bfloat16 bits b; exact.
+ */
+inline float float_from_bfloat16( std::uint16_t const b )
+{
+    return float_of( std::uint32_t( b ) << 16 );
+}
+
+/**
+ * x rounded to float toward zero, with the last bit set if that is inexact
+ * (round to odd). As float has more than two bits more than half and
+ * bfloat16, rounding the result to either rounds as rounding x directly
+ * would, instead of rounding twice. Without branches, as above.
+ */
+inline float float_round_to_odd( double const x )
+{
+    float  const f    = static_cast<float>( x );
+    double const back = f;
+
+    std::uint32_t const inexact = std::uint32_t( back != x );
+    std::uint32_t const away    = std::uint32_t( std::fabs( back ) > std::fabs( x ) );
+
+    return float_of( ( bits_of( f ) - ( inexact & away ) ) | inexact );
+}
+
+/**
+ * binary16 bits of x, rounded once to nearest even.
+ */
+inline std::uint16_t half_from_double( double const x )
+{
+    return half_from_float( float_round_to_odd( x ) );
+}
+
+/**
+ * bfloat16 bits of x, rounded once to nearest even.
+ */
+inline std::uint16_t bfloat16_from_double( double const x )
+{
+    return bfloat16_from_float( float_round_to_odd( x ) );
+}
+
+/**
+ * 16-bit floating-point number with the conversions From and To of float and
+ * FromDouble of double; arithmetic takes place in float via the implicit
+ * conversion to float.
+ */
+template< std::uint16_t (*From)( float ), float (*To)( std::uint16_t ), std::uint16_t (*FromDouble)( double ) >
+class float16
+{
+public:
+    constexpr float16() : m_bits() { }
+
+    /**
+     * x, rounded to nearest even.
+     */
+    explicit float16( float const x ) : m_bits( From( x ) ) { }
+
+    /**
+     * x, rounded once to nearest even, not via float.
+     */
+    explicit float16( double const x ) : m_bits( FromDouble( x ) ) { }
+
+    /**
+     * x of another arithmetic type, such as int or long double, via double.
+     */
+    template< typename X, typename = typename std::enable_if< std::is_arithmetic<X>::value && !std::is_same<X, float>::value && !std::is_same<X, double>::value >::type >
+    explicit float16( X const x ) : m_bits( FromDouble( static_cast<double>( x ) ) ) { }
+
+    /**
+     * the number with the given bit pattern.
+     */
+    static constexpr float16 from_bits( std::uint16_t const bits ) { return float16( bits_tag(), bits ); }
+
+    /**
+     * the bit pattern.
+     */
+    constexpr std::uint16_t bits() const { return m_bits; }
+
+    /**
+     * the value as float; exact.
+     */
+    operator float() const { return To( m_bits ); }
+
+    /// f16 += num
+
+    float16 & operator+=( float const y ) { return *this = float16( *this + y ); }
+
+    /// f16 -= num
+
+    float16 & operator-=( float const y ) { return *this = float16( *this - y ); }
+
+    /// f16 *= num
+
+    float16 & operator*=( float const y ) { return *this = float16( *this * y ); }
+
+    /// f16 /= num
+
+    float16 & operator/=( float const y ) { return *this = float16( *this / y ); }
+
+private:
+    struct bits_tag {};
+
+    constexpr float16( bits_tag, std::uint16_t const bits ) : m_bits( bits ) { }
+
+private:
+    std::uint16_t m_bits;
+};
+
+} // namespace detail
+
+/// IEEE 754 binary16: 5 exponent and 10 fraction bits.
+
+typedef detail::float16< detail::half_from_float, detail::float_from_half, detail::half_from_double > half;
+
+/// bfloat16: 8 exponent and 7 fraction bits, the upper half of a float.
+
+typedef detail::float16< detail::bfloat16_from_float, detail::float_from_bfloat16, detail::bfloat16_from_double > bfloat16;
+
+/**
+ * convert the quantities in [first, last) to magnitude type Y and store them from out on;
+ * returns the end of the output. E.g. narrow float samples to half for storage and back.
+ */
+template< typename D, typename X, typename Y >
+quantity<D, Y> * convert( quantity<D, X> const * first, quantity<D, X> const * last, quantity<D, Y> * out )
+{
+    // blocks of fixed length, so that the compiler vectorizes without cost model.
+    std::size_t const block = 16;
+    std::size_t const n = static_cast<std::size_t>( last - first );
+
+    std::size_t i = 0;
+
+    for ( ; i + block <= n; i += block )
+    {
+        for ( std::size_t k = i; k < i + block; ++k )
+        {
+            out[k] = quantity<D, Y>( detail::magnitude_tag, static_cast<Y>( first[k].magnitude() ) );
+        }
+    }
+
+    for ( ; i < n; ++i )
+    {
+        out[i] = quantity<D, Y>( detail::magnitude_tag, static_cast<Y>( first[i].magnitude() ) );
+    }
+    return out + n;
+}
+
+}} // namespace phys::units
+
+#endif // PHYS_UNITS_FLOAT16_HPP_INCLUDED
+
+/*
+ * end of file
+ */
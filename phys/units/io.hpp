@@ -18,6 +18,7 @@
 
 #include "phys/units/quantity_io.hpp"
 #include "phys/units/quantity_io_engineering.hpp"
+#include "phys/units/quantity_io_input.hpp"
 #include "phys/units/quantity_io_symbols.hpp"
 
 #endif // PHYS_UNITS_IO_HPP_INCLUDED
@@ -0,0 +1,24 @@
+/**
+ * \file io_input.hpp
+ *
+ * \brief   Input for quantity library.
+ * \author  Martin Moene
+ * \date    16 October 2026
+ * \since   1.2
+ *
+ * This code is provided as-is, with no warrantee of correctness.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef PHYS_UNITS_IO_INPUT_HPP_INCLUDED
+#define PHYS_UNITS_IO_INPUT_HPP_INCLUDED
+
+#include "phys/units/quantity_io_input.hpp"
+
+#endif // PHYS_UNITS_IO_INPUT_HPP_INCLUDED
+
+/*
+ * end of file
+ */
@@ -76,6 +76,7 @@ constexpr quantity< thermodynamic_temperature_d > degree_rankine   { Rep( 5.5555
 constexpr quantity< dimensions< -1, 1, 0 >>  denier             { Rep( 1.111111e-7L ) * kilogram / meter };
 constexpr quantity< force_d >                dyne               { Rep( 1e-5L ) * newton };
 
+constexpr quantity< energy_d >               electronvolt       { Rep( 1.60217733e-19L ) * joule };  // eV of physical_constants.hpp
 constexpr quantity< energy_d >               erg                { Rep( 1e-7L ) * joule };
 
 constexpr quantity< electric_charge_d >      faraday            { Rep( 9.648531e+4L ) * coulomb };
@@ -23,6 +23,7 @@
 #define PHYS_UNITS_PHYSICAL_CONSTANTS_HPP_INCLUDED
 
 #include "phys/units/quantity.hpp"
+#include "phys/units/other_units.hpp"
 
 namespace phys { namespace units {
 
@@ -34,7 +35,7 @@ constexpr quantity< acceleration_d >
 constexpr quantity< dimensions< 0, 0, 0, 0, 0, -1 > >
                                 N_sub_A { Rep( 6.02214199e+23L ) / mole };
 // electronvolt
-constexpr quantity< energy_d >  eV { Rep( 1.60217733e-19L ) * joule };
+constexpr quantity< energy_d >  eV { electronvolt };
 
 // elementary charge
 constexpr quantity< electric_charge_d >
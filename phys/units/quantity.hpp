@@ -31,6 +31,7 @@
 
 #include <cmath>
 #include <cstdlib>
+#include <type_traits>
 #include <utility>  // std::declval
 
 // Configuration
@@ -39,6 +40,10 @@
 # define PHYS_UNITS_COLLAPSE_TO_REP  1
 #endif
 
+#ifndef  PHYS_UNITS_LITERAL_TYPE
+# define PHYS_UNITS_LITERAL_TYPE  long double
+#endif
+
 /// namespace phys.
 
 namespace phys {
@@ -104,14 +109,22 @@ typedef dimensions< 0, 0, 0 > dimensionless_d;
 
 namespace detail {
 
+/**
+ * tag to construct a quantity from a magnitude.
+ */
+constexpr struct magnitude_tag_t{} magnitude_tag{};
+
 /**
  * \brief The "collapse" template is used to avoid quantity< dimensions< 0, 0, 0 > >,
- * i.e. to make dimensionless results come out as type "Rep".
+ * i.e. to make dimensionless results come out as type "Rep";
+ * make() creates a value of the resulting type from a magnitude.
  */
 template< typename D, typename T >
 struct collapse
 {
     typedef quantity< D, T > type;
+
+    static constexpr type make( T x ) { return type( magnitude_tag, x ); }
 };
 
 #if defined( PHYS_UNITS_COLLAPSE_TO_REP )
@@ -120,6 +133,8 @@ template< typename T >
 struct collapse< dimensionless_d, T >
 {
     typedef T type;
+
+    static constexpr type make( T x ) { return x; }
 };
 
 #endif
@@ -135,142 +150,186 @@ using PromoteAdd = decltype( std::declval<X>() + std::declval<Y>() );
 template < typename X, typename Y >
 using PromoteMul = decltype( std::declval<X>() * std::declval<Y>() );
 
+// is T a quantity?
+
+template< typename T >
+struct is_quantity : std::false_type {};
+
+template< typename D, typename T >
+struct is_quantity< quantity<D, T> > : std::true_type {};
+
+// promote types of expression of quantity and scalar; no type if either is a quantity (SFINAE),
+// so that these overloads drop out early for an expression of two quantities.
+
+template < typename X, typename Y, bool = is_quantity<X>::value || is_quantity<Y>::value >
+struct promote_mul_scalar {};
+
+template < typename X, typename Y >
+struct promote_mul_scalar< X, Y, false > { typedef PromoteMul<X,Y> type; };
+
+template < typename X, typename Y >
+using PromoteMulScalar = typename promote_mul_scalar<X,Y>::type;
+
+// void, if T is a valid type (SFINAE).
+
+template< typename T >
+struct always_void { typedef void type; };
+
 /*
- * The following batch of structs are type generators to calculate
- * the correct type of the result of various operations.
+ * The following batch of alias templates are type generators to calculate
+ * the correct type of the result of various operations. They name the
+ * resulting dimensions directly, so that an operation only instantiates
+ * the dimensions and quantity types it yields.
  */
 
 /**
  * product type generator.
  */
-template< typename DX, typename DY, typename T >
-struct product
-{
-    enum
-    {
-        d1 = DX::dim1 + DY::dim1,
-        d2 = DX::dim2 + DY::dim2,
-        d3 = DX::dim3 + DY::dim3,
-        d4 = DX::dim4 + DY::dim4,
-        d5 = DX::dim5 + DY::dim5,
-        d6 = DX::dim6 + DY::dim6,
-        d7 = DX::dim7 + DY::dim7,
-    };
-
-    typedef Collapse< dimensions< d1, d2, d3, d4, d5, d6, d7 >, T > type;
-};
+template< typename DX, typename DY >
+using product_dimensions = dimensions<
+    DX::dim1 + DY::dim1, DX::dim2 + DY::dim2, DX::dim3 + DY::dim3, DX::dim4 + DY::dim4,
+    DX::dim5 + DY::dim5, DX::dim6 + DY::dim6, DX::dim7 + DY::dim7 >;
 
 template< typename DX, typename DY, typename X, typename Y>
-using Product = typename product<DX, DY, PromoteMul<X,Y>>::type;
+using Product = Collapse< product_dimensions<DX, DY>, PromoteMul<X,Y> >;
 
 /**
  * quotient type generator.
  */
-template< typename DX, typename DY, typename T >
-struct quotient
-{
-    enum
-    {
-        d1 = DX::dim1 - DY::dim1,
-        d2 = DX::dim2 - DY::dim2,
-        d3 = DX::dim3 - DY::dim3,
-        d4 = DX::dim4 - DY::dim4,
-        d5 = DX::dim5 - DY::dim5,
-        d6 = DX::dim6 - DY::dim6,
-        d7 = DX::dim7 - DY::dim7,
-    };
-
-    typedef Collapse< dimensions< d1, d2, d3, d4, d5, d6, d7 >, T > type;
-};
+template< typename DX, typename DY >
+using quotient_dimensions = dimensions<
+    DX::dim1 - DY::dim1, DX::dim2 - DY::dim2, DX::dim3 - DY::dim3, DX::dim4 - DY::dim4,
+    DX::dim5 - DY::dim5, DX::dim6 - DY::dim6, DX::dim7 - DY::dim7 >;
 
 template< typename DX, typename DY, typename X, typename Y>
-using Quotient = typename quotient<DX, DY, PromoteMul<X,Y>>::type;
+using Quotient = Collapse< quotient_dimensions<DX, DY>, PromoteMul<X,Y> >;
 
 /**
  * reciprocal type generator.
  */
-template< typename D, typename T >
-struct reciprocal
-{
-    enum
-    {
-        d1 = - D::dim1,
-        d2 = - D::dim2,
-        d3 = - D::dim3,
-        d4 = - D::dim4,
-        d5 = - D::dim5,
-        d6 = - D::dim6,
-        d7 = - D::dim7,
-    };
-
-    typedef Collapse< dimensions< d1, d2, d3, d4, d5, d6, d7 >, T > type;
-};
+template< typename D >
+using reciprocal_dimensions = dimensions<
+    - D::dim1, - D::dim2, - D::dim3, - D::dim4, - D::dim5, - D::dim6, - D::dim7 >;
 
 template< typename D, typename X, typename Y>
-using Reciprocal = typename reciprocal<D, PromoteMul<X,Y>>::type;
+using Reciprocal = Collapse< reciprocal_dimensions<D>, PromoteMulScalar<X,Y> >;
 
 /**
  * power type generator.
  */
-template< typename D, int N, typename T >
-struct power
-{
-    enum
-    {
-        d1 = N * D::dim1,
-        d2 = N * D::dim2,
-        d3 = N * D::dim3,
-        d4 = N * D::dim4,
-        d5 = N * D::dim5,
-        d6 = N * D::dim6,
-        d7 = N * D::dim7,
-    };
-
-    typedef Collapse< dimensions< d1, d2, d3, d4, d5, d6, d7 >, T > type;
-};
+template< typename D, int N >
+using power_dimensions = dimensions<
+    N * D::dim1, N * D::dim2, N * D::dim3, N * D::dim4, N * D::dim5, N * D::dim6, N * D::dim7 >;
 
 template< typename D, int N, typename T >
-using Power = typename detail::power< D, N, T >::type;
+using Power = Collapse< power_dimensions<D, N>, T >;
 
 /**
  * root type generator.
  */
+template< typename D, int N >
+using root_dimensions = dimensions<
+    D::dim1 / N, D::dim2 / N, D::dim3 / N, D::dim4 / N, D::dim5 / N, D::dim6 / N, D::dim7 / N >;
+
 template< typename D, int N, typename T >
-struct root
+using Root = Collapse< root_dimensions<D, N>, T >;
+
+/**
+ * true if all dimensions of D are a multiple of N.
+ */
+template< typename D, int N >
+constexpr bool all_even_multiples()
 {
-    enum
-    {
-        all_even_multiples =
-            D::dim1 % N == 0 &&
-            D::dim2 % N == 0 &&
-            D::dim3 % N == 0 &&
-            D::dim4 % N == 0 &&
-            D::dim5 % N == 0 &&
-            D::dim6 % N == 0 &&
-            D::dim7 % N == 0
-    };
+    return
+        D::dim1 % N == 0 && D::dim2 % N == 0 && D::dim3 % N == 0 && D::dim4 % N == 0 &&
+        D::dim5 % N == 0 && D::dim6 % N == 0 && D::dim7 % N == 0;
+}
 
-    enum
+/**
+ * N-th power of a magnitude by repeated squaring.
+ *
+ * As N is known at compile time, this unrolls into about log2(N)
+ * multiplications, which is as fast as writing them out by hand.
+ */
+template< int N, bool = ( N < 0 ) >
+struct magnitude_power
+{
+    template< typename T >
+    static constexpr T of( T const & x )
     {
-        d1 = D::dim1 / N,
-        d2 = D::dim2 / N,
-        d3 = D::dim3 / N,
-        d4 = D::dim4 / N,
-        d5 = D::dim5 / N,
-        d6 = D::dim6 / N,
-        d7 = D::dim7 / N
-    };
+        return N % 2 ? x * magnitude_power<N / 2>::of( x * x ) : magnitude_power<N / 2>::of( x * x );
+    }
+};
 
-    typedef Collapse< dimensions< d1, d2, d3, d4, d5, d6, d7 >, T > type;
+template< int N >
+struct magnitude_power< N, true >
+{
+    template< typename T >
+    static constexpr T of( T const & x ) { return T( 1 ) / magnitude_power<-N>::of( x ); }
 };
 
-template< typename D, int N, typename T >
-using Root = typename detail::root< D, N, T >::type;
+template<>
+struct magnitude_power< 0, false >
+{
+    template< typename T >
+    static constexpr T of( T const & ) { return T( 1 ); }
+};
+
+template<>
+struct magnitude_power< 1, false >
+{
+    template< typename T >
+    static constexpr T of( T const & x ) { return x; }
+};
 
 /**
- * tag to construct a quantity from a magnitude.
+ * N-th root of a magnitude.
+ *
+ * Uses sqrt() and cbrt() where possible and pow() otherwise; even roots take
+ * a square root first. The functions are looked up in std and, for other
+ * representation types such as fixed_point, by argument-dependent lookup.
  */
-constexpr struct magnitude_tag_t{} magnitude_tag{};
+template< int N, bool = ( N < 0 ), bool = ( N % 2 == 0 ) >
+struct magnitude_root
+{
+    template< typename T >
+    static T of( T const & x ) { using std::pow; return pow( x, T( 1.0 ) / N ); }
+};
+
+template< int N >
+struct magnitude_root< N, false, true >
+{
+    template< typename T >
+    static T of( T const & x ) { using std::sqrt; return magnitude_root<N / 2>::of( sqrt( x ) ); }
+};
+
+template< int N, bool Even >
+struct magnitude_root< N, true, Even >
+{
+    template< typename T >
+    static T of( T const & x ) { return T( 1 ) / magnitude_root<-N>::of( x ); }
+};
+
+template<>
+struct magnitude_root< 1, false, false >
+{
+    template< typename T >
+    static T of( T const & x ) { return x; }
+};
+
+template<>
+struct magnitude_root< 2, false, true >
+{
+    template< typename T >
+    static T of( T const & x ) { using std::sqrt; return sqrt( x ); }
+};
+
+template<>
+struct magnitude_root< 3, false, false >
+{
+    template< typename T >
+    static T of( T const & x ) { using std::cbrt; return cbrt( x ); }
+};
 
 } // namespace detail
 
@@ -339,6 +398,38 @@ public:
     static constexpr quantity zero() { return quantity{ value_type( 0.0 ) }; }
 //    static constexpr quantity zero = quantity{ value_type( 0.0 ) };
 
+    /// quan += quan
+
+    template <typename Y>
+    quantity & operator+=( quantity<Dims, Y> const & y )
+    {
+        return m_value += y.magnitude(), *this;
+    }
+
+    /// quan -= quan
+
+    template <typename Y>
+    quantity & operator-=( quantity<Dims, Y> const & y )
+    {
+        return m_value -= y.magnitude(), *this;
+    }
+
+    /// quan *= num
+
+    template <typename Y>
+    quantity & operator*=( Y const & y )
+    {
+        return m_value *= y, *this;
+    }
+
+    /// quan /= num
+
+    template <typename Y>
+    quantity & operator/=( Y const & y )
+    {
+        return m_value /= y, *this;
+    }
+
 private:
     /**
      * private initializing constructor.
@@ -346,7 +437,10 @@ private:
     constexpr explicit quantity( value_type x ) : m_value{ x } { }
 
 private:
-    value_type m_value;
+    // declared as T rather than value_type: naming the member's type through
+    // the typedef makes member access in the operator templates markedly
+    // slower to compile with GCC.
+    T m_value;
 
     enum { has_dimension = ! Dims::is_all_zero };
 
@@ -354,114 +448,8 @@ private:
     static_assert( has_dimension, "quantity dimensions must not all be zero" );
 #endif
 
-private:
-    // friends:
-
-    // arithmetic
-
-    template <typename D, typename X, typename Y>
-    friend constexpr quantity<D, X> &
-    operator+=( quantity<D, X> & x, quantity<D, Y> const & y );
-
-    template <typename D, typename X>
-    friend constexpr quantity<D, X>
-    operator+( quantity<D, X> const & x );
-
-    template< typename D, typename X, typename Y >
-    friend constexpr quantity <D, detail::PromoteAdd<X,Y>>
-    operator+( quantity<D, X> const & x, quantity<D, Y> const & y );
-
-    template <typename D, typename X, typename Y>
-    friend constexpr quantity<D, X> &
-    operator-=( quantity<D, X> & x, quantity<D, Y> const & y );
-
-    template <typename D, typename X>
-    friend constexpr quantity<D, X>
-    operator-( quantity<D, X> const & x );
-
-    template< typename D, typename X, typename Y >
-    friend constexpr quantity <D, detail::PromoteAdd<X,Y>>
-    operator-( quantity<D, X> const & x, quantity<D, Y> const & y );
-
-    template< typename D, typename X, typename Y>
-    friend constexpr quantity<D, X> &
-    operator*=( quantity<D, X> & x, const Y & y );
-
-    template <typename D, typename X, typename Y>
-    friend constexpr quantity<D, detail::PromoteMul<X,Y>>
-    operator*( quantity<D, X> const & x, const Y & y );
-
-    template <typename D, typename X, typename Y>
-    friend constexpr quantity< D, detail::PromoteMul<X,Y> >
-    operator*( const X & x, quantity<D, Y> const & y );
-
-    template <typename DX, typename DY, typename X, typename Y>
-    friend constexpr detail::Product<DX, DY, X, Y>
-    operator*( quantity<DX, X> const & lhs, quantity< DY, Y > const & rhs );
-
-    template< typename D, typename X, typename Y>
-    friend constexpr quantity<D, X> &
-    operator/=( quantity<D, X> & x, const Y & y );
-
-    template <typename D, typename X, typename Y>
-    friend constexpr quantity<D, detail::PromoteMul<X,Y>>
-    operator/( quantity<D, X> const & x, const Y & y );
-
-    template <typename D, typename X, typename Y>
-    friend constexpr detail::Reciprocal<D, X, Y>
-    operator/( const X & x, quantity<D, Y> const & y );
-
-    template <typename DX, typename DY, typename X, typename Y>
-    friend constexpr detail::Quotient<DX, DY, X, Y>
-    operator/( quantity<DX, X> const & x, quantity< DY, Y > const & y );
-
-    // absolute value.
-
-    template <typename D, typename X>
-    friend constexpr quantity<D,X>
-    abs( quantity<D,X> const & x );
-
-    // powers and roots
-
-    template <int N, typename D, typename X>
-    friend detail::Power<D, N, X>
-    nth_power( quantity<D, X> const & x );
-
-    template <typename D, typename X>
-    friend constexpr detail::Power<D, 2, X>
-    square( quantity<D, X> const & x );
-
-    template <typename D, typename X>
-    friend constexpr detail::Power<D, 3, X>
-    cube( quantity<D, X> const & x );
-
-    template <int N, typename D, typename X>
-    friend detail::Root<D, N, X>
-    nth_root( quantity<D, X> const & x );
-
-    template <typename D, typename X>
-    friend detail::Root< D, 2, X >
-    sqrt( quantity<D, X> const & x );
-
-    // comparison
-
-    template <typename D, typename X, typename Y>
-    friend constexpr bool operator==( quantity<D, X> const & x, quantity<D, Y> const & y );
-
-    template <typename D, typename X, typename Y>
-    friend constexpr bool operator!=( quantity<D, X> const & x, quantity<D, Y> const & y );
-
-    template <typename D, typename X, typename Y>
-    friend constexpr bool operator<( quantity<D, X> const & x, quantity<D, Y> const & y );
-
-    template <typename D, typename X, typename Y>
-    friend constexpr bool operator<=( quantity<D, X> const & x, quantity<D, Y> const & y );
-
-    template <typename D, typename X, typename Y>
-    friend constexpr bool operator>( quantity<D, X> const & x, quantity<D, Y> const & y );
-
-    template <typename D, typename X, typename Y>
-    friend constexpr bool operator>=( quantity<D, X> const & x, quantity<D, Y> const & y );
+    // The operators below use the public interface: friend declarations are
+    // re-declared for every instantiation of quantity and slow down compilation.
 };
 
 // Give names to the seven fundamental dimensions of physical reality.
@@ -476,22 +464,13 @@ typedef dimensions< 0, 0, 0, 0, 0, 0, 1 > luminous_intensity_d;
 
 // Addition operators
 
-/// quan += quan
-
-template <typename D, typename X, typename Y>
-constexpr quantity<D, X> &
-operator+=( quantity<D, X> & x, quantity<D, Y> const & y )
-{
-    return x.m_value += y.m_value, x;
-}
-
 /// + quan
 
 template <typename D, typename X>
 constexpr quantity<D, X>
 operator+( quantity<D, X> const & x )
 {
-   return quantity<D, X >( +x.m_value );
+   return quantity<D, X>( detail::magnitude_tag, +x.magnitude() );
 }
 
 /// quan + quan
@@ -500,27 +479,18 @@ template< typename D, typename X, typename Y >
 constexpr quantity <D, detail::PromoteAdd<X,Y>>
 operator+( quantity<D, X> const & x, quantity<D, Y> const & y )
 {
-   return quantity<D, detail::PromoteAdd<X,Y>>( x.m_value + y.m_value );
+   return quantity<D, detail::PromoteAdd<X,Y>>( detail::magnitude_tag, x.magnitude() + y.magnitude() );
 }
 
 // Subtraction operators
 
-/// quan -= quan
-
-template <typename D, typename X, typename Y>
-constexpr quantity<D, X> &
-operator-=( quantity<D, X> & x, quantity<D, Y> const & y )
-{
-    return x.m_value -= y.m_value, x;
-}
-
 /// - quan
 
 template <typename D, typename X>
 constexpr quantity<D, X>
 operator-( quantity<D, X> const & x )
 {
-   return quantity<D, X >( -x.m_value );
+   return quantity<D, X>( detail::magnitude_tag, -x.magnitude() );
 }
 
 /// quan - quan
@@ -529,36 +499,27 @@ template< typename D, typename X, typename Y >
 constexpr quantity <D, detail::PromoteAdd<X,Y>>
 operator-( quantity<D, X> const & x, quantity<D, Y> const & y )
 {
-   return quantity<D, detail::PromoteAdd<X,Y>>( x.m_value - y.m_value );
+   return quantity<D, detail::PromoteAdd<X,Y>>( detail::magnitude_tag, x.magnitude() - y.magnitude() );
 }
 
 // Multiplication operators
 
-/// quan *= num
-
-template< typename D, typename X, typename Y>
-constexpr quantity<D, X> &
-operator*=( quantity<D, X> & x, const Y & y )
-{
-   return x.m_value *= y, x;
-}
-
 /// quan * num
 
 template <typename D, typename X, typename Y>
-constexpr quantity<D, detail::PromoteMul<X,Y>>
+constexpr quantity<D, detail::PromoteMulScalar<X,Y>>
 operator*( quantity<D, X> const & x, const Y & y )
 {
-   return quantity<D, detail::PromoteMul<X,Y>>( x.m_value * y );
+   return quantity<D, detail::PromoteMulScalar<X,Y>>( detail::magnitude_tag, x.magnitude() * y );
 }
 
 /// num * quan
 
 template <typename D, typename X, typename Y>
-constexpr quantity< D, detail::PromoteMul<X,Y> >
+constexpr quantity< D, detail::PromoteMulScalar<X,Y> >
 operator*( const X & x, quantity<D, Y> const & y )
 {
-   return quantity<D, detail::PromoteMul<X,Y>>( x * y.m_value );
+   return quantity<D, detail::PromoteMulScalar<X,Y>>( detail::magnitude_tag, x * y.magnitude() );
 }
 
 /// quan * quan:
@@ -567,27 +528,18 @@ template <typename DX, typename DY, typename X, typename Y>
 constexpr detail::Product<DX, DY, X, Y>
 operator*( quantity<DX, X> const & lhs, quantity< DY, Y > const & rhs )
 {
-    return detail::Product<DX, DY, X, Y>( lhs.m_value * rhs.m_value );
+    return detail::collapse< detail::product_dimensions<DX, DY>, detail::PromoteMul<X,Y> >::make( lhs.magnitude() * rhs.magnitude() );
 }
 
 // Division operators
 
-/// quan /= num
-
-template< typename D, typename X, typename Y>
-constexpr quantity<D, X> &
-operator/=( quantity<D, X> & x, const Y & y )
-{
-   return x.m_value /= y, x;
-}
-
 /// quan / num
 
 template <typename D, typename X, typename Y>
-constexpr quantity<D, detail::PromoteMul<X,Y>>
+constexpr quantity<D, detail::PromoteMulScalar<X,Y>>
 operator/( quantity<D, X> const & x, const Y & y )
 {
-   return quantity<D, detail::PromoteMul<X,Y>>( x.m_value / y );
+   return quantity<D, detail::PromoteMulScalar<X,Y>>( detail::magnitude_tag, x.magnitude() / y );
 }
 
 /// num / quan
@@ -596,7 +548,7 @@ template <typename D, typename X, typename Y>
 constexpr detail::Reciprocal<D, X, Y>
 operator/( const X & x, quantity<D, Y> const & y )
 {
-   return detail::Reciprocal<D, X, Y>( x / y.m_value );
+   return detail::collapse< detail::reciprocal_dimensions<D>, detail::PromoteMulScalar<X,Y> >::make( x / y.magnitude() );
 }
 
 /// quan / quan:
@@ -605,7 +557,7 @@ template <typename DX, typename DY, typename X, typename Y>
 constexpr detail::Quotient<DX, DY, X, Y>
 operator/( quantity<DX, X> const & x, quantity< DY, Y > const & y )
 {
-    return detail::Quotient<DX, DY, X, Y>( x.m_value / y.m_value );
+    return detail::collapse< detail::quotient_dimensions<DX, DY>, detail::PromoteMul<X,Y> >::make( x.magnitude() / y.magnitude() );
 }
 
 /// absolute value.
@@ -613,7 +565,9 @@ operator/( quantity<DX, X> const & x, quantity< DY, Y > const & y )
 template <typename D, typename X>
 constexpr quantity<D,X> abs( quantity<D,X> const & x )
 {
-   return quantity<D,X>( std::abs( x.m_value ) );
+   using std::abs;
+
+   return quantity<D,X>( detail::magnitude_tag, abs( x.magnitude() ) );
 }
 
 // General powers
@@ -621,10 +575,10 @@ constexpr quantity<D,X> abs( quantity<D,X> const & x )
 /// N-th power.
 
 template <int N, typename D, typename X>
-detail::Power<D, N, X>
+constexpr detail::Power<D, N, X>
 nth_power( quantity<D, X> const & x )
 {
-   return detail::Power<D, N, X>( std::pow( x.m_value, X( N ) ) );
+   return detail::collapse< detail::power_dimensions<D, N>, X >::make( detail::magnitude_power<N>::of( x.magnitude() ) );
 }
 
 // Low powers defined separately for efficiency.
@@ -655,9 +609,9 @@ template <int N, typename D, typename X>
 detail::Root<D, N, X>
 nth_root( quantity<D, X> const & x )
 {
-   static_assert( detail::root<D, N, X>::all_even_multiples, "root result dimensions must be integral" );
+   static_assert( detail::all_even_multiples<D, N>(), "root result dimensions must be integral" );
 
-   return detail::Root<D, N, X>( std::pow( x.m_value, X( 1.0 ) / N ) );
+   return detail::collapse< detail::root_dimensions<D, N>, X >::make( detail::magnitude_root<N>::of( x.magnitude() ) );
 }
 
 // Low roots defined separately for convenience.
@@ -669,9 +623,9 @@ detail::Root< D, 2, X >
 sqrt( quantity<D, X> const & x )
 {
    static_assert(
-      detail::root<D, 2, X >::all_even_multiples, "root result dimensions must be integral" );
+      detail::all_even_multiples<D, 2>(), "root result dimensions must be integral" );
 
-   return detail::Root<D, 2, X>( std::pow( x.m_value, X( 1.0 ) / 2 ) );
+   return detail::collapse< detail::root_dimensions<D, 2>, X >::make( detail::magnitude_root<2>::of( x.magnitude() ) );
 }
 
 // Comparison operators
@@ -682,7 +636,7 @@ template <typename D, typename X, typename Y>
 constexpr bool
 operator==( quantity<D, X> const & x, quantity<D, Y> const & y )
 {
-   return x.m_value == y.m_value;
+   return x.magnitude() == y.magnitude();
 }
 
 /// inequality.
@@ -691,7 +645,7 @@ template <typename D, typename X, typename Y>
 constexpr bool
 operator!=( quantity<D, X> const & x, quantity<D, Y> const & y )
 {
-   return x.m_value != y.m_value;
+   return x.magnitude() != y.magnitude();
 }
 
 /// less-than.
@@ -700,7 +654,7 @@ template <typename D, typename X, typename Y>
 constexpr bool
 operator<( quantity<D, X> const & x, quantity<D, Y> const & y )
 {
-   return x.m_value < y.m_value;
+   return x.magnitude() < y.magnitude();
 }
 
 /// less-equal.
@@ -709,7 +663,7 @@ template <typename D, typename X, typename Y>
 constexpr bool
 operator<=( quantity<D, X> const & x, quantity<D, Y> const & y )
 {
-   return x.m_value <= y.m_value;
+   return x.magnitude() <= y.magnitude();
 }
 
 /// greater-than.
@@ -718,7 +672,7 @@ template <typename D, typename X, typename Y>
 constexpr bool
 operator>( quantity<D, X> const & x, quantity<D, Y> const & y )
 {
-   return x.m_value > y.m_value;
+   return x.magnitude() > y.magnitude();
 }
 
 /// greater-equal.
@@ -727,7 +681,7 @@ template <typename D, typename X, typename Y>
 constexpr bool
 operator>=( quantity<D, X> const & x, quantity<D, Y> const & y )
 {
-   return x.m_value >= y.m_value;
+   return x.magnitude() >= y.magnitude();
 }
 
 /// quantity's dimension.
@@ -917,17 +871,27 @@ constexpr quantity< mass_d                  > tonne        { ton_metric };
 
 // cooked literals for base units;
 // these could also have been created with a script.
-
-#define QUANTITY_DEFINE_SCALING_LITERAL( sfx, dim, factor ) \
-    constexpr quantity<dim, long double> operator "" _ ## sfx(unsigned long long x) \
+//
+// Literals in namespace literals have magnitude type PHYS_UNITS_LITERAL_TYPE,
+// literals in namespaces literals::f32 and literals::f64 have magnitude type
+// float and double, so that they do not promote float or double computations
+// to long double.
+
+#define QUANTITY_DEFINE_TYPED_SCALING_LITERAL( sfx, dim, factor, type ) \
+    constexpr quantity<dim, type> operator "" _ ## sfx(unsigned long long x) \
     { \
-        return quantity<dim, long double>( detail::magnitude_tag, factor * x ); \
+        return quantity<dim, type>( detail::magnitude_tag, static_cast<type>( factor * x ) ); \
     } \
-    constexpr quantity<dim, long double> operator "" _ ## sfx(long double x) \
+    constexpr quantity<dim, type> operator "" _ ## sfx(long double x) \
     { \
-        return quantity<dim, long double>( detail::magnitude_tag, factor * x ); \
+        return quantity<dim, type>( detail::magnitude_tag, static_cast<type>( factor * x ) ); \
     }
 
+#define QUANTITY_DEFINE_SCALING_LITERAL( sfx, dim, factor ) \
+    QUANTITY_DEFINE_TYPED_SCALING_LITERAL( sfx, dim, factor, PHYS_UNITS_LITERAL_TYPE ) \
+    namespace f32 { QUANTITY_DEFINE_TYPED_SCALING_LITERAL( sfx, dim, factor, float  ) } \
+    namespace f64 { QUANTITY_DEFINE_TYPED_SCALING_LITERAL( sfx, dim, factor, double ) }
+
 #define QUANTITY_DEFINE_SCALING_LITERALS( pfx, dim, fact ) \
     QUANTITY_DEFINE_SCALING_LITERAL( Y ## pfx, dim, fact * yotta ) \
     QUANTITY_DEFINE_SCALING_LITERAL( Z ## pfx, dim, fact * zetta ) \
@@ -959,6 +923,14 @@ constexpr quantity< mass_d                  > tonne        { ton_metric };
 
 namespace literals {
 
+/// literals with magnitude type float.
+
+namespace f32 {}
+
+/// literals with magnitude type double.
+
+namespace f64 {}
+
 QUANTITY_DEFINE_SCALING_LITERALS( g, mass_d, 1e-3 )
 
 QUANTITY_DEFINE_LITERALS( m  , length_d )
@@ -0,0 +1,154 @@
+/**
+ * \file quantity_accumulator.hpp
+ *
+ * \brief   Compensated (Neumaier) summation of quantities.
+ * \author  Martin Moene
+ * \date    16 October 2026
+ * \since   1.2
+ *
+ * This code is provided as-is, with no warrantee of correctness.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+/*
+ * A quantity_accumulator<Dims, T> sums quantities of type quantity<Dims, T>
+ * and keeps a second term with the rounding error of each addition, as
+ * proposed by Neumaier (an improvement of Kahan summation that also handles
+ * addends larger than the running sum). The error of the result does not
+ * grow with the number of additions, so that long running sums in T are as
+ * accurate as plain sums in a wider type, at a fraction of the cost of
+ * long double arithmetic.
+ *
+ * Accumulators of different threads can be merged with +=.
+ *
+ * Compensated summation relies on the exact order of floating-point
+ * operations: do not compile it with -ffast-math or -fassociative-math.
+ */
+
+#ifndef PHYS_UNITS_QUANTITY_ACCUMULATOR_HPP_INCLUDED
+#define PHYS_UNITS_QUANTITY_ACCUMULATOR_HPP_INCLUDED
+
+#include "phys/units/quantity.hpp"
+
+#include <cmath>
+
+/// namespace phys.
+
+namespace phys {
+
+/// namespace units.
+
+namespace units {
+
+/// namespace detail.
+
+namespace detail {
+
+/**
+ * Neumaier summation of magnitudes of type T.
+ */
+template< typename T >
+struct compensated_sum
+{
+    T sum;
+    T compensation;
+
+    /// add x to the sum, keeping the rounding error in compensation.
+
+    void add( T const x )
+    {
+        T const t = sum + x;
+
+        compensation += std::abs( sum ) >= std::abs( x ) ? ( sum - t ) + x : ( x - t ) + sum;
+        sum = t;
+    }
+
+    /// add the sum of another compensated_sum.
+
+    void merge( compensated_sum const & other )
+    {
+        add( other.sum );
+        compensation += other.compensation;
+    }
+
+    /// the compensated sum.
+
+    T value() const { return sum + compensation; }
+};
+
+} // namespace detail
+
+/**
+ * \brief class "quantity_accumulator" sums quantities with dimensions Dims
+ * with compensation of the rounding error.
+ */
+template< typename Dims, typename T = Rep >
+class quantity_accumulator
+{
+public:
+    typedef Dims dimension_type;
+
+    typedef T value_type;
+
+    typedef quantity<Dims, T> quantity_type;
+
+    quantity_accumulator() : m_sum() { }
+
+    /**
+     * start with the given quantity.
+     */
+    template <typename X>
+    explicit quantity_accumulator( quantity<Dims, X> const & x )
+    : m_sum() { m_sum.sum = x.magnitude(); }
+
+    /// acc += quan
+
+    template <typename X>
+    quantity_accumulator & operator+=( quantity<Dims, X> const & x )
+    {
+        return m_sum.add( x.magnitude() ), *this;
+    }
+
+    /// acc -= quan
+
+    template <typename X>
+    quantity_accumulator & operator-=( quantity<Dims, X> const & x )
+    {
+        return m_sum.add( -x.magnitude() ), *this;
+    }
+
+    /// acc += acc, e.g. to merge the accumulators of several threads.
+
+    quantity_accumulator & operator+=( quantity_accumulator const & other )
+    {
+        return m_sum.merge( other.m_sum ), *this;
+    }
+
+    /**
+     * the compensated sum.
+     */
+    quantity_type value() const { return quantity_type( detail::magnitude_tag, m_sum.value() ); }
+
+    /**
+     * the compensated sum.
+     */
+    operator quantity_type() const { return value(); }
+
+    /**
+     * the accumulated rounding error that value() adds to the plain sum.
+     */
+    quantity_type compensation() const { return quantity_type( detail::magnitude_tag, m_sum.compensation ); }
+
+private:
+    detail::compensated_sum<T> m_sum;
+};
+
+}} // namespace phys::units
+
+#endif // PHYS_UNITS_QUANTITY_ACCUMULATOR_HPP_INCLUDED
+
+/*
+ * end of file
+ */
@@ -0,0 +1,519 @@
+/**
+ * \file quantity_algorithm.hpp
+ *
+ * \brief   Parallel reductions over ranges of quantities: sum, mean, minmax_value and dot.
+ * \author  Martin Moene
+ * \date    16 October 2026
+ * \since   1.2
+ *
+ * This code is provided as-is, with no warrantee of correctness.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+/*
+ * The reductions take a random-access range of quantities (or of plain
+ * numbers) and an optional executor. They work on the magnitudes and give
+ * the result the dimensions it must have: the sum of quantity<power_d> is a
+ * quantity<power_d>, the dot product of quantity<force_d> and
+ * quantity<length_d> ranges is a quantity<energy_d>.
+ *
+ * Sums use compensated (Neumaier) summation as quantity_accumulator does:
+ * each task sums in eight independent lanes to break the dependency chain
+ * of the additions, and the lanes and tasks are merged with their
+ * compensation terms. The rounding error does not grow with the length of
+ * the range.
+ *
+ * An executor splits large ranges into one task per core. It provides
+ *
+ *   std::size_t concurrency() const;               // number of tasks to use
+ *   template< typename F >
+ *   void bulk( std::size_t n, F f ) const;         // f(0) .. f(n-1), returns when all are done
+ *
+ * sequential_executor runs everything in the calling thread, thread_executor
+ * uses a pool of std::threads that it starts once. The result may differ in the last bits with the number
+ * of tasks, as the partial sums are combined in a different order.
+ */
+
+#ifndef PHYS_UNITS_QUANTITY_ALGORITHM_HPP_INCLUDED
+#define PHYS_UNITS_QUANTITY_ALGORITHM_HPP_INCLUDED
+
+#include "phys/units/quantity.hpp"
+#include "phys/units/quantity_accumulator.hpp"
+#include "phys/units/quantity_vector.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// namespace phys.
+
+namespace phys {
+
+/// namespace units.
+
+namespace units {
+
+/**
+ * executor that runs all tasks in the calling thread.
+ */
+struct sequential_executor
+{
+    std::size_t concurrency() const { return 1; }
+
+    template< typename F >
+    void bulk( std::size_t const n, F f ) const
+    {
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            f( i );
+        }
+    }
+};
+
+/// namespace detail.
+
+namespace detail {
+
+/**
+ * worker threads for thread_executor that wait for tasks between calls of run()
+ * and are joined on destruction.
+ */
+class thread_pool
+{
+public:
+    explicit thread_pool( std::size_t const workers )
+    : m_run(), m_mutex(), m_work(), m_done(), m_task( nullptr ), m_next( 0 ), m_count( 0 ), m_pending( 0 )
+    , m_error(), m_stop( false ), m_threads()
+    {
+        try
+        {
+            m_threads.reserve( workers );
+
+            for ( std::size_t i = 0; i < workers; ++i )
+            {
+                m_threads.emplace_back( &thread_pool::work, this );
+            }
+        }
+        catch ( ... )
+        {
+            stop();
+            throw;
+        }
+    }
+
+    ~thread_pool()
+    {
+        stop();
+    }
+
+    /**
+     * run task(0) .. task(n - 1), task(0) in the calling thread, and return when
+     * all are done; rethrows the first exception that a task threw.
+     */
+    void run( std::size_t const n, std::function< void( std::size_t ) > const & task )
+    {
+        std::lock_guard<std::mutex> const run_lock( m_run );
+        std::unique_lock<std::mutex> lock( m_mutex );
+
+        m_task    = &task;
+        m_next    = 0;
+        m_count   = n;
+        m_pending = n;
+        m_error   = nullptr;
+
+        m_work.notify_all();
+
+        while ( m_next < m_count )
+        {
+            execute( m_next++, lock );
+        }
+
+        m_done.wait( lock, [this] { return m_pending == 0; } );
+
+        m_task  = nullptr;
+        m_count = 0;
+
+        std::exception_ptr const error = m_error;
+        m_error = nullptr;
+        lock.unlock();
+
+        if ( error )
+        {
+            std::rethrow_exception( error );
+        }
+    }
+
+    thread_pool( thread_pool const & ) = delete;
+
+    thread_pool & operator=( thread_pool const & ) = delete;
+
+private:
+    void work()
+    {
+        std::unique_lock<std::mutex> lock( m_mutex );
+
+        for ( ;; )
+        {
+            m_work.wait( lock, [this] { return m_stop || m_next < m_count; } );
+
+            if ( m_stop )
+            {
+                return;
+            }
+
+            execute( m_next++, lock );
+        }
+    }
+
+    // run task i without holding the lock; keep the first exception.
+
+    void execute( std::size_t const i, std::unique_lock<std::mutex> & lock )
+    {
+        std::function< void( std::size_t ) > const & task = *m_task;
+        lock.unlock();
+
+        std::exception_ptr error;
+
+        try
+        {
+            task( i );
+        }
+        catch ( ... )
+        {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+
+        if ( error && !m_error )
+        {
+            m_error = error;
+        }
+
+        if ( --m_pending == 0 )
+        {
+            m_done.notify_all();
+        }
+    }
+
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> const lock( m_mutex );
+            m_stop = true;
+        }
+
+        m_work.notify_all();
+
+        for ( std::thread & t : m_threads )
+        {
+            if ( t.joinable() )
+            {
+                t.join();
+            }
+        }
+    }
+
+private:
+    std::mutex m_run;
+    std::mutex m_mutex;
+    std::condition_variable m_work;
+    std::condition_variable m_done;
+    std::function< void( std::size_t ) > const * m_task;
+    std::size_t m_next;
+    std::size_t m_count;
+    std::size_t m_pending;
+    std::exception_ptr m_error;
+    bool m_stop;
+    std::vector<std::thread> m_threads;
+};
+
+} // namespace detail
+
+/**
+ * executor that runs tasks on a pool of concurrency() - 1 threads that it starts once,
+ * and in the calling thread. Copies share the pool. bulk() rethrows the first
+ * exception of a task after all tasks are done; tasks must not call bulk() of
+ * the same executor.
+ */
+class thread_executor
+{
+public:
+    explicit thread_executor( std::size_t const threads = std::thread::hardware_concurrency() )
+    : m_threads( std::max( std::size_t( 1 ), threads ) )
+    , m_pool( std::make_shared<detail::thread_pool>( m_threads - 1 ) ) { }
+
+    std::size_t concurrency() const { return m_threads; }
+
+    template< typename F >
+    void bulk( std::size_t const n, F f ) const
+    {
+        if ( n == 1 || m_threads == 1 )
+        {
+            for ( std::size_t i = 0; i < n; ++i )
+            {
+                f( i );
+            }
+            return;
+        }
+
+        m_pool->run( n, std::function< void( std::size_t ) >( std::ref( f ) ) );
+    }
+
+private:
+    std::size_t m_threads;
+    std::shared_ptr<detail::thread_pool> m_pool;
+};
+
+/// namespace detail.
+
+namespace detail {
+
+/// smallest number of elements for which a task of its own pays off.
+
+const std::size_t parallel_grain = 32768;
+
+/**
+ * the magnitude of the i-th element of a range.
+ */
+template< typename It >
+struct magnitude_at
+{
+    It first;
+
+    auto operator()( std::size_t const i ) const -> decltype( magnitude_of( first[i] ) )
+    {
+        return magnitude_of( first[i] );
+    }
+};
+
+/**
+ * the product of the magnitudes of the i-th elements of two ranges.
+ */
+template< typename It1, typename It2 >
+struct product_at
+{
+    It1 first1;
+    It2 first2;
+
+    auto operator()( std::size_t const i ) const -> decltype( magnitude_of( first1[i] ) * magnitude_of( first2[i] ) )
+    {
+        return magnitude_of( first1[i] ) * magnitude_of( first2[i] );
+    }
+};
+
+/**
+ * compensated sum of get(first) .. get(first + n - 1), in eight lanes.
+ */
+template< typename T, typename Get >
+compensated_sum<T> lane_sum( Get const & get, std::size_t const first, std::size_t const n )
+{
+    compensated_sum<T> lane[8] = {};
+
+    std::size_t i = 0;
+
+    for ( ; i + 8 <= n; i += 8 )
+    {
+        for ( std::size_t k = 0; k < 8; ++k )
+        {
+            lane[k].add( get( first + i + k ) );
+        }
+    }
+
+    for ( ; i < n; ++i )
+    {
+        lane[0].add( get( first + i ) );
+    }
+
+    for ( std::size_t k = 1; k < 8; ++k )
+    {
+        lane[0].merge( lane[k] );
+    }
+    return lane[0];
+}
+
+/**
+ * smallest and largest of get(first) .. get(first + n - 1), n > 0.
+ */
+template< typename T, typename Get >
+std::pair<T, T> minmax_of( Get const & get, std::size_t const first, std::size_t const n )
+{
+    T lo = get( first );
+    T hi = lo;
+
+    for ( std::size_t i = first + 1; i < first + n; ++i )
+    {
+        T const x = get( i );
+
+        lo = x < lo ? x : lo;
+        hi = hi < x ? x : hi;
+    }
+    return std::make_pair( lo, hi );
+}
+
+/**
+ * reduce [0, n) with reduce( first, count ) per task and combine the task results.
+ */
+template< typename T, typename Executor, typename Reduce, typename Combine >
+T parallel_reduce( Executor const & exec, std::size_t const n, Reduce reduce, Combine combine )
+{
+    std::size_t const tasks = std::max( std::size_t( 1 ), std::min( exec.concurrency(), n / parallel_grain ) );
+
+    if ( tasks == 1 )
+    {
+        return reduce( 0, n );
+    }
+
+    std::vector<T> partial( tasks );
+
+    exec.bulk( tasks, [&]( std::size_t const t )
+    {
+        std::size_t const first = n * t / tasks;
+        std::size_t const last  = n * ( t + 1 ) / tasks;
+
+        partial[t] = reduce( first, last - first );
+    } );
+
+    T result = partial[0];
+
+    for ( std::size_t t = 1; t < tasks; ++t )
+    {
+        result = combine( result, partial[t] );
+    }
+    return result;
+}
+
+/**
+ * compensated sum of get(0) .. get(n - 1), in tasks of exec.
+ */
+template< typename T, typename Get, typename Executor >
+T compensated_reduce( Executor const & exec, Get const & get, std::size_t const n )
+{
+    return parallel_reduce< compensated_sum<T> >( exec, n,
+        [&get]( std::size_t const i, std::size_t const count ) { return lane_sum<T>( get, i, count ); },
+        []( compensated_sum<T> x, compensated_sum<T> const & y ) { return x.merge( y ), x; } ).value();
+}
+
+/**
+ * value of type Q from a magnitude: a quantity or a plain number.
+ */
+template< typename Q >
+struct from_magnitude
+{
+    typedef Q type;
+
+    static constexpr type make( Q x ) { return x; }
+};
+
+template< typename D, typename T >
+struct from_magnitude< quantity<D, T> > : collapse<D, T> {};
+
+/**
+ * type of the product of elements of type X and Y and how to make it from a magnitude.
+ */
+template< typename X, typename Y >
+struct product_of : from_magnitude< PromoteMul<X, Y> > {};
+
+template< typename DX, typename X, typename DY, typename Y >
+struct product_of< quantity<DX, X>, quantity<DY, Y> > : collapse< product_dimensions<DX, DY>, PromoteMul<X, Y> > {};
+
+template< typename DX, typename X, typename Y >
+struct product_of< quantity<DX, X>, Y > : collapse< DX, PromoteMul<X, Y> > {};
+
+template< typename X, typename DY, typename Y >
+struct product_of< X, quantity<DY, Y> > : collapse< DY, PromoteMul<X, Y> > {};
+
+template< typename It >
+using ValueOf = typename std::iterator_traits<It>::value_type;
+
+template< typename It >
+using MagnitudeOf = decltype( magnitude_of( std::declval< ValueOf<It> >() ) );
+
+} // namespace detail
+
+/**
+ * sum of the quantities in [first, last), by compensated summation.
+ */
+template< typename RandomIt, typename Executor = sequential_executor >
+detail::ValueOf<RandomIt>
+sum( RandomIt first, RandomIt last, Executor const & exec = Executor() )
+{
+    typedef detail::MagnitudeOf<RandomIt> T;
+
+    detail::magnitude_at<RandomIt> const get = { first };
+
+    return detail::from_magnitude< detail::ValueOf<RandomIt> >::make(
+        detail::compensated_reduce<T>( exec, get, static_cast<std::size_t>( last - first ) ) );
+}
+
+/**
+ * arithmetic mean of the quantities in [first, last); NaN for an empty range of floating-point quantities.
+ */
+template< typename RandomIt, typename Executor = sequential_executor >
+detail::ValueOf<RandomIt>
+mean( RandomIt first, RandomIt last, Executor const & exec = Executor() )
+{
+    typedef detail::MagnitudeOf<RandomIt> T;
+
+    return detail::from_magnitude< detail::ValueOf<RandomIt> >::make(
+        detail::magnitude_of( sum( first, last, exec ) ) / static_cast<T>( last - first ) );
+}
+
+/**
+ * smallest and largest quantity in [first, last); the range must not be empty.
+ */
+template< typename RandomIt, typename Executor = sequential_executor >
+std::pair< detail::ValueOf<RandomIt>, detail::ValueOf<RandomIt> >
+minmax_value( RandomIt first, RandomIt last, Executor const & exec = Executor() )
+{
+    typedef detail::MagnitudeOf<RandomIt> T;
+    typedef detail::from_magnitude< detail::ValueOf<RandomIt> > result;
+
+    assert( first != last && "minmax_value() requires a non-empty range" );
+
+    detail::magnitude_at<RandomIt> const get = { first };
+
+    std::pair<T, T> const r = detail::parallel_reduce< std::pair<T, T> >( exec, static_cast<std::size_t>( last - first ),
+        [&get]( std::size_t const i, std::size_t const n ) { return detail::minmax_of<T>( get, i, n ); },
+        []( std::pair<T, T> const & x, std::pair<T, T> const & y )
+        {
+            return std::make_pair( y.first < x.first ? y.first : x.first, x.second < y.second ? y.second : x.second );
+        } );
+
+    return std::make_pair( result::make( r.first ), result::make( r.second ) );
+}
+
+/**
+ * dot product of [first1, last1) and the range starting at first2, by compensated summation;
+ * the result has the dimensions of the product of the elements, e.g. force . length is energy.
+ */
+template< typename RandomIt1, typename RandomIt2, typename Executor = sequential_executor >
+typename detail::product_of< detail::ValueOf<RandomIt1>, detail::ValueOf<RandomIt2> >::type
+dot( RandomIt1 first1, RandomIt1 last1, RandomIt2 first2, Executor const & exec = Executor() )
+{
+    typedef detail::product_of< detail::ValueOf<RandomIt1>, detail::ValueOf<RandomIt2> > result;
+    typedef detail::PromoteMul< detail::MagnitudeOf<RandomIt1>, detail::MagnitudeOf<RandomIt2> > T;
+
+    detail::product_at<RandomIt1, RandomIt2> const get = { first1, first2 };
+
+    return result::make( detail::compensated_reduce<T>( exec, get, static_cast<std::size_t>( last1 - first1 ) ) );
+}
+
+}} // namespace phys::units
+
+#endif // PHYS_UNITS_QUANTITY_ALGORITHM_HPP_INCLUDED
+
+/*
+ * end of file
+ */
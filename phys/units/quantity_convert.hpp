@@ -0,0 +1,180 @@
+/**
+ * \file quantity_convert.hpp
+ *
+ * \brief   Batch conversion of arrays of numbers from one unit to another, and a table of conversion factors.
+ * \author  Martin Moene
+ * \date    16 October 2026
+ * \since   1.2
+ *
+ * This code is provided as-is, with no warrantee of correctness.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+/*
+ * Data from legacy sources often comes as plain numbers in a unit from
+ * other_units.hpp, such as psi or gallon_us. Converting them one by one,
+ * as ( x * psi ).to( bar ), multiplies and divides per element.
+ * convert( in, psi, bar, out ) computes the factor psi / bar once, checks
+ * at compile time that both units have the same dimensions, and multiplies
+ * the numbers by it in a loop that the compiler vectorizes:
+ *
+ *   std::vector<double> pressures_psi = ...;
+ *   std::vector<double> pressures_bar( pressures_psi.size() );
+ *
+ *   convert( pressures_psi, psi, bar, pressures_bar );
+ *
+ * When the unit of a feed is only known at run time, a conversion_table
+ * holds the factors between all pairs of a list of units of the same
+ * dimensions, computed once, and converts by the indices of the units.
+ */
+
+#ifndef PHYS_UNITS_QUANTITY_CONVERT_HPP_INCLUDED
+#define PHYS_UNITS_QUANTITY_CONVERT_HPP_INCLUDED
+
+#include "phys/units/quantity.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+
+/// namespace phys.
+
+namespace phys {
+
+/// namespace units.
+
+namespace units {
+
+/// namespace detail.
+
+namespace detail {
+
+/**
+ * store in[i] * factor at out[i] for n numbers; in and out may be the same.
+ */
+template< typename T >
+T * scale_n( T const * in, std::size_t const n, T const factor, T * out )
+{
+    static_assert( std::is_arithmetic<T>::value, "convert() converts arrays of numbers" );
+
+    for ( std::size_t i = 0; i < n; ++i )
+        out[i] = in[i] * factor;
+
+    return out + n;
+}
+
+} // namespace detail
+
+/**
+ * the factor that converts a number in unit from to unit to, e.g. 0.0689 for psi to bar;
+ * the units must have the same dimensions.
+ */
+template< typename D, typename X, typename Y >
+constexpr detail::PromoteMul<X, Y> conversion_factor( quantity<D, X> const & from, quantity<D, Y> const & to )
+{
+    return from.magnitude() / to.magnitude();
+}
+
+/**
+ * convert the numbers in [first, last) from unit from to unit to and store them
+ * from out on; returns the end of the output. out may be first.
+ */
+template< typename T, typename D, typename X, typename Y >
+T * convert( T const * first, T const * last, quantity<D, X> const & from, quantity<D, Y> const & to, T * out )
+{
+    return detail::scale_n( first, static_cast<std::size_t>( last - first ), static_cast<T>( conversion_factor( from, to ) ), out );
+}
+
+/**
+ * convert the numbers of contiguous range in, such as a std::vector<double>, from
+ * unit from to unit to and store them in range out, which must be at least as long.
+ */
+template< typename In, typename Out, typename D, typename X, typename Y >
+void convert( In const & in, quantity<D, X> const & from, quantity<D, Y> const & to, Out && out )
+{
+    assert( out.size() >= in.size() && "convert: output range too short" );
+
+    convert( in.data(), in.data() + in.size(), from, to, out.data() );
+}
+
+/**
+ * \brief class "conversion_table" holds the factors between all pairs of a list
+ * of units with dimensions Dims, to convert between units chosen at run time.
+ */
+template< typename Dims, typename T = Rep >
+class conversion_table
+{
+public:
+    typedef std::size_t size_type;
+
+    /**
+     * the table of the given units, e.g. conversion_table<pressure_d>{ pascal, bar, psi };
+     * units are referred to by their position in the list.
+     */
+    conversion_table( std::initializer_list< quantity<Dims> > units )
+    : m_size( units.size() ), m_factors( units.size() * units.size() )
+    {
+        size_type i = 0;
+
+        for ( quantity<Dims> const & from : units )
+        {
+            size_type j = 0;
+
+            for ( quantity<Dims> const & to : units )
+                m_factors[i * m_size + j++] = static_cast<T>( conversion_factor( from, to ) );
+            ++i;
+        }
+    }
+
+    /**
+     * number of units.
+     */
+    size_type size() const { return m_size; }
+
+    /**
+     * the factor from unit from to unit to.
+     */
+    T factor( size_type const from, size_type const to ) const
+    {
+        assert( from < m_size && to < m_size && "conversion_table: unit out of range" );
+
+        return m_factors[from * m_size + to];
+    }
+
+    /**
+     * convert the numbers in [first, last) from unit from to unit to and store them
+     * from out on; returns the end of the output.
+     */
+    T * convert( T const * first, T const * last, size_type const from, size_type const to, T * out ) const
+    {
+        return detail::scale_n( first, static_cast<std::size_t>( last - first ), factor( from, to ), out );
+    }
+
+    /**
+     * convert the numbers of contiguous range in from unit from to unit to and store
+     * them in range out, which must be at least as long.
+     */
+    template< typename In, typename Out >
+    void convert( In const & in, size_type const from, size_type const to, Out && out ) const
+    {
+        assert( out.size() >= in.size() && "conversion_table: output range too short" );
+
+        convert( in.data(), in.data() + in.size(), from, to, out.data() );
+    }
+
+private:
+    size_type m_size;
+    std::vector<T> m_factors;
+};
+
+}} // namespace phys::units
+
+#endif // PHYS_UNITS_QUANTITY_CONVERT_HPP_INCLUDED
+
+/*
+ * end of file
+ */
@@ -0,0 +1,405 @@
+/**
+ * \file quantity_expression.hpp
+ *
+ * \brief   Expression templates for lazy, fused evaluation of quantity array expressions.
+ * \author  Martin Moene
+ * \date    16 October 2026
+ * \since   1.2
+ *
+ * This code is provided as-is, with no warrantee of correctness.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+/*
+ * Arithmetic on quantity_vector does not compute anything; it builds a
+ * vector_expr that remembers the operation and its operands. Evaluation
+ * happens element by element when the expression is assigned to a
+ * quantity_vector, so that for example
+ *
+ *     quantity_vector<energy_d> E = 0.5 * m * square( v );
+ *
+ * runs as a single loop without intermediate containers. The element type of
+ * an expression is that of the same computation on single quantities, hence
+ * the dimensions follow detail::Product, detail::Quotient etc. and mixing
+ * incompatible dimensions is a compile-time error. Operands of different
+ * sizes make the evaluation throw std::length_error before it writes anything.
+ *
+ * Note: an expression refers to its quantity_vector operands; do not keep an
+ * expression (e.g. via auto) beyond the lifetime of the containers it uses.
+ */
+
+#ifndef PHYS_UNITS_QUANTITY_EXPRESSION_HPP_INCLUDED
+#define PHYS_UNITS_QUANTITY_EXPRESSION_HPP_INCLUDED
+
+#include "phys/units/quantity.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/// namespace phys.
+
+namespace phys {
+
+/// namespace units.
+
+namespace units {
+
+/*
+ * declare now, define later.
+ */
+template< typename Dims, typename T = Rep >
+class quantity_vector;
+
+/// namespace detail.
+
+namespace detail {
+
+/**
+ * scalar operand, indexable like an array.
+ */
+template< typename T >
+struct broadcast
+{
+    T value;
+
+    constexpr T const & operator[]( std::size_t ) const { return value; }
+};
+
+/**
+ * operand of a unary expression.
+ */
+struct no_operand { };
+
+/**
+ * size of an operand; scalars fit any size.
+ */
+constexpr std::size_t any_size = std::size_t( -1 );
+
+template< typename T >
+constexpr std::size_t size_of( broadcast<T> const & ) { return any_size; }
+
+template< typename D, typename T >
+inline std::size_t size_of( quantity_vector<D, T> const & x ) { return x.size(); }
+
+template< typename E >
+inline std::size_t size_of( E const & x ) { return x.size(); }
+
+/**
+ * size of an expression of operands of sizes x and y; throws std::length_error if they differ.
+ */
+inline std::size_t common_size( std::size_t const x, std::size_t const y )
+{
+    if ( x != any_size && y != any_size && x != y )
+        throw std::length_error( "vector_expr: operands differ in size" );
+
+    return x != any_size ? x : y;
+}
+
+// element-wise operations.
+
+struct plus       { template< typename X, typename Y > auto operator()( X const & x, Y const & y ) const -> decltype( x + y ) { return x + y; } };
+struct minus      { template< typename X, typename Y > auto operator()( X const & x, Y const & y ) const -> decltype( x - y ) { return x - y; } };
+struct multiplies { template< typename X, typename Y > auto operator()( X const & x, Y const & y ) const -> decltype( x * y ) { return x * y; } };
+struct divides    { template< typename X, typename Y > auto operator()( X const & x, Y const & y ) const -> decltype( x / y ) { return x / y; } };
+
+struct negate     { template< typename X > auto operator()( X const & x ) const -> decltype( -x ) { return -x; } };
+struct squares    { template< typename X > auto operator()( X const & x ) const -> decltype( x * x ) { return x * x; } };
+struct cubes      { template< typename X > auto operator()( X const & x ) const -> decltype( x * x * x ) { return x * x * x; } };
+
+struct absolute
+{
+    template< typename X >
+    auto operator()( X const & x ) const -> decltype( abs( x ) ) { return abs( x ); }
+
+    double      operator()( double      x ) const { return std::abs( x ); }
+    float       operator()( float       x ) const { return std::abs( x ); }
+    long double operator()( long double x ) const { return std::abs( x ); }
+};
+
+struct square_root
+{
+    template< typename X >
+    auto operator()( X const & x ) const -> decltype( sqrt( x ) ) { return sqrt( x ); }
+
+    double      operator()( double      x ) const { return std::sqrt( x ); }
+    float       operator()( float       x ) const { return std::sqrt( x ); }
+    long double operator()( long double x ) const { return std::sqrt( x ); }
+};
+
+} // namespace detail
+
+/**
+ * \brief class "vector_expr" represents the element-wise application of Op
+ * to operands L and R, or to L alone if R is detail::no_operand.
+ * Element i is computed on access, see operator[].
+ */
+template< typename Op, typename L, typename R >
+class vector_expr
+{
+public:
+    typedef decltype( Op()( std::declval<L const &>()[0], std::declval<R const &>()[0] ) ) value_type;
+
+    typedef std::size_t size_type;
+
+    vector_expr( L const & lhs, R const & rhs ) : m_lhs( lhs ), m_rhs( rhs ) { }
+
+    size_type size() const { return detail::common_size( detail::size_of( m_lhs ), detail::size_of( m_rhs ) ); }
+
+    value_type operator[]( size_type i ) const { return Op()( m_lhs[i], m_rhs[i] ); }
+
+private:
+    L m_lhs;
+    R m_rhs;
+};
+
+template< typename Op, typename L >
+class vector_expr< Op, L, detail::no_operand >
+{
+public:
+    typedef decltype( Op()( std::declval<L const &>()[0] ) ) value_type;
+
+    typedef std::size_t size_type;
+
+    explicit vector_expr( L const & arg ) : m_arg( arg ) { }
+
+    size_type size() const { return detail::size_of( m_arg ); }
+
+    value_type operator[]( size_type i ) const { return Op()( m_arg[i] ); }
+
+private:
+    L m_arg;
+};
+
+/// namespace detail.
+
+namespace detail {
+
+/**
+ * true for containers and expressions that take part in element-wise evaluation.
+ */
+template< typename E >
+struct is_vector_operand : std::false_type { };
+
+template< typename D, typename T >
+struct is_vector_operand< quantity_vector<D, T> > : std::true_type { };
+
+template< typename Op, typename L, typename R >
+struct is_vector_operand< vector_expr<Op, L, R> > : std::true_type { };
+
+/**
+ * how an operand is held in an expression: containers by reference,
+ * expressions by value and scalars as a broadcast value.
+ */
+template< typename E >
+struct operand
+{
+    typedef broadcast<E> type;
+
+    static type make( E const & x ) { return type{ x }; }
+};
+
+template< typename D, typename T >
+struct operand< quantity_vector<D, T> >
+{
+    typedef quantity_vector<D, T> const & type;
+
+    static type make( quantity_vector<D, T> const & x ) { return x; }
+};
+
+template< typename Op, typename L, typename R >
+struct operand< vector_expr<Op, L, R> >
+{
+    typedef vector_expr<Op, L, R> type;
+
+    static type make( type const & x ) { return x; }
+};
+
+template< typename E >
+using Operand = typename operand<E>::type;
+
+/**
+ * element type of an operand.
+ */
+template< typename E >
+struct element
+{
+    typedef E type;
+};
+
+template< typename D, typename T >
+struct element< quantity_vector<D, T> >
+{
+    typedef quantity<D, T> type;
+};
+
+template< typename Op, typename L, typename R >
+struct element< vector_expr<Op, L, R> >
+{
+    typedef typename vector_expr<Op, L, R>::value_type type;
+};
+
+template< typename E >
+using Element = typename element<E>::type;
+
+/**
+ * binary expression type generator; no type if neither operand is a
+ * vector operand, or if Op cannot be applied to the elements, e.g. on
+ * addition of quantities of different dimensions.
+ */
+template< typename Op, typename L, typename R,
+    bool = is_vector_operand<L>::value || is_vector_operand<R>::value, typename = void >
+struct binary_expr { };
+
+template< typename Op, typename L, typename R >
+struct binary_expr< Op, L, R, true,
+    typename always_void< decltype( Op()( std::declval< Element<L> >(), std::declval< Element<R> >() ) ) >::type >
+{
+    typedef vector_expr< Op, Operand<L>, Operand<R> > type;
+};
+
+template< typename Op, typename L, typename R >
+using BinaryExpr = typename binary_expr<Op, L, R>::type;
+
+template< typename Op, typename L, typename R >
+inline BinaryExpr<Op, L, R> make_expr( L const & lhs, R const & rhs )
+{
+    return BinaryExpr<Op, L, R>( operand<L>::make( lhs ), operand<R>::make( rhs ) );
+}
+
+/**
+ * unary expression type generator.
+ */
+template< typename Op, typename E, bool = is_vector_operand<E>::value, typename = void >
+struct unary_expr { };
+
+template< typename Op, typename E >
+struct unary_expr< Op, E, true,
+    typename always_void< decltype( Op()( std::declval< Element<E> >() ) ) >::type >
+{
+    typedef vector_expr< Op, Operand<E>, no_operand > type;
+};
+
+template< typename Op, typename E >
+using UnaryExpr = typename unary_expr<Op, E>::type;
+
+template< typename Op, typename E >
+inline UnaryExpr<Op, E> make_expr( E const & arg )
+{
+    return UnaryExpr<Op, E>( operand<E>::make( arg ) );
+}
+
+} // namespace detail
+
+/*
+ * Binary operators. The generic form covers vector operands combined with
+ * each other and with numbers. Combinations with a single quantity need
+ * their own overloads, as they must be more specialized than the
+ * quan-num and num-quan operators of quantity.
+ */
+
+#define PHYS_UNITS_VECTOR_BINARY_OPERATOR( op, Op ) \
+    template< typename L, typename R > \
+    detail::BinaryExpr<detail::Op, L, R> \
+    operator op( L const & lhs, R const & rhs ) \
+    { \
+        return detail::make_expr<detail::Op>( lhs, rhs ); \
+    } \
+    template< typename DX, typename X, typename DY, typename Y > \
+    detail::BinaryExpr<detail::Op, quantity<DX, X>, quantity_vector<DY, Y>> \
+    operator op( quantity<DX, X> const & lhs, quantity_vector<DY, Y> const & rhs ) \
+    { \
+        return detail::make_expr<detail::Op>( lhs, rhs ); \
+    } \
+    template< typename DX, typename X, typename DY, typename Y > \
+    detail::BinaryExpr<detail::Op, quantity_vector<DX, X>, quantity<DY, Y>> \
+    operator op( quantity_vector<DX, X> const & lhs, quantity<DY, Y> const & rhs ) \
+    { \
+        return detail::make_expr<detail::Op>( lhs, rhs ); \
+    } \
+    template< typename DX, typename X, typename Op2, typename L, typename R > \
+    detail::BinaryExpr<detail::Op, quantity<DX, X>, vector_expr<Op2, L, R>> \
+    operator op( quantity<DX, X> const & lhs, vector_expr<Op2, L, R> const & rhs ) \
+    { \
+        return detail::make_expr<detail::Op>( lhs, rhs ); \
+    } \
+    template< typename Op2, typename L, typename R, typename DY, typename Y > \
+    detail::BinaryExpr<detail::Op, vector_expr<Op2, L, R>, quantity<DY, Y>> \
+    operator op( vector_expr<Op2, L, R> const & lhs, quantity<DY, Y> const & rhs ) \
+    { \
+        return detail::make_expr<detail::Op>( lhs, rhs ); \
+    }
+
+PHYS_UNITS_VECTOR_BINARY_OPERATOR( +, plus       )
+PHYS_UNITS_VECTOR_BINARY_OPERATOR( -, minus      )
+PHYS_UNITS_VECTOR_BINARY_OPERATOR( *, multiplies )
+PHYS_UNITS_VECTOR_BINARY_OPERATOR( /, divides    )
+
+#undef PHYS_UNITS_VECTOR_BINARY_OPERATOR
+
+// Unary operators and functions
+
+/// + vec
+
+template< typename E >
+typename std::enable_if< detail::is_vector_operand<E>::value, E const & >::type
+operator+( E const & x )
+{
+    return x;
+}
+
+/// - vec
+
+template< typename E >
+detail::UnaryExpr<detail::negate, E>
+operator-( E const & x )
+{
+    return detail::make_expr<detail::negate>( x );
+}
+
+/// element-wise square.
+
+template< typename E >
+detail::UnaryExpr<detail::squares, E>
+square( E const & x )
+{
+    return detail::make_expr<detail::squares>( x );
+}
+
+/// element-wise cube.
+
+template< typename E >
+detail::UnaryExpr<detail::cubes, E>
+cube( E const & x )
+{
+    return detail::make_expr<detail::cubes>( x );
+}
+
+/// element-wise square root.
+
+template< typename E >
+detail::UnaryExpr<detail::square_root, E>
+sqrt( E const & x )
+{
+    return detail::make_expr<detail::square_root>( x );
+}
+
+/// element-wise absolute value.
+
+template< typename E >
+detail::UnaryExpr<detail::absolute, E>
+abs( E const & x )
+{
+    return detail::make_expr<detail::absolute>( x );
+}
+
+}} // namespace phys::units
+
+#endif // PHYS_UNITS_QUANTITY_EXPRESSION_HPP_INCLUDED
+
+/*
+ * end of file
+ */
@@ -25,11 +25,39 @@
 #include "phys/units/quantity.hpp"
 
 #include <algorithm>
+#include <clocale>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iosfwd>
-#include <map>
+#include <limits>
 #include <stdexcept>
 #include <string>
 #include <sstream>
+#include <system_error>
+#include <type_traits>
+
+// Configuration
+
+#ifndef PHYS_UNITS_HAVE_STD_TO_CHARS
+# if __cplusplus >= 201703L && defined( __has_include )
+#  if __has_include( <charconv> )
+#   include <charconv>
+#  endif
+# endif
+# if defined( __cpp_lib_to_chars ) && __cpp_lib_to_chars >= 201611L
+#  define PHYS_UNITS_HAVE_STD_TO_CHARS  1
+# else
+#  define PHYS_UNITS_HAVE_STD_TO_CHARS  0
+# endif
+#endif
+
+#if PHYS_UNITS_HAVE_STD_TO_CHARS
+# include <charconv>
+#endif
 
 /// namespace phys.
 
@@ -55,105 +83,277 @@ struct prefix_error : public quantity_error
         : quantity_error( text ) { }
 };
 
-/// return factor for given prefix.
+/// namespace detail.
 
-inline Rep prefix( std::string const prefix_ )
-{
-    std::map<std::string, Rep> table
-    {
-        { "m", milli },
-        { "k", kilo  },
-        { "u", micro },
-        { "M", mega  },
-        { "n", nano  },
-        { "G", giga  },
-        { "p", pico  },
-        { "T", tera  },
-        { "f", femto },
-        { "P", peta  },
-        { "a", atto  },
-        { "E", exa   },
-        { "z", zepto },
-        { "Z", zetta },
-        { "y", yocto },
-        { "Y", yotta },
-        { "h", hecto },
-        { "da", deka },
-        { "d", deci  },
-        { "c", centi },
-    };
+namespace detail {
+
+/**
+ * SI prefix and its factor.
+ */
+struct prefix_entry
+{
+    char const * symbol;
+    std::size_t  length;
+    long double  factor;
+};
+
+/**
+ * perfect hash: maps each of the 20 SI prefixes to its own slot in prefix_table.
+ */
+constexpr std::size_t prefix_hash( char const * text, std::size_t length )
+{
+    return ( ( static_cast<unsigned char>( text[0] ) +
+        ( length > 1 ? static_cast<unsigned char>( text[1] ) : 0u ) ) * 15u >> 4 ) & 31u;
+}
 
-    auto pos = table.find( prefix_ );
+constexpr prefix_entry prefix_table[32] =
+{
+    { "E",  1, exa    },  //  0
+    { "h",  1, hecto  },  //  1
+    { "G",  1, giga   },  //  2
+    { "",   0, 0      },  //  3
+    { "k",  1, kilo   },  //  4
+    { "",   0, 0      },  //  5
+    { "m",  1, milli  },  //  6
+    { "n",  1, nano   },  //  7
+    { "M",  1, mega   },  //  8
+    { "p",  1, pico   },  //  9
+    { "",   0, 0      },  // 10
+    { "P",  1, peta   },  // 11
+    { "",   0, 0      },  // 12
+    { "u",  1, micro  },  // 13
+    { "T",  1, tera   },  // 14
+    { "",   0, 0      },  // 15
+    { "",   0, 0      },  // 16
+    { "y",  1, yocto  },  // 17
+    { "z",  1, zepto  },  // 18
+    { "Y",  1, yotta  },  // 19
+    { "Z",  1, zetta  },  // 20
+    { "",   0, 0      },  // 21
+    { "",   0, 0      },  // 22
+    { "",   0, 0      },  // 23
+    { "da", 2, deka   },  // 24
+    { "",   0, 0      },  // 25
+    { "a",  1, atto   },  // 26
+    { "",   0, 0      },  // 27
+    { "c",  1, centi  },  // 28
+    { "d",  1, deci   },  // 29
+    { "",   0, 0      },  // 30
+    { "f",  1, femto  },  // 31
+};
+
+constexpr bool prefix_equal( prefix_entry const & entry, char const * text, std::size_t length )
+{
+    return entry.length == length && entry.symbol[0] == text[0] && ( length < 2 || entry.symbol[1] == text[1] );
+}
 
-    if ( pos == table.end() )
+/// the table entry for the given prefix, or nullptr if the prefix is unrecognized.
+
+constexpr prefix_entry const * find_prefix( char const * text, std::size_t length )
+{
+    return ( length == 1 || length == 2 ) && prefix_equal( prefix_table[ prefix_hash( text, length ) ], text, length )
+        ? &prefix_table[ prefix_hash( text, length ) ] : nullptr;
+}
+
+} // namespace detail
+
+/// return factor for given prefix, or set ec to std::errc::invalid_argument if prefix is unrecognized.
+
+inline Rep prefix( char const * text, std::size_t length, std::error_code & ec ) noexcept
+{
+    detail::prefix_entry const * const entry = detail::find_prefix( text, length );
+
+    if ( entry == nullptr )
     {
-        throw prefix_error( "quantity: unrecognized prefix '" + prefix_ + "'" );
+        ec = std::make_error_code( std::errc::invalid_argument );
+        return Rep( 0 );
     }
 
-    return pos->second;
+    ec.clear();
+    return Rep( entry->factor );
 }
 
+/// return factor for given prefix.
+
+inline Rep prefix( char const * text, std::size_t length )
+{
+    detail::prefix_entry const * const entry = detail::find_prefix( text, length );
+
+    if ( entry == nullptr )
+    {
+        throw prefix_error( "quantity: unrecognized prefix '" + std::string( text, length ) + "'" );
+    }
+
+    return Rep( entry->factor );
+}
+
+/// return factor for given prefix.
+
+inline Rep prefix( char const * text )
+{
+    return prefix( text, std::strlen( text ) );
+}
+
+/// return factor for given prefix.
+
+inline Rep prefix( std::string const & prefix_ )
+{
+    return prefix( prefix_.data(), prefix_.size() );
+}
+
+/// namespace detail.
+
+namespace detail {
+
+/**
+ * compile-time character sequence, available as null-terminated array.
+ */
+template< char... Cs >
+struct char_seq
+{
+    static constexpr char value[] = { Cs..., '\0' };
+};
+
+template< char... Cs >
+constexpr char char_seq<Cs...>::value[];
+
+template< typename A, typename B >
+struct concat;
+
+template< char... As, char... Bs >
+struct concat< char_seq<As...>, char_seq<Bs...> >
+{
+    typedef char_seq<As..., Bs...> type;
+};
+
+/// A and B, separated by a space if both are non-empty.
+
+template< typename A, typename B >
+struct join
+{
+    typedef typename concat< typename concat< A, char_seq<' '> >::type, B >::type type;
+};
+
+template< typename B >
+struct join< char_seq<>, B > { typedef B type; };
+
+template< typename A >
+struct join< A, char_seq<> > { typedef A type; };
+
+template<>
+struct join< char_seq<>, char_seq<> > { typedef char_seq<> type; };
+
+/// decimal digits of N >= 0.
+
+template< int N, bool = ( N < 10 ) >
+struct digits
+{
+    typedef char_seq< char( '0' + N ) > type;
+};
+
+template< int N >
+struct digits< N, false >
+{
+    typedef typename concat< typename digits< N / 10 >::type, char_seq< char( '0' + N % 10 ) > >::type type;
+};
+
+/// exponent as in m+2 and s-1; none for 1.
+
+template< int E >
+struct exponent_seq
+{
+    typedef typename concat< char_seq< ( E < 0 ) ? '-' : '+' >, typename digits< ( E < 0 ) ? -E : E >::type >::type type;
+};
+
+template<>
+struct exponent_seq< 1 > { typedef char_seq<> type; };
+
+/// symbol of base dimension I.
+
+template< int I > struct base_seq;
+
+template<> struct base_seq< 1 > { typedef char_seq< 'm'           > type; };
+template<> struct base_seq< 2 > { typedef char_seq< 'k', 'g'      > type; };
+template<> struct base_seq< 3 > { typedef char_seq< 's'           > type; };
+template<> struct base_seq< 4 > { typedef char_seq< 'A'           > type; };
+template<> struct base_seq< 5 > { typedef char_seq< 'K'           > type; };
+template<> struct base_seq< 6 > { typedef char_seq< 'm', 'o', 'l' > type; };
+template<> struct base_seq< 7 > { typedef char_seq< 'c', 'd'      > type; };
+
+/// symbol and exponent of base dimension I; none if E is 0.
+
+template< int I, int E >
+struct dimension_seq
+{
+    typedef typename concat< typename base_seq< I >::type, typename exponent_seq< E >::type >::type type;
+};
+
+template< int I >
+struct dimension_seq< I, 0 > { typedef char_seq<> type; };
+
+/// symbol of dimensions, as in "m kg+2 s-1".
+
+template< typename Dims >
+struct symbol_seq
+{
+    typedef
+        typename join< typename dimension_seq< 1, Dims::dim1 >::type,
+        typename join< typename dimension_seq< 2, Dims::dim2 >::type,
+        typename join< typename dimension_seq< 3, Dims::dim3 >::type,
+        typename join< typename dimension_seq< 4, Dims::dim4 >::type,
+        typename join< typename dimension_seq< 5, Dims::dim5 >::type,
+        typename join< typename dimension_seq< 6, Dims::dim6 >::type,
+                       typename dimension_seq< 7, Dims::dim7 >::type
+        >::type >::type >::type >::type >::type >::type type;
+};
+
+} // namespace detail
+
 /**
  * Provide SI units-and-exponents in as close to NIST-specified format as possible with plain ascii.
  *
  * Made presentation customizable by specialization of template.
  * Adapted by Martin Moene, 21 February 2012.
+ *
+ * The name and symbol are compile-time constants, c_name() and c_symbol();
+ * name() and symbol() provide them as std::string.
  */
 template <typename Dims>
 struct unit_info
 {
     /// true if base dimension.
 
-    static bool single()
+    static constexpr bool single()
     {
         return Dims::is_base;
     }
 
     /// provide unit's name.
 
-    static std::string name()
+    static constexpr char const * c_name()
     {
-        return symbol();
+        return c_symbol();
     }
 
-    /// provide unit's symbol.
+    /// provide unit's symbol, e.g. "m kg+2 s-1".
 
-    static std::string symbol()
+    static constexpr char const * c_symbol()
     {
-        std::ostringstream os;
-
-        bool first = true;
-
-        emit_dim( os, "m",   Dims::dim1, first );
-        emit_dim( os, "kg",  Dims::dim2, first );
-        emit_dim( os, "s",   Dims::dim3, first );
-        emit_dim( os, "A",   Dims::dim4, first );
-        emit_dim( os, "K",   Dims::dim5, first );
-        emit_dim( os, "mol", Dims::dim6, first );
-        emit_dim( os, "cd",  Dims::dim7, first );
-
-        return os.str();
+        return detail::symbol_seq<Dims>::type::value;
     }
 
-    /// emit a single dimension.
+    /// provide unit's name.
 
-    static void emit_dim( std::ostream & os, const char * label, int exp, bool & first )
+    static std::string name()
     {
-        if( exp == 0 )
-            return;
-
-        if ( first )
-            first = false;
-        else
-            os << " ";
-
-        os << label;
+        return c_name();
+    }
 
-        if( exp > 1 )
-            os << "+";
+    /// provide unit's symbol.
 
-        if( exp != 1 )
-            os << exp;
+    static std::string symbol()
+    {
+        return c_symbol();
     }
 };
 
@@ -218,6 +418,668 @@ inline std::string to_string( long double const value )
     return os.str();
 }
 
+/**
+ * result of to_chars(): one past the last character written and error code.
+ */
+struct to_chars_result
+{
+    char *    ptr;
+    std::errc ec;
+};
+
+/// namespace detail.
+
+namespace detail {
+
+/// true if unit_info U provides its symbol at compile time.
+
+template< typename U, typename = void >
+struct has_c_symbol : std::false_type { };
+
+template< typename U >
+struct has_c_symbol< U, typename always_void< decltype( U::c_symbol() ) >::type > : std::true_type { };
+
+/// unit symbol: a compile-time constant, or for a unit_info without c_symbol(), computed once.
+
+template< typename Dims >
+typename std::enable_if< has_c_symbol< unit_info<Dims> >::value, char const * >::type
+symbol_text()
+{
+    return unit_info<Dims>::c_symbol();
+}
+
+template< typename Dims >
+typename std::enable_if< !has_c_symbol< unit_info<Dims> >::value, char const * >::type
+symbol_text()
+{
+    static std::string const symbol = unit_info<Dims>::symbol();
+    return symbol.c_str();
+}
+
+// Shortest round-trip digits after Ryu (Ulf Adams, PLDI 2018); the tables of
+// 5^i and 2^k / 5^i, to 125 bits, are computed once at first use.
+
+/// 64 x 64 -> 128 bit product.
+
+inline std::uint64_t umul128( std::uint64_t const a, std::uint64_t const b, std::uint64_t & high )
+{
+    std::uint64_t const a_lo = a & 0xffffffffu, a_hi = a >> 32;
+    std::uint64_t const b_lo = b & 0xffffffffu, b_hi = b >> 32;
+
+    std::uint64_t const b00 = a_lo * b_lo;
+    std::uint64_t const mid1 = a_hi * b_lo + ( b00 >> 32 );
+    std::uint64_t const mid2 = a_lo * b_hi + ( mid1 & 0xffffffffu );
+
+    high = a_hi * b_hi + ( mid1 >> 32 ) + ( mid2 >> 32 );
+    return ( mid2 << 32 ) | ( b00 & 0xffffffffu );
+}
+
+/// ( m * mul ) >> j for a 125-bit mul = { low, high }, 64 < j < 128.
+
+inline std::uint64_t mul_shift( std::uint64_t const m, std::uint64_t const * mul, int const j )
+{
+    std::uint64_t high0, high1;
+    umul128( m, mul[0], high0 );
+    std::uint64_t const low1 = umul128( m, mul[1], high1 );
+    std::uint64_t const sum  = high0 + low1;
+
+    if ( sum < high0 )
+        ++high1;
+
+    return ( high1 << ( 128 - j ) ) | ( sum >> ( j - 64 ) );
+}
+
+/// bits of 5^e (1 for e == 0), log10( 2^e ) and log10( 5^e ), rounded down.
+
+inline int pow5_bits( int const e ) { return static_cast<int>( ( static_cast<std::uint32_t>( e ) * 1217359 ) >> 19 ) + 1; }
+inline int log10_pow2( int const e ) { return static_cast<int>( ( static_cast<std::uint32_t>( e ) * 78913 ) >> 18 ); }
+inline int log10_pow5( int const e ) { return static_cast<int>( ( static_cast<std::uint32_t>( e ) * 732923 ) >> 20 ); }
+
+inline bool multiple_of_pow5( std::uint64_t value, int const p )
+{
+    int count = 0;
+    for ( ; value % 5 == 0; value /= 5 )
+        ++count;
+    return count >= p;
+}
+
+inline bool multiple_of_pow2( std::uint64_t const value, int const p )
+{
+    return ( value & ( ( std::uint64_t( 1 ) << p ) - 1 ) ) == 0;
+}
+
+/**
+ * the 125 leading bits of 5^i and 2^( pow5_bits(q) - 1 + 125 ) / 5^q + 1,
+ * enough for the exponent range of double.
+ */
+struct ryu_tables
+{
+    enum { bits = 125, pow5_size = 326, pow5_inv_size = 342, words = 28 };
+
+    std::uint64_t pow5[ pow5_size ][2];
+    std::uint64_t pow5_inv[ pow5_inv_size ][2];
+
+    ryu_tables()
+    {
+        std::uint32_t p[ words ] = { 1 };   // 5^i, little-endian 32-bit words
+
+        for ( int i = 0; i < pow5_inv_size; ++i )
+        {
+            int const b = pow5_bits( i );
+
+            if ( i < pow5_size )
+                leading_bits( p, b - bits, pow5[i] );
+
+            quotient( p, b, pow5_inv[i] );
+
+            std::uint64_t carry = 0;
+            for ( int w = 0; w < words; ++w )
+            {
+                carry += std::uint64_t( p[w] ) * 5;
+                p[w] = static_cast<std::uint32_t>( carry );
+                carry >>= 32;
+            }
+        }
+    }
+
+private:
+    static bool bit( std::uint32_t const * x, int const k )
+    {
+        return k >= 0 && k < 32 * words && ( x[ k / 32 ] >> ( k % 32 ) & 1 );
+    }
+
+    // bits [shift, shift + 128) of x.
+
+    static void leading_bits( std::uint32_t const * x, int const shift, std::uint64_t * out )
+    {
+        out[0] = out[1] = 0;
+
+        for ( int t = 0; t < 128; ++t )
+            if ( bit( x, shift + t ) )
+                out[ t / 64 ] |= std::uint64_t( 1 ) << ( t % 64 );
+    }
+
+    // 2^( b - 1 + bits ) / x + 1 by long division, from remainder 2^( b - 1 ) <= x on.
+
+    static void quotient( std::uint32_t const * x, int const b, std::uint64_t * out )
+    {
+        std::uint32_t r[ words ] = { 0 };
+        r[ ( b - 1 ) / 32 ] = std::uint32_t( 1 ) << ( ( b - 1 ) % 32 );
+
+        out[0] = out[1] = 0;
+
+        for ( int t = bits; t >= 0; --t )
+        {
+            if ( t < bits )
+            {
+                for ( int w = words - 1; w > 0; --w )
+                    r[w] = ( r[w] << 1 ) | ( r[w - 1] >> 31 );
+                r[0] <<= 1;
+            }
+
+            int w = words - 1;
+            while ( w > 0 && r[w] == x[w] )
+                --w;
+
+            if ( r[w] >= x[w] )
+            {
+                std::uint64_t borrow = 0;
+                for ( int k = 0; k < words; ++k )
+                {
+                    std::uint64_t const d = std::uint64_t( r[k] ) - x[k] - borrow;
+                    r[k] = static_cast<std::uint32_t>( d );
+                    borrow = d >> 63;
+                }
+                out[ t / 64 ] |= std::uint64_t( 1 ) << ( t % 64 );
+            }
+        }
+
+        if ( ++out[0] == 0 )
+            ++out[1];
+    }
+};
+
+inline ryu_tables const & get_ryu_tables()
+{
+    static ryu_tables const tables;
+    return tables;
+}
+
+/// the IEEE-754 layout of float and double.
+
+template< typename T > struct ieee_layout;
+
+template<> struct ieee_layout<float>  { typedef std::uint32_t bits_type; enum { mantissa_bits = 23, exponent_bits =  8, bias =  127 }; };
+template<> struct ieee_layout<double> { typedef std::uint64_t bits_type; enum { mantissa_bits = 52, exponent_bits = 11, bias = 1023 }; };
+
+/**
+ * the shortest decimal digits * 10^exponent that reads back as the finite,
+ * positive value, with the digits closest to value and ties to even.
+ */
+template< typename T >
+void shortest_decimal( T const value, std::uint64_t & digits, int & exponent )
+{
+    typedef ieee_layout<T> layout;
+    typename layout::bits_type bits;
+    std::memcpy( &bits, &value, sizeof bits );
+
+    int const mbits = layout::mantissa_bits;
+    std::uint64_t const ieee_mantissa = bits & ( ( typename layout::bits_type( 1 ) << mbits ) - 1 );
+    int const ieee_exponent = static_cast<int>( bits >> mbits & ( ( 1u << layout::exponent_bits ) - 1 ) );
+
+    // small integers are exact.
+
+    int const e = ieee_exponent - layout::bias - mbits;
+
+    if ( ieee_exponent != 0 && e <= 0 && e >= -mbits )
+    {
+        std::uint64_t const m = ieee_mantissa | std::uint64_t( 1 ) << mbits;
+
+        if ( ( m & ( ( std::uint64_t( 1 ) << -e ) - 1 ) ) == 0 )
+        {
+            digits = m >> -e;
+            exponent = 0;
+
+            for ( ; digits % 10 == 0; digits /= 10 )
+                ++exponent;
+            return;
+        }
+    }
+
+    int e2;
+    std::uint64_t m2;
+
+    if ( ieee_exponent == 0 )
+    {
+        e2 = 1 - layout::bias - mbits - 2;
+        m2 = ieee_mantissa;
+    }
+    else
+    {
+        e2 = ieee_exponent - layout::bias - mbits - 2;
+        m2 = ieee_mantissa | std::uint64_t( 1 ) << mbits;
+    }
+
+    bool const accept_bounds = ( m2 & 1 ) == 0;
+
+    // the value and its halfway points to the neighbours, times 4.
+
+    std::uint64_t const mv = 4 * m2;
+    unsigned const mm_shift = ieee_mantissa != 0 || ieee_exponent <= 1;
+
+    std::uint64_t vr, vp, vm;
+    int e10;
+    bool vm_is_trailing_zeros = false;
+    bool vr_is_trailing_zeros = false;
+
+    ryu_tables const & tables = get_ryu_tables();
+
+    if ( e2 >= 0 )
+    {
+        int const q = log10_pow2( e2 ) - ( e2 > 3 );
+        int const k = ryu_tables::bits + pow5_bits( q ) - 1;
+        int const i = -e2 + q + k;
+        e10 = q;
+
+        vr = mul_shift( 4 * m2, tables.pow5_inv[q], i );
+        vp = mul_shift( 4 * m2 + 2, tables.pow5_inv[q], i );
+        vm = mul_shift( 4 * m2 - 1 - mm_shift, tables.pow5_inv[q], i );
+
+        if ( q <= 21 )
+        {
+            if ( mv % 5 == 0 )
+                vr_is_trailing_zeros = multiple_of_pow5( mv, q );
+            else if ( accept_bounds )
+                vm_is_trailing_zeros = multiple_of_pow5( mv - 1 - mm_shift, q );
+            else
+                vp -= multiple_of_pow5( mv + 2, q );
+        }
+    }
+    else
+    {
+        int const q = log10_pow5( -e2 ) - ( -e2 > 1 );
+        int const i = -e2 - q;
+        int const k = pow5_bits( i ) - ryu_tables::bits;
+        int const j = q - k;
+        e10 = q + e2;
+
+        vr = mul_shift( 4 * m2, tables.pow5[i], j );
+        vp = mul_shift( 4 * m2 + 2, tables.pow5[i], j );
+        vm = mul_shift( 4 * m2 - 1 - mm_shift, tables.pow5[i], j );
+
+        if ( q <= 1 )
+        {
+            vr_is_trailing_zeros = true;
+
+            if ( accept_bounds )
+                vm_is_trailing_zeros = mm_shift == 1;
+            else
+                --vp;
+        }
+        else if ( q < 63 )
+        {
+            vr_is_trailing_zeros = multiple_of_pow2( mv, q );
+        }
+    }
+
+    // remove digits while the interval [vm, vp] still holds a shorter number.
+
+    int removed = 0;
+    unsigned last_removed = 0;
+
+    if ( vm_is_trailing_zeros || vr_is_trailing_zeros )
+    {
+        for ( ; vp / 10 > vm / 10; ++removed )
+        {
+            vm_is_trailing_zeros &= vm % 10 == 0;
+            vr_is_trailing_zeros &= last_removed == 0;
+            last_removed = static_cast<unsigned>( vr % 10 );
+            vr /= 10; vp /= 10; vm /= 10;
+        }
+
+        if ( vm_is_trailing_zeros )
+        {
+            for ( ; vm % 10 == 0; ++removed )
+            {
+                vr_is_trailing_zeros &= last_removed == 0;
+                last_removed = static_cast<unsigned>( vr % 10 );
+                vr /= 10; vp /= 10; vm /= 10;
+            }
+        }
+
+        if ( vr_is_trailing_zeros && last_removed == 5 && vr % 2 == 0 )
+            last_removed = 4;
+
+        digits = vr + ( ( vr == vm && ( !accept_bounds || !vm_is_trailing_zeros ) ) || last_removed >= 5 );
+    }
+    else
+    {
+        bool round_up = false;
+
+        for ( ; vp / 10 > vm / 10; ++removed )
+        {
+            round_up = vr % 10 >= 5;
+            vr /= 10; vp /= 10; vm /= 10;
+        }
+
+        digits = vr + ( vr == vm || round_up );
+    }
+
+    exponent = e10 + removed;
+
+    for ( ; digits % 10 == 0; digits /= 10 )
+        ++exponent;
+}
+
+/**
+ * the shortest digits * 10^exponent that read back as the finite, positive
+ * value, as characters; returns the number of digits.
+ */
+template< typename T >
+int shortest_digits( T const value, char * buffer, int & exponent )
+{
+    std::uint64_t digits;
+    shortest_decimal( value, digits, exponent );
+
+    int n = 0;
+
+    for ( ; digits != 0; digits /= 10 )
+        buffer[n++] = static_cast<char>( '0' + digits % 10 );
+
+    std::reverse( buffer, buffer + n );
+    return n;
+}
+
+/**
+ * copy [first, last) to out, which has room for size characters and a null
+ * character, such that strtod() and friends read it as in the "C" locale
+ * whatever the current C locale: the first '.' becomes the locale's decimal
+ * point, and the copy stops at a character that starts a different decimal
+ * point, e.g. at the ',' of "1,5". point is the position of the decimal point
+ * in the copy and extra the number of characters it adds; false if the copy
+ * was cut short by size.
+ */
+inline bool copy_for_strto( char const * first, char const * last, char * out, std::size_t const size, std::size_t & point, std::size_t & extra )
+{
+    char const * const decimal_point = std::localeconv()->decimal_point;
+    std::size_t  const length = std::strlen( decimal_point );
+
+    std::size_t n = 0;
+    point = size;
+    extra = 0;
+
+    for ( ; first != last; ++first )
+    {
+        if ( *first == '.' && point == size )
+        {
+            if ( n + length > size )
+                break;
+
+            std::memcpy( out + n, decimal_point, length );
+            point = n;
+            extra = length - 1;
+            n += length;
+        }
+        else if ( *first == decimal_point[0] && *first != '.' )
+        {
+            first = last;
+            break;
+        }
+        else if ( n == size )
+        {
+            break;
+        }
+        else
+        {
+            out[n++] = *first;
+        }
+    }
+    out[n] = '\0';
+    return first == last;
+}
+
+/**
+ * for long double, the fewest of at most max_digits10 digits that %Le
+ * rounds to and that read back; independent of the C locale, as the
+ * decimal point is skipped and the digits read back via copy_for_strto().
+ */
+inline int shortest_digits( long double const value, char * buffer, int & exponent )
+{
+    char text[64];
+    int n = 0;
+
+    for ( int precision = std::numeric_limits<long double>::digits10; ; ++precision )
+    {
+        std::snprintf( text, sizeof text, "%.*Le", precision - 1, value );
+
+        // d<decimal point>ddde[+-]xx
+
+        char const * p = text;
+
+        for ( n = 0; *p != 'e'; ++p )
+        {
+            if ( '0' <= *p && *p <= '9' )
+                buffer[n++] = *p;
+        }
+
+        exponent = std::atoi( p + 1 );
+
+        if ( precision >= std::numeric_limits<long double>::max_digits10 )
+            break;
+
+        // d.ddde[+-]xx, as in the "C" locale.
+
+        char c_text[64];
+        c_text[0] = buffer[0];
+        c_text[1] = '.';
+        std::memcpy( c_text + 2, buffer + 1, static_cast<std::size_t>( n - 1 ) );
+        std::strcpy( c_text + n + 1, p );
+
+        char local[72];
+        std::size_t point;
+        std::size_t extra;
+
+        copy_for_strto( c_text, c_text + std::strlen( c_text ), local, sizeof local - 1, point, extra );
+
+        if ( std::strtold( local, nullptr ) == value )
+            break;
+    }
+
+    exponent -= n - 1;
+
+    for ( ; n > 1 && buffer[n - 1] == '0'; --n )
+        ++exponent;
+
+    return n;
+}
+
+/**
+ * write the exact digits of the integral, positive value, as std::to_chars()
+ * does for fixed notation with trailing zeros, such as 190944592 for 1.9094459e8f.
+ */
+template< typename T >
+char * exact_integer( T const value, char * out )
+{
+    int exponent;
+    T const fraction = std::frexp( value, &exponent );
+
+    int const shift = exponent - std::numeric_limits<T>::digits;
+    std::uint64_t const mantissa = static_cast<std::uint64_t>( std::ldexp( fraction, std::numeric_limits<T>::digits ) );
+
+    // mantissa * 2^shift, 0 < shift < 64 below 1e25, in 32-bit words, divided by 10 for each digit.
+
+    std::uint64_t low = static_cast<std::uint64_t>( value ), high = 0;
+
+    if ( shift > 0 )
+    {
+        low  = mantissa << shift;
+        high = mantissa >> ( 64 - shift );
+    }
+
+    std::uint32_t words[4] =
+    {
+        static_cast<std::uint32_t>( low  ), static_cast<std::uint32_t>( low  >> 32 ),
+        static_cast<std::uint32_t>( high ), static_cast<std::uint32_t>( high >> 32 ),
+    };
+
+    char digits[40];
+    int n = 0;
+
+    for ( bool nonzero = true; nonzero; )
+    {
+        std::uint64_t remainder = 0;
+        nonzero = false;
+
+        for ( int w = 3; w >= 0; --w )
+        {
+            std::uint64_t const current = remainder << 32 | words[w];
+            words[w] = static_cast<std::uint32_t>( current / 10 );
+            remainder = current % 10;
+            nonzero |= words[w] != 0;
+        }
+
+        digits[n++] = static_cast<char>( '0' + remainder );
+    }
+
+    while ( n > 0 )
+        *out++ = digits[--n];
+
+    return out;
+}
+
+/**
+ * write the shortest text that reads back as value, as std::to_chars( first, last, value )
+ * does: in fixed or in scientific notation, whichever is shorter, fixed on a tie.
+ */
+template< typename T >
+to_chars_result shortest_chars( char * first, char * last, T const value )
+{
+    char text[64];
+    char * out = text;
+
+    if ( std::signbit( value ) )
+        *out++ = '-';
+
+    if ( std::isnan( value ) || std::isinf( value ) )
+    {
+        out = std::copy_n( std::isnan( value ) ? "nan" : "inf", 3, out );
+    }
+    else if ( value == 0 )
+    {
+        *out++ = '0';
+    }
+    else
+    {
+        char buffer[40];
+        int exponent;
+        int const n = shortest_digits( std::signbit( value ) ? -value : value, buffer, exponent );
+
+        int const sci_exponent = exponent + n - 1;
+        int const abs_exponent = sci_exponent < 0 ? -sci_exponent : sci_exponent;
+        int const sci_length   = n + ( n > 1 ) + 2 + ( abs_exponent >= 100 ? 3 : 2 );
+        int const fixed_length = exponent >= 0 ? n + exponent : n + exponent > 0 ? n + 1 : 2 - exponent;
+
+        if ( fixed_length <= sci_length )
+        {
+            if ( exponent > 0 )
+            {
+                out = exact_integer( std::signbit( value ) ? -value : value, out );
+            }
+            else if ( exponent == 0 )
+            {
+                out = std::copy( buffer, buffer + n, out );
+            }
+            else if ( n + exponent > 0 )
+            {
+                out = std::copy( buffer, buffer + n + exponent, out );
+                *out++ = '.';
+                out = std::copy( buffer + n + exponent, buffer + n, out );
+            }
+            else
+            {
+                *out++ = '0';
+                *out++ = '.';
+                out = std::fill_n( out, -( n + exponent ), '0' );
+                out = std::copy( buffer, buffer + n, out );
+            }
+        }
+        else
+        {
+            *out++ = buffer[0];
+
+            if ( n > 1 )
+            {
+                *out++ = '.';
+                out = std::copy( buffer + 1, buffer + n, out );
+            }
+
+            *out++ = 'e';
+            *out++ = sci_exponent < 0 ? '-' : '+';
+
+            if ( abs_exponent >= 100 )
+                *out++ = static_cast<char>( '0' + abs_exponent / 100 );
+
+            *out++ = static_cast<char>( '0' + abs_exponent / 10 % 10 );
+            *out++ = static_cast<char>( '0' + abs_exponent % 10 );
+        }
+    }
+
+    std::ptrdiff_t const length = out - text;
+
+    if ( length > last - first )
+        return { last, std::errc::value_too_large };
+
+    std::memcpy( first, text, length );
+    return { first + length, std::errc() };
+}
+
+/**
+ * write the shortest text that reads back as value: with std::to_chars()
+ * where available, else with shortest_chars(), which gives the same text.
+ */
+template< typename T >
+to_chars_result format_shortest( char * first, char * last, T const value )
+{
+#if PHYS_UNITS_HAVE_STD_TO_CHARS
+    std::to_chars_result const result = std::to_chars( first, last, value );
+    return { result.ptr, result.ec };
+#else
+    return shortest_chars( first, last, value );
+#endif
+}
+
+} // namespace detail
+
+/**
+ * write quantity as text to [first, last), like io::operator<<, but with the
+ * shortest magnitude that reads back exactly and without allocation.
+ * Returns std::errc::value_too_large if the text does not fit.
+ */
+template< typename Dims, typename T >
+to_chars_result to_chars( char * first, char * last, quantity<Dims, T> const & q )
+{
+    to_chars_result const result = detail::format_shortest( first, last, q.magnitude() );
+
+    if ( result.ec != std::errc() )
+        return result;
+
+    char const * const symbol = detail::symbol_text<Dims>();
+
+    std::size_t const size   = std::strlen( symbol );
+    std::size_t const space  = Dims::is_all_zero ? 0 : 1;
+    std::size_t const length = space + size;
+
+    if ( length > std::size_t( last - result.ptr ) )
+        return { last, std::errc::value_too_large };
+
+    if ( space )
+        *result.ptr = ' ';
+
+    std::memcpy( result.ptr + space, symbol, size );
+
+    return { result.ptr + length, std::errc() };
+}
+
 /// namespace io.
 
 namespace io {
@@ -227,7 +1089,7 @@ namespace io {
 template< typename Dims, typename T >
 std::ostream & operator<<( std::ostream & os, quantity<Dims, T> const & q )
 {
-    return os << q.magnitude() << (Dims::is_all_zero ? "":" ") << to_unit_symbol( q );
+    return os << q.magnitude() << (Dims::is_all_zero ? "":" ") << detail::symbol_text<Dims>();
 }
 
 /// quantity string representation.
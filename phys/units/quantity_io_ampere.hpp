@@ -25,9 +25,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< electric_current_d >
 {
-   static bool        single() { return true; }
-   static std::string name()   { return "ampere"; }
-   static std::string symbol() { return "A"; }
+   static constexpr bool         single()   { return true; }
+   static constexpr char const * c_name()   { return "ampere"; }
+   static constexpr char const * c_symbol() { return "A"; }
+   static std::string            name()     { return c_name(); }
+   static std::string            symbol()   { return c_symbol(); }
 };
 
 }} // namespace phys::units
@@ -26,9 +26,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< activity_of_a_nuclide_d >
 {
-    static bool        single() { return true; }
-    static std::string name()   { return "becquerel"; }
-    static std::string symbol() { return "Bq"; }
+    static constexpr bool         single()   { return true; }
+    static constexpr char const * c_name()   { return "becquerel"; }
+    static constexpr char const * c_symbol() { return "Bq"; }
+    static std::string            name()     { return c_name(); }
+    static std::string            symbol()   { return c_symbol(); }
 };
 
 namespace literals {
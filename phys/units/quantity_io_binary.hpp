@@ -0,0 +1,396 @@
+/**
+ * \file quantity_io_binary.hpp
+ *
+ * \brief   Binary column format for series of quantities, with the dimensions in the header.
+ * \author  Martin Moene
+ * \date    16 October 2026
+ * \since   1.2
+ *
+ * This code is provided as-is, with no warrantee of correctness.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+/*
+ * A column file holds a 64-byte header followed by the raw magnitudes in SI
+ * units, in the byte order of the machine that wrote it:
+ *
+ *   offset  size  contents
+ *        0     4  magic "PUQC"
+ *        4     4  byte-order mark 0x01020304
+ *        8     8  number of elements
+ *       16     7  exponents of the seven base dimensions, signed bytes
+ *       23     1  magnitude kind: 'f' floating point, 'i' signed, 'u' unsigned integer
+ *       24     1  size of the magnitude type in bytes
+ *       25     1  format version, 1
+ *       26     6  reserved, zero
+ *       32    32  unit symbol from unit_info<>, for people; zero-padded
+ *       64        magnitudes
+ *
+ * write_column() and column_writer write a column; the count is patched in
+ * when a column_writer finishes, so its stream must be seekable.
+ * read_column() reads a column into a quantity_vector, view_column() views
+ * a column in memory in place, without copying, e.g. in a mapped_file (see
+ * quantity_span.hpp). Both check the header against the target
+ * quantity<Dims, T> once and throw column_error if it does not match. As the
+ * header is 64 bytes, the magnitudes of a column that is loaded to or mapped
+ * at a 64-byte boundary are aligned for SIMD.
+ */
+
+#ifndef PHYS_UNITS_QUANTITY_IO_BINARY_HPP_INCLUDED
+#define PHYS_UNITS_QUANTITY_IO_BINARY_HPP_INCLUDED
+
+#include "phys/units/quantity_io.hpp"
+#include "phys/units/quantity_span.hpp"
+#include "phys/units/quantity_vector.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+/// namespace phys.
+
+namespace phys {
+
+/// namespace units.
+
+namespace units {
+
+/// column error, e.g. when a column file has other dimensions than expected.
+
+struct column_error : public quantity_error
+{
+    column_error( std::string const text )
+        : quantity_error( text ) { }
+};
+
+/**
+ * \brief struct "column_header" is the 64-byte header of a column file.
+ */
+struct column_header
+{
+    char          magic[4];
+    std::uint32_t byte_order;
+    std::uint64_t count;
+    std::int8_t   exponents[7];
+    char          kind;
+    std::uint8_t  width;
+    std::uint8_t  version;
+    std::uint8_t  reserved[6];
+    char          unit[32];
+
+    /// the unit symbol the column was written with.
+
+    std::string unit_symbol() const
+    {
+        return std::string( unit, std::find( unit, unit + sizeof unit, '\0' ) );
+    }
+};
+
+static_assert( sizeof( column_header ) == 64 && std::is_standard_layout<column_header>::value,
+    "column_header must be 64 bytes without padding" );
+
+/// namespace detail.
+
+namespace detail {
+
+const std::uint32_t column_byte_order = 0x01020304u;
+
+const std::uint8_t column_version = 1;
+
+/// number of magnitudes read_column() reads at a time.
+
+const std::size_t column_chunk = 65536;
+
+/**
+ * the header of a column of count quantities of type quantity<Dims, T>.
+ */
+template< typename Dims, typename T >
+column_header make_column_header( std::uint64_t const count )
+{
+    static_assert( std::is_arithmetic<T>::value, "column magnitudes must be of arithmetic type" );
+
+    column_header h;
+    std::memset( &h, 0, sizeof h );
+
+    std::memcpy( h.magic, "PUQC", 4 );
+    h.byte_order   = column_byte_order;
+    h.count        = count;
+    h.exponents[0] = Dims::dim1;
+    h.exponents[1] = Dims::dim2;
+    h.exponents[2] = Dims::dim3;
+    h.exponents[3] = Dims::dim4;
+    h.exponents[4] = Dims::dim5;
+    h.exponents[5] = Dims::dim6;
+    h.exponents[6] = Dims::dim7;
+    h.kind         = std::is_floating_point<T>::value ? 'f' : std::is_signed<T>::value ? 'i' : 'u';
+    h.width        = sizeof( T );
+    h.version      = column_version;
+
+    std::string const symbol = unit_info<Dims>::symbol();
+    std::memcpy( h.unit, symbol.data(), std::min( symbol.size(), sizeof h.unit - 1 ) );
+
+    return h;
+}
+
+/**
+ * check a header read from a file against the one expected for quantity<Dims, T>;
+ * throws column_error if they differ.
+ */
+template< typename Dims, typename T >
+void check_column_header( column_header const & h )
+{
+    column_header const expected = make_column_header<Dims, T>( h.count );
+
+    if ( std::memcmp( h.magic, expected.magic, sizeof h.magic ) != 0 )
+        throw column_error( "column: not a column file" );
+
+    if ( h.byte_order != column_byte_order )
+        throw column_error( "column: written with another byte order" );
+
+    if ( h.version != column_version )
+        throw column_error( "column: unsupported version " + std::to_string( int( h.version ) ) );
+
+    if ( std::memcmp( h.exponents, expected.exponents, sizeof h.exponents ) != 0 )
+        throw column_error( "column: unit '" + h.unit_symbol() + "' does not have the dimensions of '" + expected.unit_symbol() + "'" );
+
+    if ( h.kind != expected.kind || h.width != expected.width )
+        throw column_error( "column: magnitude type differs" );
+}
+
+} // namespace detail
+
+/**
+ * write the quantities in [first, last) as a column to os.
+ */
+template< typename Dims, typename T >
+std::ostream & write_column( std::ostream & os, quantity<Dims, T> const * first, quantity<Dims, T> const * last )
+{
+    static_assert( detail::is_layout_compatible<Dims, T>::value,
+        "quantity must be layout-compatible with its magnitude type" );
+
+    std::size_t const count = static_cast<std::size_t>( last - first );
+    column_header const h = detail::make_column_header<Dims, T>( count );
+
+    os.write( reinterpret_cast<char const *>( &h ), sizeof h );
+    return os.write( reinterpret_cast<char const *>( first ), static_cast<std::streamsize>( count * sizeof( T ) ) );
+}
+
+/**
+ * write the quantities of v as a column to os.
+ */
+template< typename Dims, typename T >
+std::ostream & write_column( std::ostream & os, quantity_vector<Dims, T> const & v )
+{
+    return write_column( os, v.begin(), v.end() );
+}
+
+/**
+ * \brief class "column_writer" writes a column of quantities with dimensions
+ * Dims piecewise, e.g. as they are produced; the stream must be seekable.
+ */
+template< typename Dims, typename T = Rep >
+class column_writer
+{
+public:
+    typedef quantity<Dims, T> value_type;
+
+    /**
+     * write a header with count zero at the current position of os; throws
+     * column_error if os is not seekable or the write fails.
+     */
+    explicit column_writer( std::ostream & os )
+    : m_os( os ), m_start( os.tellp() ), m_count( 0 ), m_finished( false )
+    {
+        if ( m_start == std::streampos( -1 ) )
+            throw column_error( "column: stream is not seekable" );
+
+        column_header const h = detail::make_column_header<Dims, T>( 0 );
+
+        if ( !m_os.write( reinterpret_cast<char const *>( &h ), sizeof h ) )
+            throw column_error( "column: cannot write header" );
+    }
+
+    column_writer( column_writer const & ) = delete;
+
+    column_writer & operator=( column_writer const & ) = delete;
+
+    /// finish the column, if not yet done; errors are ignored here, call finish() to see them.
+
+    ~column_writer()
+    {
+        if ( !m_finished )
+        {
+            try
+            {
+                finish();
+            }
+            catch ( ... )
+            {
+            }
+        }
+    }
+
+    /**
+     * append the quantities in [first, last); throws column_error if the write fails.
+     */
+    column_writer & write( value_type const * first, value_type const * last )
+    {
+        std::size_t const count = static_cast<std::size_t>( last - first );
+
+        if ( !m_os.write( reinterpret_cast<char const *>( first ), static_cast<std::streamsize>( count * sizeof( T ) ) ) )
+            throw column_error( "column: cannot write data" );
+
+        m_count += count;
+        return *this;
+    }
+
+    /**
+     * append q.
+     */
+    column_writer & push_back( value_type const & q )
+    {
+        return write( &q, &q + 1 );
+    }
+
+    /**
+     * number of quantities written.
+     */
+    std::uint64_t size() const { return m_count; }
+
+    /**
+     * patch the count into the header and leave the stream after the column;
+     * throws column_error if that fails.
+     */
+    std::ostream & finish()
+    {
+        m_finished = true;
+
+        std::streampos const end = m_os.tellp();
+
+        if ( end == std::streampos( -1 )
+            || !m_os.seekp( m_start + std::streamoff( offsetof( column_header, count ) ) )
+            || !m_os.write( reinterpret_cast<char const *>( &m_count ), sizeof m_count )
+            || !m_os.seekp( end ) )
+            throw column_error( "column: cannot patch the count" );
+
+        return m_os;
+    }
+
+private:
+    std::ostream & m_os;
+    std::streampos m_start;
+    std::uint64_t  m_count;
+    bool           m_finished;
+};
+
+/**
+ * read a column written for quantity<Dims, T> from is; throws column_error if
+ * the header does not match, the count is too large or the column is truncated.
+ * The magnitudes are read in chunks, so that a corrupt count fails on the data
+ * rather than on allocating memory for it.
+ */
+template< typename Dims, typename T >
+quantity_vector<Dims, T> read_column( std::istream & is )
+{
+    column_header h;
+
+    if ( !is.read( reinterpret_cast<char *>( &h ), sizeof h ) )
+        throw column_error( "column: truncated header" );
+
+    detail::check_column_header<Dims, T>( h );
+
+    quantity_vector<Dims, T> result;
+
+    // at most max_size() elements, whose size in bytes fits std::size_t, and a std::streamsize.
+
+    std::uintmax_t const max_count = ( std::min )( std::uintmax_t( result.max_size() ),
+        std::uintmax_t( std::numeric_limits<std::streamsize>::max() ) / sizeof( T ) );
+
+    if ( h.count > max_count )
+        throw column_error( "column: too many elements" );
+
+    std::size_t const count = static_cast<std::size_t>( h.count );
+
+    for ( std::size_t done = 0; done < count; )
+    {
+        std::size_t const n = ( std::min )( count - done, detail::column_chunk );
+
+        result.resize( done + n );
+
+        if ( !is.read( reinterpret_cast<char *>( result.magnitudes() + done ), static_cast<std::streamsize>( n * sizeof( T ) ) ) )
+            throw column_error( "column: truncated data" );
+
+        done += n;
+    }
+
+    return result;
+}
+
+/**
+ * \brief class "column_view" is a read-only view of the quantities of a column
+ * in memory, see quantity_span, with the unit symbol of the column.
+ */
+template< typename Dims, typename T = Rep >
+class column_view : public quantity_span<Dims, T const>
+{
+public:
+    column_view() : quantity_span<Dims, T const>(), m_unit() { }
+
+    column_view( quantity_span<Dims, T const> const & span, std::string const & unit )
+    : quantity_span<Dims, T const>( span ), m_unit( unit ) { }
+
+    /**
+     * the unit symbol the column was written with.
+     */
+    std::string const & unit() const { return m_unit; }
+
+private:
+    std::string m_unit;
+};
+
+/**
+ * view the column at [data, data + size) in memory, e.g. a file read into memory,
+ * without copying; data must be aligned for T. Throws column_error if the header
+ * does not match quantity<Dims, T>, the column is truncated or not aligned.
+ */
+template< typename Dims, typename T >
+column_view<Dims, T> view_column( void const * const data, std::size_t const size )
+{
+    static_assert( detail::is_layout_compatible<Dims, T>::value,
+        "quantity must be layout-compatible with its magnitude type" );
+
+    column_header h;
+
+    if ( size < sizeof h )
+        throw column_error( "column: truncated header" );
+
+    std::memcpy( &h, data, sizeof h );
+
+    detail::check_column_header<Dims, T>( h );
+
+    if ( ( size - sizeof h ) / sizeof( T ) < h.count )
+        throw column_error( "column: truncated data" );
+
+    if ( reinterpret_cast<std::uintptr_t>( data ) % alignof( T ) != 0 )
+        throw column_error( "column: data not aligned" );
+
+    return column_view<Dims, T>( make_span<Dims>(
+        reinterpret_cast<T const *>( static_cast<char const *>( data ) + sizeof h ),
+        static_cast<std::size_t>( h.count ) ), h.unit_symbol() );
+}
+
+}} // namespace phys::units
+
+#endif // PHYS_UNITS_QUANTITY_IO_BINARY_HPP_INCLUDED
+
+/*
+ * end of file
+ */
@@ -25,9 +25,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< luminous_intensity_d >
 {
-   static bool        single() { return true; }
-   static std::string name()   { return "candela"; }
-   static std::string symbol() { return "cd"; }
+   static constexpr bool         single()   { return true; }
+   static constexpr char const * c_name()   { return "candela"; }
+   static constexpr char const * c_symbol() { return "cd"; }
+   static std::string            name()     { return c_name(); }
+   static std::string            symbol()   { return c_symbol(); }
 };
 
 }} // namespace phys::units
@@ -27,9 +27,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< thermodynamic_temperature_d >
 {
-    static bool        single() { return true; }
-    static std::string name()   { return "celsius"; }
-    static std::string symbol() { return "C"; }
+    static constexpr bool         single()   { return true; }
+    static constexpr char const * c_name()   { return "celsius"; }
+    static constexpr char const * c_symbol() { return "C"; }
+    static std::string            name()     { return c_name(); }
+    static std::string            symbol()   { return c_symbol(); }
 };
 
 namespace literals {
@@ -26,9 +26,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< electric_charge_d >
 {
-    static bool        single() { return true; }
-    static std::string name()   { return "coulomb"; }
-    static std::string symbol() { return "C"; }
+    static constexpr bool         single()   { return true; }
+    static constexpr char const * c_name()   { return "coulomb"; }
+    static constexpr char const * c_symbol() { return "C"; }
+    static std::string            name()     { return c_name(); }
+    static std::string            symbol()   { return c_symbol(); }
 };
 
 namespace literals {
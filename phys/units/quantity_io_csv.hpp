@@ -0,0 +1,441 @@
+/**
+ * \file quantity_io_csv.hpp
+ *
+ * \brief   Streaming input of CSV and TSV files with unit-annotated columns into quantity_vectors.
+ * \author  Martin Moene
+ * \date    16 October 2026
+ * \since   1.2
+ *
+ * This code is provided as-is, with no warrantee of correctness.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+/*
+ * A csv_reader reads a header line with column names followed by the unit
+ * in square brackets, e.g. "time [s],speed [km/h],force [kN]". The units are
+ * parsed once, as by from_chars(); a column without unit is dimensionless.
+ *
+ * Bind the columns of interest to quantity_vectors with bind(), which checks
+ * the dimensions of the column against those of the vector once. read(n)
+ * then reads up to n rows and replaces the contents of the bound vectors:
+ * each cell is parsed as a number and multiplied by the column's factor to
+ * SI units. Other columns are skipped. The input is read through a buffer of
+ * fixed size, so that memory use is bounded by the buffer and n rows of the
+ * bound columns, whatever the size of the file.
+ *
+ *   csv_reader reader( file );
+ *   quantity_vector<speed_d> speed;
+ *   reader.bind( "speed", speed );
+ *
+ *   while ( reader.read( 65536 ) )
+ *       process( speed );
+ *
+ * The delimiter is a comma, or a tab if the header contains one. Header
+ * fields may be enclosed in double quotes, which may contain the delimiter;
+ * cells may be surrounded by spaces, and an empty cell reads as NaN. Empty
+ * lines are skipped, except in a file of one column, where they are empty
+ * cells. Errors throw csv_error with the line number.
+ */
+
+#ifndef PHYS_UNITS_QUANTITY_IO_CSV_HPP_INCLUDED
+#define PHYS_UNITS_QUANTITY_IO_CSV_HPP_INCLUDED
+
+#include "phys/units/quantity_io_input.hpp"
+#include "phys/units/quantity_vector.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/// namespace phys.
+
+namespace phys {
+
+/// namespace units.
+
+namespace units {
+
+/// csv error, e.g. when a cell is not a number or a column has other dimensions than expected.
+
+struct csv_error : public quantity_error
+{
+    csv_error( std::string const text )
+        : quantity_error( text ) { }
+};
+
+/**
+ * \brief struct "csv_column" describes a column of a CSV file: its name, its unit
+ * and the unit's factor to SI units and dimensions.
+ */
+struct csv_column
+{
+    std::string name;
+    std::string unit;
+    detail::unit_value value;
+
+    /// factor from the column's unit to SI units.
+
+    long double factor() const { return value.factor; }
+
+    /// true if the column's unit has dimensions Dims.
+
+    template< typename Dims >
+    bool has_dimensions() const { return detail::has_dimensions<Dims>( value ); }
+};
+
+/// namespace detail.
+
+namespace detail {
+
+/**
+ * destination of the cells of a bound column.
+ */
+struct csv_sink
+{
+    virtual ~csv_sink() { }
+
+    /// make room for n rows.
+
+    virtual void resize( std::size_t n ) = 0;
+
+    /// parse the cell at [first, last) into row i; false if it is not a number.
+
+    virtual bool parse( std::size_t i, char const * first, char const * last ) = 0;
+};
+
+template< typename Dims, typename T >
+class csv_target : public csv_sink
+{
+public:
+    csv_target( quantity_vector<Dims, T> & v, long double const factor )
+    : m_v( v ), m_factor( static_cast<T>( factor ) ), m_scale( factor != 1 ) { }
+
+    void resize( std::size_t const n ) override { m_v.resize( n ); }
+
+    bool parse( std::size_t const i, char const * first, char const * last ) override
+    {
+        while ( first != last && *first == ' ' )
+            ++first;
+
+        while ( first != last && last[-1] == ' ' )
+            --last;
+
+        T value = std::numeric_limits<T>::quiet_NaN();
+
+        if ( first != last )
+        {
+            from_chars_result const result = parse_number( first, last, value );
+
+            if ( result.ec != std::errc() || result.ptr != last )
+                return false;
+        }
+
+        m_v.magnitudes()[i] = m_scale ? value * m_factor : value;
+        return true;
+    }
+
+private:
+    quantity_vector<Dims, T> & m_v;
+    T m_factor;
+    bool m_scale;
+};
+
+} // namespace detail
+
+/**
+ * \brief class "csv_reader" reads columns of a CSV or TSV file with units in
+ * the header into quantity_vectors, in chunks of rows.
+ */
+class csv_reader
+{
+public:
+    /**
+     * read the header from is; delimiter '\0' selects a tab if the header
+     * contains one, otherwise a comma. Throws csv_error for an unknown unit.
+     */
+    explicit csv_reader( std::istream & is, char const delimiter = '\0', std::size_t const buffer_size = std::size_t( 1 ) << 20 )
+    : m_is( is ), m_delimiter( delimiter ), m_buffer( std::max( buffer_size, std::size_t( 2 ) ) )
+    , m_begin( 0 ), m_end( 0 ), m_eof( false ), m_line( 0 ), m_columns(), m_sinks()
+    {
+        char const * first;
+        char const * last;
+
+        if ( !next_line( first, last ) )
+            throw csv_error( "csv: no header" );
+
+        if ( m_delimiter == '\0' )
+            m_delimiter = std::memchr( first, '\t', static_cast<std::size_t>( last - first ) ) ? '\t' : ',';
+
+        for ( ;; )
+        {
+            char const * const end = header_field_end( first, last );
+
+            m_columns.push_back( parse_header( first, end ) );
+
+            if ( end == last )
+                break;
+
+            first = end + 1;
+        }
+
+        m_sinks.resize( m_columns.size() );
+    }
+
+    csv_reader( csv_reader const & ) = delete;
+
+    csv_reader & operator=( csv_reader const & ) = delete;
+
+    /**
+     * number of columns.
+     */
+    std::size_t size() const { return m_columns.size(); }
+
+    /**
+     * description of column i.
+     */
+    csv_column const & column( std::size_t const i ) const { return m_columns.at( i ); }
+
+    /**
+     * index of the column with the given name; throws csv_error if there is none.
+     */
+    std::size_t find( std::string const & name ) const
+    {
+        for ( std::size_t i = 0; i < m_columns.size(); ++i )
+        {
+            if ( m_columns[i].name == name )
+                return i;
+        }
+        throw csv_error( "csv: no column '" + name + "'" );
+    }
+
+    /**
+     * read column i into v from now on; throws csv_error if the column's unit
+     * does not have dimensions Dims.
+     */
+    template< typename Dims, typename T >
+    void bind( std::size_t const i, quantity_vector<Dims, T> & v )
+    {
+        static_assert( std::is_floating_point<T>::value, "csv columns are read into floating-point magnitudes" );
+
+        csv_column const & c = column( i );
+
+        if ( !c.has_dimensions<Dims>() )
+            throw csv_error( "csv: column '" + c.name + "' has unit '" + c.unit + "', not of dimensions '" + unit_info<Dims>::symbol() + "'" );
+
+        m_sinks[i].reset( new detail::csv_target<Dims, T>( v, c.factor() ) );
+    }
+
+    /**
+     * read the column with the given name into v from now on.
+     */
+    template< typename Dims, typename T >
+    void bind( std::string const & name, quantity_vector<Dims, T> & v )
+    {
+        bind( find( name ), v );
+    }
+
+    /**
+     * read up to max_rows rows into the bound vectors, replacing their contents;
+     * returns the number of rows read, 0 at the end of the input.
+     * Throws csv_error if a row has too few or too many fields or a bound cell is not a number.
+     */
+    std::size_t read( std::size_t const max_rows )
+    {
+        for ( auto & sink : m_sinks )
+        {
+            if ( sink )
+                sink->resize( max_rows );
+        }
+
+        std::size_t rows = 0;
+        char const * first;
+        char const * last;
+
+        while ( rows < max_rows && next_line( first, last ) )
+        {
+            // an empty line is an empty cell in a file of one column, else skipped.
+
+            if ( first == last && m_columns.size() > 1 )
+                continue;
+
+            for ( std::size_t i = 0; ; ++i )
+            {
+                char const * const end = field_end( first, last );
+
+                if ( m_sinks[i] && !m_sinks[i]->parse( rows, first, end ) )
+                    fail( "column '" + m_columns[i].name + "': not a number '" + std::string( first, end ) + "'" );
+
+                if ( i + 1 == m_columns.size() )
+                {
+                    if ( end != last )
+                        fail( "too many fields" );
+                    break;
+                }
+
+                if ( end == last )
+                    fail( "too few fields" );
+
+                first = end + 1;
+            }
+            ++rows;
+        }
+
+        for ( auto & sink : m_sinks )
+        {
+            if ( sink )
+                sink->resize( rows );
+        }
+        return rows;
+    }
+
+    /**
+     * number of the line read last, the header being line 1.
+     */
+    std::size_t line() const { return m_line; }
+
+private:
+    char const * field_end( char const * first, char const * last ) const
+    {
+        char const * const end = static_cast<char const *>( std::memchr( first, m_delimiter, static_cast<std::size_t>( last - first ) ) );
+        return end ? end : last;
+    }
+
+    /**
+     * end of the header field at first, skipping delimiters between double quotes.
+     */
+    char const * header_field_end( char const * first, char const * last ) const
+    {
+        bool quoted = false;
+
+        for ( ; first != last; ++first )
+        {
+            if ( *first == '"' )
+                quoted = !quoted;
+            else if ( *first == m_delimiter && !quoted )
+                break;
+        }
+        return first;
+    }
+
+    /**
+     * the next line without line end; false at the end of the input.
+     * The line stays valid until the next call.
+     */
+    bool next_line( char const * & first, char const * & last )
+    {
+        for ( ;; )
+        {
+            char * const begin = m_buffer.data() + m_begin;
+            char * const newline = static_cast<char *>( std::memchr( begin, '\n', m_end - m_begin ) );
+
+            if ( newline || ( m_eof && m_begin != m_end ) )
+            {
+                first = begin;
+                last  = newline ? newline : m_buffer.data() + m_end;
+
+                m_begin = newline ? static_cast<std::size_t>( newline - m_buffer.data() ) + 1 : m_end;
+                ++m_line;
+
+                if ( last != first && last[-1] == '\r' )
+                    --last;
+
+                return true;
+            }
+
+            if ( m_eof )
+                return false;
+
+            // keep the partial line, and grow the buffer if it fills the buffer.
+
+            std::memmove( m_buffer.data(), begin, m_end - m_begin );
+            m_end  -= m_begin;
+            m_begin = 0;
+
+            if ( m_end == m_buffer.size() )
+                m_buffer.resize( 2 * m_buffer.size() );
+
+            m_is.read( m_buffer.data() + m_end, static_cast<std::streamsize>( m_buffer.size() - m_end ) );
+            m_end += static_cast<std::size_t>( m_is.gcount() );
+            m_eof  = !m_is;
+        }
+    }
+
+    /**
+     * column from a header field such as "speed [km/h]".
+     */
+    csv_column parse_header( char const * first, char const * last ) const
+    {
+        while ( first != last && *first == ' ' )
+            ++first;
+
+        while ( first != last && last[-1] == ' ' )
+            --last;
+
+        if ( last - first >= 2 && *first == '"' && last[-1] == '"' )
+        {
+            ++first;
+            --last;
+        }
+
+        csv_column result = { std::string(), std::string(), { 1, { 0, 0, 0, 0, 0, 0, 0 } } };
+
+        char const * const open = static_cast<char const *>( std::memchr( first, '[', static_cast<std::size_t>( last - first ) ) );
+
+        if ( open == nullptr || last[-1] != ']' )
+        {
+            result.name.assign( first, last );
+            return result;
+        }
+
+        char const * name_end = open;
+
+        while ( name_end != first && name_end[-1] == ' ' )
+            --name_end;
+
+        result.name.assign( first, name_end );
+        result.unit.assign( open + 1, last - 1 );
+
+        if ( !result.unit.empty() )
+        {
+            char const * const unit_last = result.unit.data() + result.unit.size();
+
+            from_chars_result const parsed = detail::parse_unit( result.unit.data(), unit_last, result.value );
+
+            if ( parsed.ec != std::errc() || parsed.ptr != unit_last )
+                fail( "column '" + result.name + "': unknown unit '" + result.unit + "'" );
+        }
+        return result;
+    }
+
+    void fail( std::string const & text ) const
+    {
+        throw csv_error( "csv: line " + std::to_string( m_line ) + ": " + text );
+    }
+
+private:
+    std::istream & m_is;
+    char m_delimiter;
+    std::vector<char> m_buffer;
+    std::size_t m_begin;
+    std::size_t m_end;
+    bool m_eof;
+    std::size_t m_line;
+    std::vector<csv_column> m_columns;
+    std::vector< std::unique_ptr<detail::csv_sink> > m_sinks;
+};
+
+}} // namespace phys::units
+
+#endif // PHYS_UNITS_QUANTITY_IO_CSV_HPP_INCLUDED
+
+/*
+ * end of file
+ */
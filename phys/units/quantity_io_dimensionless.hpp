@@ -26,9 +26,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< dimensionless_d >
 {
-    static bool        single() { return true; }
-    static std::string name()   { return "(dimensionless)"; }
-    static std::string symbol() { return "[]"; }
+    static constexpr bool         single()   { return true; }
+    static constexpr char const * c_name()   { return "(dimensionless)"; }
+    static constexpr char const * c_symbol() { return "[]"; }
+    static std::string            name()     { return c_name(); }
+    static std::string            symbol()   { return c_symbol(); }
 };
 
 }} // namespace phys::units
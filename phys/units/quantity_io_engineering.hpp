@@ -26,9 +26,10 @@
 #include "phys/units/quantity_io.hpp"
 
 #include <cmath>
-#include <iomanip>
+#include <cstdio>
+#include <cstring>
 #include <limits>
-#include <sstream>
+#include <string>
 
 /*
  * Note: micro, , may not work everywhere, so you can define a glyph yourself:
@@ -90,59 +91,211 @@ inline int precision( double const scaled, int const digits )
     return iszero( scaled ) ? digits - 1 : digits - std::log10( std::abs( scaled ) ) - 2 * std::numeric_limits<double>::epsilon();
 }
 
-inline std::string prefix_or_exponent( bool const exponential, int const degree )
+/// powers of 1000 for degrees -8..8, as used for scaling.
+
+constexpr double degree_factor[] =
 {
-    return std::string( exponential || 0 == degree ? "" : " " ) + prefixes[ exponential ][ sign(degree) > 0 ][ std::abs( degree ) ];
-}
+    1e24, 1e21, 1e18, 1e15, 1e12, 1e9, 1e6, 1e3, 1e0, 1e-3, 1e-6, 1e-9, 1e-12, 1e-15, 1e-18, 1e-21, 1e-24,
+};
+
+/// powers of ten, 10^0..10^7.
+
+constexpr double decimal_factor[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, };
 
-inline std::string exponent( int const degree )
+/// true if x is within a relative 1e-9 of limit, where log10() based rounding may go either way.
+
+inline bool near( double const x, double const limit )
 {
-    std::ostringstream os;
-    os << "e" << 3 * degree;
-    return os.str();
+    return std::abs( x - limit ) <= 1e-9 * limit;
 }
 
-inline std::string bracket( std::string const unit )
+/**
+ * degree_of(), found by comparison; uses log10() close to a power of 1000.
+ */
+inline int fast_degree_of( double const value )
 {
-	return std::string::npos != unit.find_first_of( "+- " ) ? "(" + unit + ")" : unit;
-}
+    double const magnitude = std::abs( value );
 
-} // anonymous namespace
+    if ( iszero( value ) || !( magnitude >= 1e-24 && magnitude < 1e27 ) )
+        return degree_of( value );
+
+    int degree = -8;
+
+    while ( degree < 8 && magnitude >= degree_factor[ 7 - degree ] )
+        ++degree;
+
+    double const upper = degree < 8 ? degree_factor[ 7 - degree ] : 1e27;
+
+    if ( near( magnitude, degree_factor[ 8 - degree ] ) || near( magnitude, upper ) )
+        return degree_of( value );
+
+    return degree;
+}
 
 /**
- * convert real number to prefixed or exponential notation, optionally followed by a unit.
+ * precision(), found by comparison; uses log10() close to a power of 10.
  */
-inline std::string
-to_engineering_string( double const value, int const digits = 3, bool exponential = false, bool const showpos = false, std::string const unit = "" )
+inline int fast_precision( double const scaled, int const digits )
 {
-    using namespace detail;
+    double const magnitude = std::abs( scaled );
 
-    if      ( std::isnan( value ) ) return "NaN";
-    else if ( std::isinf( value ) ) return "INFINITE";
+    if ( iszero( scaled ) || !( magnitude > 1 && magnitude < 1000 ) ||
+        near( magnitude, 1 ) || near( magnitude, 10 ) || near( magnitude, 100 ) || near( magnitude, 1000 ) )
+        return precision( scaled, digits );
 
-    const int degree = degree_of( value );
+    int const intdigits = magnitude < 10 ? 1 : magnitude < 100 ? 2 : 3;
 
-    std::string factor;
+    // precision() truncates towards zero.
+    return digits >= intdigits ? digits - intdigits : digits - intdigits + 1;
+}
+
+/**
+ * write scaled with the given number of decimals like std::fixed does,
+ * negative precision meaning six; returns the length or -1 if it does not fit.
+ * Rounds via integers, unless close to halfway between two outcomes.
+ */
+inline int format_fixed( char * text, std::size_t const size, double const scaled, int precision, bool const showpos )
+{
+    if ( precision < 0 )
+        precision = 6;
 
-    if ( std::abs( degree ) < prefix_count )
+    double const magnitude = std::abs( scaled );
+
+    if ( precision < 8 && magnitude < 1e8 )
     {
-        factor = prefix_or_exponent( exponential, degree );
+        double const y = magnitude * decimal_factor[ precision ];
+        double const r = std::floor( y );
+
+        if ( y < 1e8 && std::abs( y - r - 0.5 ) > 1e-7 )
+        {
+            unsigned long mantissa = static_cast<unsigned long>( y - r > 0.5 ? r + 1 : r );
+
+            char digits[32];
+            int n = 0;
+
+            for ( ; mantissa != 0 || n <= precision; mantissa /= 10 )
+            {
+                if ( n == precision && precision > 0 )
+                    digits[n++] = '.';
+
+                digits[n++] = static_cast<char>( '0' + mantissa % 10 );
+            }
+
+            bool const has_sign = std::signbit( scaled ) || showpos;
+
+            if ( std::size_t( n + has_sign ) > size )
+                return -1;
+
+            int length = 0;
+
+            if ( has_sign )
+                text[length++] = std::signbit( scaled ) ? '-' : '+';
+
+            while ( n > 0 )
+                text[length++] = digits[--n];
+
+            return length;
+        }
     }
+
+    int const length = std::snprintf( text, size, showpos ? "%+.*f" : "%.*f", precision, scaled );
+
+    return length >= 0 && std::size_t( length ) < size ? length : -1;
+}
+
+/// append text to [first, last), or return nullptr if it does not fit.
+
+inline char * append( char * first, char * last, char const * text, std::size_t const length )
+{
+    if ( first == nullptr || length > std::size_t( last - first ) )
+        return nullptr;
+
+    std::memcpy( first, text, length );
+    return first + length;
+}
+
+inline char * append( char * first, char * last, char const * text )
+{
+    return append( first, last, text, std::strlen( text ) );
+}
+
+} // anonymous namespace
+
+/**
+ * write real number to [first, last) in prefixed or exponential notation,
+ * optionally followed by a unit; produces the same text as to_engineering_string().
+ * Returns std::errc::value_too_large if the text does not fit.
+ */
+inline to_chars_result
+to_engineering_chars( char * first, char * last, double const value, int const digits = 3, bool exponential = false, bool const showpos = false, char const * const unit = "" )
+{
+    using namespace detail;
+
+    char * p = first;
+
+    if      ( std::isnan( value ) ) p = append( p, last, "NaN" );
+    else if ( std::isinf( value ) ) p = append( p, last, "INFINITE" );
     else
     {
-        exponential = true;
-        factor = exponent( degree );
+        int const degree = fast_degree_of( value );
+
+        char   factor[16] = " ";
+        char * factor_end = factor;
+
+        if ( std::abs( degree ) < prefix_count )
+        {
+            char const * const prefix = prefixes[ exponential ][ sign(degree) > 0 ][ std::abs( degree ) ];
+
+            factor_end = append( factor + ( exponential || 0 == degree ? 0 : 1 ), factor + sizeof factor, prefix );
+        }
+        else
+        {
+            exponential = true;
+            factor[0] = 'e';
+            factor_end = factor + 1 + format_fixed( factor + 1, sizeof factor - 1, 3 * degree, 0, false );
+        }
+
+        double const scaled = value * ( std::abs( degree ) < prefix_count ? degree_factor[ 8 + degree ] : std::pow( 1000.0, -degree ) );
+
+        int const length = format_fixed( p, last - p, scaled, fast_precision( scaled, digits ), showpos );
+
+        p = length < 0 ? nullptr : append( p + length, last, factor, factor_end - factor );
+
+        if ( *unit != '\0' )
+        {
+            bool const bracketed = nullptr != std::strpbrk( unit, "+- " );
+
+            if ( 0 == degree || exponential )
+                p = append( p, last, " " );
+
+            p = bracketed ? append( append( append( p, last, "(" ), last, unit ), last, ")" ) : append( p, last, unit );
+        }
     }
 
-    std::ostringstream os;
+    return p == nullptr ? to_chars_result{ last, std::errc::value_too_large } : to_chars_result{ p, std::errc() };
+}
 
-    const double scaled = value * std::pow( 1000.0, -degree );
+/**
+ * convert real number to prefixed or exponential notation, optionally followed by a unit.
+ */
+inline std::string
+to_engineering_string( double const value, int const digits = 3, bool exponential = false, bool const showpos = false, std::string const unit = "" )
+{
+    std::string text( 64 + ( digits > 0 ? digits : 0 ) + unit.size(), '\0' );
 
-    const std::string space = ( 0 == degree || exponential ) && unit.length() ? " ":"";
+    to_chars_result const result = to_engineering_chars( &text[0], &text[0] + text.size(), value, digits, exponential, showpos, unit.c_str() );
 
-    os << std::fixed << (showpos ? std::showpos : std::noshowpos) << std::setprecision( precision(scaled, digits) ) << scaled << factor << space << bracket( unit );
+    text.resize( result.ptr - &text[0] );
+    return text;
+}
 
-    return os.str();
+/**
+ * write quantity to [first, last) in engineering notation, see io::eng::to_string().
+ */
+template< typename Dims, typename T >
+to_chars_result to_engineering_chars( char * first, char * last, quantity<Dims, T> const & q, int const digits = 3, bool const exponential = false, bool const showpos = false )
+{
+    return to_engineering_chars( first, last, q.magnitude(), digits, exponential, showpos, detail::symbol_text<Dims>() );
 }
 
 namespace io {
@@ -151,13 +304,19 @@ namespace eng {
 template< typename Dims, typename T >
 std::string to_string( quantity<Dims, T> const & q, int const digits = 3, bool const exponential = false, bool const showpos = false )
 {
-   return to_engineering_string( q.magnitude(), digits, exponential, showpos, to_unit_symbol( q ) );
+   return to_engineering_string( q.magnitude(), digits, exponential, showpos, detail::symbol_text<Dims>() );
 }
 
 template< typename Dims, typename T >
 inline std::ostream & operator<<( std::ostream & os, quantity< Dims, T > const & q )
 {
-   return os << to_string( q );
+   char text[128];
+
+   to_chars_result const result = to_engineering_chars( text, text + sizeof text, q );
+
+   // stream as a string, so that the stream's width, fill and adjustment apply.
+
+   return result.ec == std::errc() ? os << std::string( text, result.ptr ) : os << to_string( q );
 }
 
 } // namespace eng
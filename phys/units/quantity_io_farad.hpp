@@ -26,9 +26,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< capacitance_d >
 {
-    static bool        single() { return true; }
-    static std::string name()   { return "farad"; }
-    static std::string symbol() { return "F"; }
+    static constexpr bool         single()   { return true; }
+    static constexpr char const * c_name()   { return "farad"; }
+    static constexpr char const * c_symbol() { return "F"; }
+    static std::string            name()     { return c_name(); }
+    static std::string            symbol()   { return c_symbol(); }
 };
 
 namespace literals {
@@ -26,9 +26,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< absorbed_dose_d >
 {
-    static bool        single() { return true; }
-    static std::string name()   { return "gray"; }
-    static std::string symbol() { return "Gy"; }
+    static constexpr bool         single()   { return true; }
+    static constexpr char const * c_name()   { return "gray"; }
+    static constexpr char const * c_symbol() { return "Gy"; }
+    static std::string            name()     { return c_name(); }
+    static std::string            symbol()   { return c_symbol(); }
 };
 
 namespace literals {
@@ -26,9 +26,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< inductance_d >
 {
-    static bool        single() { return true; }
-    static std::string name()   { return "henry"; }
-    static std::string symbol() { return "H"; }
+    static constexpr bool         single()   { return true; }
+    static constexpr char const * c_name()   { return "henry"; }
+    static constexpr char const * c_symbol() { return "H"; }
+    static std::string            name()     { return c_name(); }
+    static std::string            symbol()   { return c_symbol(); }
 };
 
 namespace literals {
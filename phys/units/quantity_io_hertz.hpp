@@ -26,9 +26,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< frequency_d >
 {
-   static bool        single() { return true; }
-   static std::string name()   { return "hertz"; }
-   static std::string symbol() { return "Hz"; }
+   static constexpr bool         single()   { return true; }
+   static constexpr char const * c_name()   { return "hertz"; }
+   static constexpr char const * c_symbol() { return "Hz"; }
+   static std::string            name()     { return c_name(); }
+   static std::string            symbol()   { return c_symbol(); }
 };
 
 namespace literals {
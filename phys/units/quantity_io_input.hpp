@@ -0,0 +1,603 @@
+/**
+ * \file quantity_io_input.hpp
+ *
+ * \brief   Allocation-free parsing of quantities from text.
+ * \author  Martin Moene
+ * \date    16 October 2026
+ * \since   1.2
+ *
+ * This code is provided as-is, with no warrantee of correctness.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+/*
+ * from_chars() reads a number, optionally followed by spaces and a unit,
+ * e.g. "12.5 km/h", "9.81 m s-2", "3 kg.m/s^2" or "1e-3 mOhm", and checks
+ * the dimensions of the unit against those of the target quantity.
+ *
+ * Units consist of terms separated by a space, '*', '.' or '/'. A term is a
+ * symbol, optionally preceded by an SI prefix (see prefix()) and followed by
+ * an integer exponent: "m2", "m+2", "m^2", "s-1", "s^-1". A '/' applies to
+ * the term that follows it only, so that "J/kg K" reads as J kg-1 K. This
+ * accepts the output of unit_info<>::symbol() as well as the named symbols
+ * of the quantity_io_*.hpp files, plus min, h, d and L.
+ *
+ * Like std::from_chars(), parsing stops at the first character that does not
+ * fit, and ptr of the result points there. Errors are reported via ec:
+ * - std::errc::invalid_argument: no number, or an unknown or malformed unit,
+ * - std::errc::argument_out_of_domain: the unit has the wrong dimensions,
+ * - std::errc::result_out_of_range: the value does not fit the magnitude type.
+ * The quantity is only modified on success.
+ *
+ * Numbers are converted exactly without library calls where possible
+ * (Clinger's fast path); others are passed to strtod() and friends, with
+ * the decimal point adapted to the current C locale, so that numbers read
+ * the same in every locale.
+ */
+
+#ifndef PHYS_UNITS_QUANTITY_IO_INPUT_HPP_INCLUDED
+#define PHYS_UNITS_QUANTITY_IO_INPUT_HPP_INCLUDED
+
+#include "phys/units/quantity_io.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <clocale>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <system_error>
+
+/// namespace phys.
+
+namespace phys {
+
+/// namespace units.
+
+namespace units {
+
+/**
+ * result of from_chars(): one past the last character parsed and error code.
+ */
+struct from_chars_result
+{
+    char const * ptr;
+    std::errc    ec;
+};
+
+/// namespace detail.
+
+namespace detail {
+
+/**
+ * unit as read from text: factor with respect to the SI base units and
+ * exponents of the seven base dimensions.
+ */
+struct unit_value
+{
+    long double factor;
+    int         dims[7];
+};
+
+/**
+ * unit symbol, its factor and dimensions.
+ */
+struct unit_entry
+{
+    char const * symbol;
+    std::size_t  length;
+    bool         prefixable;
+    long double  factor;
+    signed char  dims[7];
+};
+
+/**
+ * perfect hash: maps each of the unit symbols to its own slot in unit_table.
+ */
+constexpr std::size_t unit_hash( char const * text, std::size_t length )
+{
+    return ( ( static_cast<unsigned char>( text[0] ) +
+        2u * ( length > 1 ? static_cast<unsigned char>( text[1] ) : 0u ) + 13u * length ) * 11u >> 3 ) & 63u;
+}
+
+constexpr unit_entry unit_table[64] =
+{
+    { "Ohm", 3, true ,     1, {  2,  1, -3, -2, 0, 0, 0 } },  //  0
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  //  1
+    { "lx",  2, true ,     1, { -2,  0,  0,  0, 0, 0, 1 } },  //  2
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  //  3
+    { "S",   1, true ,     1, { -2, -1,  3,  2, 0, 0, 0 } },  //  4
+    { "T",   1, true ,     1, {  0,  1, -2, -1, 0, 0, 0 } },  //  5
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  //  6
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  //  7
+    { "V",   1, true ,     1, {  2,  1, -3, -1, 0, 0, 0 } },  //  8
+    { "W",   1, true ,     1, {  2,  1, -3,  0, 0, 0, 0 } },  //  9
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 10
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 11
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 12
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 13
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 14
+    { "\xCE\xA9", 2, true, 1, {  2,  1, -3, -2, 0, 0, 0 } },  // 15, Ohm as UTF-8 capital omega
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 16
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 17
+    { "Gy",  2, true ,     1, {  2,  0, -2,  0, 0, 0, 0 } },  // 18
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 19
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 20
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 21
+    { "Hz",  2, true ,     1, {  0,  0, -1,  0, 0, 0, 0 } },  // 22
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 23
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 24
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 25
+    { "Sv",  2, true ,     1, {  2,  0, -2,  0, 0, 0, 0 } },  // 26
+    { "d",   1, false, 86400, {  0,  0,  1,  0, 0, 0, 0 } },  // 27
+    { "Pa",  2, true ,     1, { -1,  1, -2,  0, 0, 0, 0 } },  // 28
+    { "rad", 3, true ,     1, {  0,  0,  0,  0, 0, 0, 0 } },  // 29
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 30
+    { "g",   1, true ,  1e-3L, { 0,  1,  0,  0, 0, 0, 0 } },  // 31
+    { "h",   1, false,  3600, {  0,  0,  1,  0, 0, 0, 0 } },  // 32
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 33
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 34
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 35
+    { "lm",  2, true ,     1, {  0,  0,  0,  0, 0, 0, 1 } },  // 36
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 37
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 38
+    { "m",   1, true ,     1, {  1,  0,  0,  0, 0, 0, 0 } },  // 39
+    { "Wb",  2, true ,     1, {  2,  1, -2, -1, 0, 0, 0 } },  // 40
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 41
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 42
+    { "A",   1, true ,     1, {  0,  0,  0,  1, 0, 0, 0 } },  // 43
+    { "min", 3, false,    60, {  0,  0,  1,  0, 0, 0, 0 } },  // 44
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 45
+    { "C",   1, true ,     1, {  0,  0,  1,  1, 0, 0, 0 } },  // 46
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 47
+    { "s",   1, true ,     1, {  0,  0,  1,  0, 0, 0, 0 } },  // 48
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 49
+    { "F",   1, true ,     1, { -2, -1,  4,  2, 0, 0, 0 } },  // 50
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 51
+    { "H",   1, true ,     1, {  2,  1, -2, -2, 0, 0, 0 } },  // 52
+    { "Bq",  2, true ,     1, {  0,  0, -1,  0, 0, 0, 0 } },  // 53
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 54
+    { "J",   1, true ,     1, {  2,  1, -2,  0, 0, 0, 0 } },  // 55
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 56
+    { "K",   1, true ,     1, {  0,  0,  0,  0, 1, 0, 0 } },  // 57
+    { "L",   1, true ,  1e-3L, { 3,  0,  0,  0, 0, 0, 0 } },  // 58
+    { "sr",  2, true ,     1, {  0,  0,  0,  0, 0, 0, 0 } },  // 59
+    { "mol", 3, true ,     1, {  0,  0,  0,  0, 0, 1, 0 } },  // 60
+    { "N",   1, true ,     1, {  1,  1, -2,  0, 0, 0, 0 } },  // 61
+    { "cd",  2, true ,     1, {  0,  0,  0,  0, 0, 0, 1 } },  // 62
+    { "",    0, false,     0, {  0,  0,  0,  0, 0, 0, 0 } },  // 63
+};
+
+constexpr bool equal_n( char const * x, char const * y, std::size_t n )
+{
+    return n == 0 || ( *x == *y && equal_n( x + 1, y + 1, n - 1 ) );
+}
+
+/// the table entry for the given unit symbol, or nullptr if the symbol is unrecognized.
+
+inline unit_entry const * find_unit( char const * text, std::size_t length )
+{
+    unit_entry const & entry = unit_table[ unit_hash( text, length ) ];
+
+    return entry.length == length && equal_n( entry.symbol, text, length ) ? &entry : nullptr;
+}
+
+/// looks up the symbols of unit_table; parse_unit() accepts other lookups, see unit_registry.
+
+struct si_unit_lookup
+{
+    unit_entry const * operator()( char const * text, std::size_t length ) const
+    {
+        return find_unit( text, length );
+    }
+};
+
+/// the entry for a prefixed unit symbol such as "km", with the prefix of the given length.
+
+template< typename Lookup = si_unit_lookup >
+unit_entry const * find_prefixed_unit( char const * text, std::size_t length, std::size_t prefix_length, long double & factor, Lookup const & lookup = Lookup() )
+{
+    if ( length <= prefix_length )
+        return nullptr;
+
+    prefix_entry const * const pfx  = find_prefix( text, prefix_length );
+    unit_entry   const * const unit = pfx != nullptr ? lookup( text + prefix_length, length - prefix_length ) : nullptr;
+
+    if ( unit == nullptr || !unit->prefixable )
+        return nullptr;
+
+    factor = pfx->factor;
+    return unit;
+}
+
+constexpr bool is_digit( char c ) { return '0' <= c && c <= '9'; }
+
+/// true for the characters of unit symbols: ASCII letters and UTF-8 sequences.
+
+constexpr bool is_unit_char( char c )
+{
+    return ( 'a' <= c && c <= 'z' ) || ( 'A' <= c && c <= 'Z' ) || static_cast<unsigned char>( c ) >= 0x80;
+}
+
+// exactly representable powers of ten, see max_exact_pow10().
+
+constexpr long double pow10_table[] =
+{
+    1e0L,  1e1L,  1e2L,  1e3L,  1e4L,  1e5L,  1e6L,  1e7L,  1e8L,  1e9L,
+    1e10L, 1e11L, 1e12L, 1e13L, 1e14L, 1e15L, 1e16L, 1e17L, 1e18L, 1e19L,
+    1e20L, 1e21L, 1e22L, 1e23L, 1e24L, 1e25L, 1e26L, 1e27L,
+};
+
+/// largest n for which 10^n is exact in a floating point type with the given number of mantissa bits.
+
+constexpr int max_exact_pow10( int digits )
+{
+    return digits >= 64 ? 27 : digits >= 53 ? 22 : digits >= 24 ? 10 : -1;
+}
+
+/// largest integer that is exact in a floating point type with the given number of mantissa bits.
+
+constexpr std::uint64_t max_exact_mantissa( int digits )
+{
+    return digits >= 64 ? ~std::uint64_t( 0 ) : std::uint64_t( 1 ) << digits;
+}
+
+inline float       strto( char const * text, char ** end, float       ) { return std::strtof ( text, end ); }
+inline double      strto( char const * text, char ** end, double      ) { return std::strtod ( text, end ); }
+inline long double strto( char const * text, char ** end, long double ) { return std::strtold( text, end ); }
+
+/**
+ * parse a number with strtod() and friends, independent of the C locale; uses
+ * a copy on the stack, as these functions require a terminating null character.
+ */
+template< typename T >
+from_chars_result parse_number_slow( char const * first, char const * last, T & value )
+{
+    if ( first == last || *first == ' ' || *first == '\t' )
+        return { first, std::errc::invalid_argument };
+
+    char buffer[64];
+    std::size_t point;
+    std::size_t extra;
+
+    bool const complete = copy_for_strto( first, last, buffer, sizeof buffer - 1, point, extra );
+
+    char * end = nullptr;
+    errno = 0;
+    T result = strto( buffer, &end, T() );
+
+    std::size_t used = end - buffer;
+
+    if ( !complete && buffer[used] == '\0' )
+    {
+        // exceptionally long number.
+        std::string copy( static_cast<std::size_t>( last - first ) + std::strlen( std::localeconv()->decimal_point ), '\0' );
+        copy_for_strto( first, last, &copy[0], copy.size() - 1, point, extra );
+        errno = 0;
+        result = strto( copy.c_str(), &end, T() );
+        used = end - copy.c_str();
+    }
+
+    if ( used > point )
+        used -= extra;
+
+    if ( used == 0 )
+        return { first, std::errc::invalid_argument };
+
+    // subnormal results are representable, although strtod() reports ERANGE.
+    if ( errno == ERANGE && ( result == 0 || std::isinf( result ) ) )
+        return { first + used, std::errc::result_out_of_range };
+
+    value = result;
+    return { first + used, std::errc() };
+}
+
+/**
+ * parse a floating point number: [+-]digits[.digits][(e|E)[+-]digits].
+ * Numbers with at most 19 significant digits and a small exponent are
+ * converted exactly by a single multiplication or division (Clinger);
+ * other input, including inf and nan, is handed to parse_number_slow().
+ */
+template< typename T >
+from_chars_result parse_number( char const * first, char const * last, T & value )
+{
+    char const * p = first;
+
+    bool const negative = p != last && *p == '-';
+
+    if ( p != last && ( *p == '-' || *p == '+' ) )
+        ++p;
+
+    std::uint64_t mantissa = 0;
+    int ndigits  = 0;
+    int exponent = 0;
+
+    for ( ; p != last && is_digit( *p ); ++p, ++ndigits )
+    {
+        mantissa = 10 * mantissa + ( *p - '0' );
+    }
+
+    if ( p != last && *p == '.' )
+    {
+        for ( ++p; p != last && is_digit( *p ); ++p, ++ndigits, --exponent )
+        {
+            mantissa = 10 * mantissa + ( *p - '0' );
+        }
+    }
+
+    if ( ndigits == 0 || ndigits > 19 )
+        return parse_number_slow( first, last, value );
+
+    if ( p != last && ( *p == 'e' || *p == 'E' ) )
+    {
+        char const * q = p + 1;
+
+        bool const exp_negative = q != last && *q == '-';
+
+        if ( q != last && ( *q == '-' || *q == '+' ) )
+            ++q;
+
+        // without digits, the 'e' is not part of the number.
+        if ( q != last && is_digit( *q ) )
+        {
+            int exp = 0;
+            for ( ; q != last && is_digit( *q ); ++q )
+            {
+                if ( exp > 9999 )
+                    return parse_number_slow( first, last, value );
+
+                exp = 10 * exp + ( *q - '0' );
+            }
+            exponent += exp_negative ? -exp : exp;
+            p = q;
+        }
+    }
+
+    int const digits = std::numeric_limits<T>::digits;
+
+    if ( mantissa > max_exact_mantissa( digits ) ||
+        exponent < -max_exact_pow10( digits ) || exponent > max_exact_pow10( digits ) )
+    {
+        return parse_number_slow( first, last, value );
+    }
+
+    T const result = exponent < 0 ?
+        static_cast<T>( mantissa ) / static_cast<T>( pow10_table[ -exponent ] ) :
+        static_cast<T>( mantissa ) * static_cast<T>( pow10_table[  exponent ] ) ;
+
+    value = negative ? -result : result;
+    return { p, std::errc() };
+}
+
+/// x to the power n.
+
+inline long double int_power( long double x, int n )
+{
+    long double result = 1;
+
+    for ( int i = n < 0 ? -n : n; i > 0; --i )
+        result *= x;
+
+    return n < 0 ? 1 / result : result;
+}
+
+/**
+ * parse a single unit term at [first, last): prefix, symbol and exponent;
+ * accumulate it into unit, inverted for divide. Returns the end of the term,
+ * or nullptr if there is no valid term. Symbols are looked up with lookup.
+ */
+template< typename Lookup = si_unit_lookup >
+char const * parse_unit_term( char const * first, char const * last, bool divide, unit_value & unit, Lookup const & lookup = Lookup() )
+{
+    char const * p = first;
+
+    while ( p != last && is_unit_char( *p ) )
+        ++p;
+
+    std::size_t const length = p - first;
+
+    if ( length == 0 )
+        return nullptr;
+
+    long double factor = 1;
+
+    unit_entry const * entry = lookup( first, length );
+
+    if ( entry == nullptr )
+        entry = find_prefixed_unit( first, length, 1, factor, lookup );
+
+    if ( entry == nullptr )
+        entry = find_prefixed_unit( first, length, 2, factor, lookup );
+
+    if ( entry == nullptr )
+        return nullptr;
+
+    // exponent: [^][+-]digits
+
+    int exponent = 1;
+
+    char const * q = p;
+
+    bool const caret = q != last && *q == '^';
+
+    if ( caret )
+        ++q;
+
+    bool const negative = q != last && *q == '-';
+
+    if ( q != last && ( *q == '-' || *q == '+' ) )
+        ++q;
+
+    if ( q != last && is_digit( *q ) )
+    {
+        exponent = 0;
+        for ( ; q != last && is_digit( *q ); ++q )
+        {
+            if ( exponent > 99 )
+                return nullptr;
+
+            exponent = 10 * exponent + ( *q - '0' );
+        }
+        exponent = negative ? -exponent : exponent;
+        p = q;
+    }
+    else if ( caret )
+    {
+        return nullptr;
+    }
+
+    if ( divide )
+        exponent = -exponent;
+
+    long double const scale = factor * entry->factor;
+
+    if ( scale != 1 )
+        unit.factor *= exponent == 1 ? scale : int_power( scale, exponent );
+
+    for ( int i = 0; i < 7; ++i )
+        unit.dims[i] += exponent * entry->dims[i];
+
+    return p;
+}
+
+/**
+ * parse a unit such as "km/h" or "kg m2 s-2" at [first, last) into unit.
+ * A term after a space is optional: parsing stops before the space if no
+ * valid term follows. Terms after '*', '.' or '/' are mandatory.
+ */
+template< typename Lookup = si_unit_lookup >
+from_chars_result parse_unit( char const * first, char const * last, unit_value & unit, Lookup const & lookup = Lookup() )
+{
+    unit_value result = { 1, { 0, 0, 0, 0, 0, 0, 0 } };
+
+    char const * p = parse_unit_term( first, last, false, result, lookup );
+
+    if ( p == nullptr )
+        return { first, std::errc::invalid_argument };
+
+    for ( ;; )
+    {
+        char const * q = p;
+
+        while ( q != last && *q == ' ' )
+            ++q;
+
+        bool divide   = false;
+        bool required = false;
+
+        if ( q != last && ( *q == '/' || *q == '*' || *q == '.' ) )
+        {
+            divide   = *q == '/';
+            required = true;
+
+            for ( ++q; q != last && *q == ' '; )
+                ++q;
+        }
+        else if ( q == p )
+        {
+            break;
+        }
+
+        char const * const end = parse_unit_term( q, last, divide, result, lookup );
+
+        if ( end == nullptr )
+        {
+            if ( required )
+                return { q, std::errc::invalid_argument };
+            break;
+        }
+
+        p = end;
+    }
+
+    unit = result;
+    return { p, std::errc() };
+}
+
+/// true if the unit has dimensions Dims.
+
+template< typename Dims >
+inline bool has_dimensions( unit_value const & unit )
+{
+    return unit.dims[0] == Dims::dim1 && unit.dims[1] == Dims::dim2 && unit.dims[2] == Dims::dim3 &&
+           unit.dims[3] == Dims::dim4 && unit.dims[4] == Dims::dim5 && unit.dims[5] == Dims::dim6 &&
+           unit.dims[6] == Dims::dim7;
+}
+
+/**
+ * parse a number, optionally followed by spaces and a unit, into the magnitude
+ * in SI units and the unit's dimensions; on error, magnitude and unit are unspecified.
+ */
+template< typename T >
+from_chars_result parse_quantity( char const * first, char const * last, T & magnitude, unit_value & unit )
+{
+    T value = T();
+
+    from_chars_result const number = parse_number( first, last, value );
+
+    if ( number.ec != std::errc() )
+        return number;
+
+    unit = { 1, { 0, 0, 0, 0, 0, 0, 0 } };
+
+    char const * p = number.ptr;
+    char const * s = p;
+
+    while ( s != last && *s == ' ' )
+        ++s;
+
+    if ( s != last && is_unit_char( *s ) )
+    {
+        from_chars_result const result = parse_unit( s, last, unit );
+
+        if ( result.ec != std::errc() )
+            return result;
+
+        p = result.ptr;
+    }
+
+    magnitude = unit.factor == 1 ? value : static_cast<T>( value * unit.factor );
+
+    if ( std::isinf( magnitude ) && !std::isinf( value ) )
+        return { p, std::errc::result_out_of_range };
+
+    return { p, std::errc() };
+}
+
+} // namespace detail
+
+/**
+ * parse quantity from text at [first, last), e.g. "12.5 km/h".
+ */
+template< typename Dims, typename T >
+from_chars_result from_chars( char const * first, char const * last, quantity<Dims, T> & q )
+{
+    T magnitude = T();
+    detail::unit_value unit;
+
+    from_chars_result const result = detail::parse_quantity( first, last, magnitude, unit );
+
+    if ( result.ec != std::errc() )
+        return result;
+
+    if ( !detail::has_dimensions<Dims>( unit ) )
+        return { result.ptr, std::errc::argument_out_of_domain };
+
+    q = quantity<Dims, T>( detail::magnitude_tag, magnitude );
+
+    return result;
+}
+
+}} // namespace phys::units
+
+#endif // PHYS_UNITS_QUANTITY_IO_INPUT_HPP_INCLUDED
+
+/*
+ * end of file
+ */
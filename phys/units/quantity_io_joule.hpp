@@ -26,9 +26,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< energy_d >
 {
-    static bool        single() { return true; }
-    static std::string name()   { return "joule"; }
-    static std::string symbol() { return "J"; }
+    static constexpr bool         single()   { return true; }
+    static constexpr char const * c_name()   { return "joule"; }
+    static constexpr char const * c_symbol() { return "J"; }
+    static std::string            name()     { return c_name(); }
+    static std::string            symbol()   { return c_symbol(); }
 };
 
 namespace literals {
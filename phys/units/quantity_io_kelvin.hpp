@@ -25,9 +25,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< thermodynamic_temperature_d >
 {
-    static bool        single() { return true; }
-    static std::string name()   { return "kelvin"; }
-    static std::string symbol() { return "K"; }
+    static constexpr bool         single()   { return true; }
+    static constexpr char const * c_name()   { return "kelvin"; }
+    static constexpr char const * c_symbol() { return "K"; }
+    static std::string            name()     { return c_name(); }
+    static std::string            symbol()   { return c_symbol(); }
 };
 
 }} // namespace phys::units
@@ -25,9 +25,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< mass_d >
 {
-   static bool        single() { return true; }
-   static std::string name()   { return "kilogram"; }
-   static std::string symbol() { return "kg"; }
+   static constexpr bool         single()   { return true; }
+   static constexpr char const * c_name()   { return "kilogram"; }
+   static constexpr char const * c_symbol() { return "kg"; }
+   static std::string            name()     { return c_name(); }
+   static std::string            symbol()   { return c_symbol(); }
 };
 
 }} // namespace phys::units
@@ -26,9 +26,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< luminous_flux_d >
 {
-    static bool        single() { return true; }
-    static std::string name()   { return "lumen"; }
-    static std::string symbol() { return "lm"; }
+    static constexpr bool         single()   { return true; }
+    static constexpr char const * c_name()   { return "lumen"; }
+    static constexpr char const * c_symbol() { return "lm"; }
+    static std::string            name()     { return c_name(); }
+    static std::string            symbol()   { return c_symbol(); }
 };
 
 namespace literals {
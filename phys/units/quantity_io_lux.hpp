@@ -26,9 +26,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< illuminance_d >
 {
-    static bool        single() { return true; }
-    static std::string name()   { return "lux"; }
-    static std::string symbol() { return "lx"; }
+    static constexpr bool         single()   { return true; }
+    static constexpr char const * c_name()   { return "lux"; }
+    static constexpr char const * c_symbol() { return "lx"; }
+    static std::string            name()     { return c_name(); }
+    static std::string            symbol()   { return c_symbol(); }
 };
 
 namespace literals {
@@ -25,9 +25,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< length_d >
 {
-   static bool        single() { return true; }
-   static std::string name()   { return "meter"; }
-   static std::string symbol() { return "m"; }
+   static constexpr bool         single()   { return true; }
+   static constexpr char const * c_name()   { return "meter"; }
+   static constexpr char const * c_symbol() { return "m"; }
+   static std::string            name()     { return c_name(); }
+   static std::string            symbol()   { return c_symbol(); }
 };
 
 }} // namespace phys::units
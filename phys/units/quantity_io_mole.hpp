@@ -25,9 +25,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< amount_of_substance_d >
 {
-   static bool        single() { return true; }
-   static std::string name()   { return "mole"; }
-   static std::string symbol() { return "mol"; }
+   static constexpr bool         single()   { return true; }
+   static constexpr char const * c_name()   { return "mole"; }
+   static constexpr char const * c_symbol() { return "mol"; }
+   static std::string            name()     { return c_name(); }
+   static std::string            symbol()   { return c_symbol(); }
 };
 
 }} // namespace phys::units
@@ -26,9 +26,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< force_d >
 {
-    static bool        single() { return true; }
-    static std::string name()   { return "newton"; }
-    static std::string symbol() { return "N"; }
+    static constexpr bool         single()   { return true; }
+    static constexpr char const * c_name()   { return "newton"; }
+    static constexpr char const * c_symbol() { return "N"; }
+    static std::string            name()     { return c_name(); }
+    static std::string            symbol()   { return c_symbol(); }
 };
 
 namespace literals {
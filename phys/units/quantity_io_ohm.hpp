@@ -26,9 +26,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< electric_resistance_d >
 {
-    static bool        single() { return true; }
-    static std::string name()   { return "ohm"; }
-    static std::string symbol() { return "Ohm"; }
+    static constexpr bool         single()   { return true; }
+    static constexpr char const * c_name()   { return "ohm"; }
+    static constexpr char const * c_symbol() { return "Ohm"; }
+    static std::string            name()     { return c_name(); }
+    static std::string            symbol()   { return c_symbol(); }
 };
 
 namespace literals {
@@ -26,9 +26,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< pressure_d >
 {
-    static bool        single() { return true; }
-    static std::string name()   { return "pascal"; }
-    static std::string symbol() { return "Pa"; }
+    static constexpr bool         single()   { return true; }
+    static constexpr char const * c_name()   { return "pascal"; }
+    static constexpr char const * c_symbol() { return "Pa"; }
+    static std::string            name()     { return c_name(); }
+    static std::string            symbol()   { return c_symbol(); }
 };
 
 namespace literals {
@@ -25,9 +25,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< time_interval_d >
 {
-   static bool        single() { return true; }
-   static std::string name()   { return "second"; }
-   static std::string symbol() { return "s"; }
+   static constexpr bool         single()   { return true; }
+   static constexpr char const * c_name()   { return "second"; }
+   static constexpr char const * c_symbol() { return "s"; }
+   static std::string            name()     { return c_name(); }
+   static std::string            symbol()   { return c_symbol(); }
 };
 
 namespace literals {
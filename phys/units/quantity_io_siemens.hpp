@@ -26,9 +26,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< electric_conductance_d >
 {
-    static bool        single() { return true; }
-    static std::string name()   { return "siemens"; }
-    static std::string symbol() { return "S"; }
+    static constexpr bool         single()   { return true; }
+    static constexpr char const * c_name()   { return "siemens"; }
+    static constexpr char const * c_symbol() { return "S"; }
+    static std::string            name()     { return c_name(); }
+    static std::string            symbol()   { return c_symbol(); }
 };
 
 namespace literals {
@@ -26,9 +26,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< dose_equivalent_d >
 {
-    static bool        single() { return true; }
-    static std::string name()   { return "sievert"; }
-    static std::string symbol() { return "Sv"; }
+    static constexpr bool         single()   { return true; }
+    static constexpr char const * c_name()   { return "sievert"; }
+    static constexpr char const * c_symbol() { return "Sv"; }
+    static std::string            name()     { return c_name(); }
+    static std::string            symbol()   { return c_symbol(); }
 };
 
 namespace literals {
@@ -26,9 +26,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< speed_d >
 {
-    static bool        single() { return true; }
-    static std::string name()   { return "Meter per second"; }
-    static std::string symbol() { return "m/s"; }
+    static constexpr bool         single()   { return true; }
+    static constexpr char const * c_name()   { return "Meter per second"; }
+    static constexpr char const * c_symbol() { return "m/s"; }
+    static std::string            name()     { return c_name(); }
+    static std::string            symbol()   { return c_symbol(); }
 };
 
 namespace literals {
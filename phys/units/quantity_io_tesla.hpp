@@ -26,9 +26,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< magnetic_flux_density_d >
 {
-    static bool        single() { return true; }
-    static std::string name()   { return "tesla"; }
-    static std::string symbol() { return "T"; }
+    static constexpr bool         single()   { return true; }
+    static constexpr char const * c_name()   { return "tesla"; }
+    static constexpr char const * c_symbol() { return "T"; }
+    static std::string            name()     { return c_name(); }
+    static std::string            symbol()   { return c_symbol(); }
 };
 
 namespace literals {
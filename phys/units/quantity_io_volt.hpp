@@ -26,9 +26,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< electric_potential_d >
 {
-    static bool        single() { return true; }
-    static std::string name()   { return "volt"; }
-    static std::string symbol() { return "V"; }
+    static constexpr bool         single()   { return true; }
+    static constexpr char const * c_name()   { return "volt"; }
+    static constexpr char const * c_symbol() { return "V"; }
+    static std::string            name()     { return c_name(); }
+    static std::string            symbol()   { return c_symbol(); }
 };
 
 namespace literals {
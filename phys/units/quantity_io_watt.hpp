@@ -26,9 +26,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< power_d >
 {
-   static bool        single() { return true; }
-   static std::string name()   { return "watt"; }
-   static std::string symbol() { return "W"; }
+   static constexpr bool         single()   { return true; }
+   static constexpr char const * c_name()   { return "watt"; }
+   static constexpr char const * c_symbol() { return "W"; }
+   static std::string            name()     { return c_name(); }
+   static std::string            symbol()   { return c_symbol(); }
 };
 
 namespace literals {
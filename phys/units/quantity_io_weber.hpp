@@ -26,9 +26,11 @@ namespace phys { namespace units {
 template<>
 struct unit_info< magnetic_flux_d >
 {
-    static bool        single() { return true; }
-    static std::string name()   { return "weber"; }
-    static std::string symbol() { return "Wb"; }
+    static constexpr bool         single()   { return true; }
+    static constexpr char const * c_name()   { return "weber"; }
+    static constexpr char const * c_symbol() { return "Wb"; }
+    static std::string            name()     { return c_name(); }
+    static std::string            symbol()   { return c_symbol(); }
 };
 
 namespace literals {
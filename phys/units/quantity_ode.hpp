@@ -0,0 +1,649 @@
+/**
+ * \file quantity_ode.hpp
+ *
+ * \brief   Integrators of ordinary differential equations over quantity states: RK4, adaptive RK45 and velocity Verlet.
+ * \author  Martin Moene
+ * \date    16 October 2026
+ * \since   1.2
+ *
+ * This code is provided as-is, with no warrantee of correctness.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+/*
+ * The state of a system is a quantity, a quantity_vec, a quantity_vector, or
+ * a std::tuple of these, e.g. std::tuple< quantity<length_d>, quantity<speed_d> >.
+ * Its derivative with respect to the independent variable, a quantity<time_interval_d>
+ * by default, has the type state_derivative<State, Time>::type, derived with
+ * detail::Quotient: the derivative of the tuple above is a tuple of a speed
+ * and an acceleration. A system writes the derivative of state y at t into
+ * dydt, as
+ *
+ *   void sys( State const & y, Derivative & dydt, Time t );
+ *
+ * so that a mix-up of the components does not compile.
+ *
+ * rk4 takes fixed steps of the classical fourth-order Runge-Kutta method,
+ * rk45 adaptive steps of the Dormand-Prince 5(4) method with an absolute
+ * tolerance in the units of the state and a relative tolerance, and
+ * velocity_verlet fixed steps of the symplectic velocity Verlet method for
+ * second-order systems x'' = a(x, t), which keeps the energy of conservative
+ * systems bounded over long times.
+ *
+ * The steppers hold their stage derivatives and intermediate states as
+ * members: a stepper over quantities or quantity_vecs does not allocate, one
+ * over quantity_vectors sizes its workspace at the first step and reuses it.
+ * A state of quantity_vectors integrates many independent systems of the
+ * same form at once, one per element: each stage is a loop over the
+ * magnitudes that the compiler vectorizes, so that the systems run in the
+ * lanes of SIMD registers. rk45 then takes the step size of the system that
+ * needs the smallest step.
+ */
+
+#ifndef PHYS_UNITS_QUANTITY_ODE_HPP_INCLUDED
+#define PHYS_UNITS_QUANTITY_ODE_HPP_INCLUDED
+
+#include "phys/units/quantity.hpp"
+#include "phys/units/quantity_vec.hpp"
+#include "phys/units/quantity_vector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+
+/// namespace phys.
+
+namespace phys {
+
+/// namespace units.
+
+namespace units {
+
+/// ode error, e.g. when the step size of an adaptive integrator underflows.
+
+struct ode_error : public std::runtime_error
+{
+    ode_error( std::string const text )
+        : std::runtime_error( text ) { }
+};
+
+/**
+ * \brief The "state_derivative" template gives the type of the derivative of
+ * a state of type State with respect to an independent variable of type Time.
+ */
+template< typename State, typename Time >
+struct state_derivative;
+
+template< typename D, typename T, typename DT, typename U >
+struct state_derivative< quantity<D, T>, quantity<DT, U> >
+{
+    typedef detail::Quotient<D, DT, T, U> type;
+};
+
+template< typename D, typename T, std::size_t N, typename DT, typename U >
+struct state_derivative< quantity_vec<D, T, N>, quantity<DT, U> >
+{
+    typedef quantity_vec< detail::quotient_dimensions<D, DT>, detail::PromoteMul<T, U>, N > type;
+};
+
+template< typename D, typename T, typename DT, typename U >
+struct state_derivative< quantity_vector<D, T>, quantity<DT, U> >
+{
+    typedef quantity_vector< detail::quotient_dimensions<D, DT>, detail::PromoteMul<T, U> > type;
+};
+
+template< typename... S, typename Time >
+struct state_derivative< std::tuple<S...>, Time >
+{
+    typedef std::tuple< typename state_derivative<S, Time>::type... > type;
+};
+
+/**
+ * \brief The "state_tolerance" template gives the type of the absolute tolerance
+ * of a state of type State: a quantity for each quantity, quantity_vec or quantity_vector.
+ */
+template< typename State >
+struct state_tolerance;
+
+template< typename D, typename T >
+struct state_tolerance< quantity<D, T> >
+{
+    typedef quantity<D, T> type;
+};
+
+template< typename D, typename T, std::size_t N >
+struct state_tolerance< quantity_vec<D, T, N> >
+{
+    typedef quantity<D, T> type;
+};
+
+template< typename D, typename T >
+struct state_tolerance< quantity_vector<D, T> >
+{
+    typedef quantity<D, T> type;
+};
+
+template< typename... S >
+struct state_tolerance< std::tuple<S...> >
+{
+    typedef std::tuple< typename state_tolerance<S>::type... > type;
+};
+
+/// namespace detail.
+
+namespace detail {
+
+template< std::size_t... I >
+struct index_list {};
+
+template< std::size_t N, std::size_t... I >
+struct make_index_list : make_index_list< N - 1, N - 1, I... > {};
+
+template< std::size_t... I >
+struct make_index_list< 0, I... >
+{
+    typedef index_list< I... > type;
+};
+
+template< typename... T >
+using IndexListFor = typename make_index_list< sizeof...( T ) >::type;
+
+// The element-wise operations of the steppers; those on tuples apply the
+// ones on the elements, and must therefore be declared after them.
+
+/// size y like x; only quantity_vectors have a size.
+
+template< typename Y, typename X >
+void ode_resize( Y &, X const & ) { }
+
+template< typename D, typename T, typename X >
+void ode_resize( quantity_vector<D, T> & y, X const & x )
+{
+    y.resize( x.size() );
+}
+
+/// y = x + k * h.
+
+template< typename Y, typename K, typename H >
+void ode_axpy( Y & y, Y const & x, K const & k, H const & h )
+{
+    y = x + k * h;
+}
+
+template< typename D, typename T, typename DK, typename K, typename H >
+void ode_axpy( quantity_vector<D, T> & y, quantity_vector<D, T> const & x, quantity_vector<DK, K> const & k, H const & h )
+{
+    T       * const py = y.magnitudes();
+    T const * const px = x.magnitudes();
+    K const * const pk = k.magnitudes();
+    auto      const c  = h.magnitude();
+
+    for ( std::size_t i = 0; i < y.size(); ++i )
+        py[i] = px[i] + pk[i] * c;
+}
+
+/// y += k1 * h1 + k2 * h2 + k3 * h3 + k4 * h4, in one pass.
+
+template< typename Y, typename K, typename H >
+void ode_axpy4( Y & y, K const & k1, H const & h1, K const & k2, H const & h2, K const & k3, H const & h3, K const & k4, H const & h4 )
+{
+    y = y + ( k1 * h1 + k2 * h2 + k3 * h3 + k4 * h4 );
+}
+
+template< typename D, typename T, typename DK, typename K, typename H >
+void ode_axpy4( quantity_vector<D, T> & y,
+    quantity_vector<DK, K> const & k1, H const & h1, quantity_vector<DK, K> const & k2, H const & h2,
+    quantity_vector<DK, K> const & k3, H const & h3, quantity_vector<DK, K> const & k4, H const & h4 )
+{
+    T       * const py  = y.magnitudes();
+    K const * const pk1 = k1.magnitudes();
+    K const * const pk2 = k2.magnitudes();
+    K const * const pk3 = k3.magnitudes();
+    K const * const pk4 = k4.magnitudes();
+    auto      const c1  = h1.magnitude();
+    auto      const c2  = h2.magnitude();
+    auto      const c3  = h3.magnitude();
+    auto      const c4  = h4.magnitude();
+
+    for ( std::size_t i = 0; i < y.size(); ++i )
+        py[i] += pk1[i] * c1 + pk2[i] * c2 + pk3[i] * c3 + pk4[i] * c4;
+}
+
+/// y = k * h.
+
+template< typename Y, typename K, typename H >
+void ode_scale( Y & y, K const & k, H const & h )
+{
+    y = k * h;
+}
+
+template< typename D, typename T, typename DK, typename K, typename H >
+void ode_scale( quantity_vector<D, T> & y, quantity_vector<DK, K> const & k, H const & h )
+{
+    T       * const py = y.magnitudes();
+    K const * const pk = k.magnitudes();
+    auto      const c  = h.magnitude();
+
+    for ( std::size_t i = 0; i < y.size(); ++i )
+        py[i] = pk[i] * c;
+}
+
+/// the ratio of error e to the tolerance atol + rtol * max( |y0|, |y1| ), at most 1 for an acceptable error.
+
+template< typename T >
+double ode_ratio( T const e, T const y0, T const y1, T const atol, double const rtol )
+{
+    using std::abs;
+
+    return static_cast<double>( abs( e ) / ( atol + rtol * std::max( abs( y0 ), abs( y1 ) ) ) );
+}
+
+template< typename D, typename T >
+double ode_error_ratio( quantity<D, T> const & e, quantity<D, T> const & y0, quantity<D, T> const & y1, quantity<D, T> const & atol, double const rtol )
+{
+    return ode_ratio( e.magnitude(), y0.magnitude(), y1.magnitude(), atol.magnitude(), rtol );
+}
+
+template< typename D, typename T, std::size_t N >
+double ode_error_ratio( quantity_vec<D, T, N> const & e, quantity_vec<D, T, N> const & y0, quantity_vec<D, T, N> const & y1, quantity<D, T> const & atol, double const rtol )
+{
+    double result = 0;
+
+    for ( std::size_t i = 0; i < N; ++i )
+        result = std::max( result, ode_ratio( e.magnitudes()[i], y0.magnitudes()[i], y1.magnitudes()[i], atol.magnitude(), rtol ) );
+
+    return result;
+}
+
+template< typename D, typename T >
+double ode_error_ratio( quantity_vector<D, T> const & e, quantity_vector<D, T> const & y0, quantity_vector<D, T> const & y1, quantity<D, T> const & atol, double const rtol )
+{
+    double result = 0;
+
+    for ( std::size_t i = 0; i < e.size(); ++i )
+        result = std::max( result, ode_ratio( e.magnitudes()[i], y0.magnitudes()[i], y1.magnitudes()[i], atol.magnitude(), rtol ) );
+
+    return result;
+}
+
+// tuples.
+
+template< std::size_t... I, typename... Y, typename X >
+void ode_resize( index_list<I...>, std::tuple<Y...> & y, X const & x )
+{
+    int const expand[] = { 0, ( ode_resize( std::get<I>( y ), std::get<I>( x ) ), 0 )... };
+    (void) expand;
+}
+
+template< typename... Y, typename... X >
+void ode_resize( std::tuple<Y...> & y, std::tuple<X...> const & x )
+{
+    ode_resize( IndexListFor<Y...>(), y, x );
+}
+
+template< std::size_t... I, typename... Y, typename... K, typename H >
+void ode_axpy( index_list<I...>, std::tuple<Y...> & y, std::tuple<Y...> const & x, std::tuple<K...> const & k, H const & h )
+{
+    int const expand[] = { 0, ( ode_axpy( std::get<I>( y ), std::get<I>( x ), std::get<I>( k ), h ), 0 )... };
+    (void) expand;
+}
+
+template< typename... Y, typename... K, typename H >
+void ode_axpy( std::tuple<Y...> & y, std::tuple<Y...> const & x, std::tuple<K...> const & k, H const & h )
+{
+    ode_axpy( IndexListFor<Y...>(), y, x, k, h );
+}
+
+template< std::size_t... I, typename... Y, typename... K, typename H >
+void ode_axpy4( index_list<I...>, std::tuple<Y...> & y,
+    std::tuple<K...> const & k1, H const & h1, std::tuple<K...> const & k2, H const & h2,
+    std::tuple<K...> const & k3, H const & h3, std::tuple<K...> const & k4, H const & h4 )
+{
+    int const expand[] = { 0, ( ode_axpy4( std::get<I>( y ),
+        std::get<I>( k1 ), h1, std::get<I>( k2 ), h2, std::get<I>( k3 ), h3, std::get<I>( k4 ), h4 ), 0 )... };
+    (void) expand;
+}
+
+template< typename... Y, typename... K, typename H >
+void ode_axpy4( std::tuple<Y...> & y,
+    std::tuple<K...> const & k1, H const & h1, std::tuple<K...> const & k2, H const & h2,
+    std::tuple<K...> const & k3, H const & h3, std::tuple<K...> const & k4, H const & h4 )
+{
+    ode_axpy4( IndexListFor<Y...>(), y, k1, h1, k2, h2, k3, h3, k4, h4 );
+}
+
+template< std::size_t... I, typename... Y, typename... K, typename H >
+void ode_scale( index_list<I...>, std::tuple<Y...> & y, std::tuple<K...> const & k, H const & h )
+{
+    int const expand[] = { 0, ( ode_scale( std::get<I>( y ), std::get<I>( k ), h ), 0 )... };
+    (void) expand;
+}
+
+template< typename... Y, typename... K, typename H >
+void ode_scale( std::tuple<Y...> & y, std::tuple<K...> const & k, H const & h )
+{
+    ode_scale( IndexListFor<Y...>(), y, k, h );
+}
+
+template< std::size_t... I, typename... Y, typename... A >
+double ode_error_ratio( index_list<I...>, std::tuple<Y...> const & e, std::tuple<Y...> const & y0, std::tuple<Y...> const & y1, std::tuple<A...> const & atol, double const rtol )
+{
+    double const ratios[] = { 0.0, ode_error_ratio( std::get<I>( e ), std::get<I>( y0 ), std::get<I>( y1 ), std::get<I>( atol ), rtol )... };
+
+    return *std::max_element( ratios, ratios + sizeof ratios / sizeof *ratios );
+}
+
+template< typename... Y, typename... A >
+double ode_error_ratio( std::tuple<Y...> const & e, std::tuple<Y...> const & y0, std::tuple<Y...> const & y1, std::tuple<A...> const & atol, double const rtol )
+{
+    return ode_error_ratio( IndexListFor<Y...>(), e, y0, y1, atol, rtol );
+}
+
+/// number of equal steps of at most dt from t to t_end.
+
+template< typename Time >
+std::size_t ode_steps( Time const & t, Time const & t_end, Time const & dt )
+{
+    double const r = static_cast<double>( ( t_end - t ).magnitude() / dt.magnitude() );
+
+    return r > 0 ? static_cast<std::size_t>( std::ceil( r - 1e-9 ) ) : 0;
+}
+
+} // namespace detail
+
+/**
+ * \brief class "rk4" integrates State with fixed steps of the classical
+ * fourth-order Runge-Kutta method.
+ */
+template< typename State, typename Time = quantity<time_interval_d> >
+class rk4
+{
+public:
+    typedef State state_type;
+
+    typedef Time time_type;
+
+    typedef typename state_derivative<State, Time>::type deriv_type;
+
+    rk4() : m_k1(), m_k2(), m_k3(), m_k4(), m_y() { }
+
+    /**
+     * advance y from t to t + dt.
+     */
+    template< typename System >
+    void do_step( System && sys, state_type & y, time_type const t, time_type const dt )
+    {
+        resize( y );
+
+        time_type const half = dt * 0.5;
+
+        sys( y, m_k1, t );
+        detail::ode_axpy( m_y, y, m_k1, half );
+        sys( m_y, m_k2, t + half );
+        detail::ode_axpy( m_y, y, m_k2, half );
+        sys( m_y, m_k3, t + half );
+        detail::ode_axpy( m_y, y, m_k3, dt );
+        sys( m_y, m_k4, t + dt );
+
+        time_type const sixth = dt / 6.0;
+        time_type const third = dt / 3.0;
+
+        detail::ode_axpy4( y, m_k1, sixth, m_k2, third, m_k3, third, m_k4, sixth );
+    }
+
+    /**
+     * advance y from t to t_end in equal steps of at most dt; returns the number of steps.
+     */
+    template< typename System >
+    std::size_t integrate( System && sys, state_type & y, time_type const t, time_type const t_end, time_type const dt )
+    {
+        std::size_t const n = detail::ode_steps( t, t_end, dt );
+        time_type   const h = n ? ( t_end - t ) / static_cast<double>( n ) : dt;
+
+        for ( std::size_t i = 0; i < n; ++i )
+            do_step( sys, y, t + h * static_cast<double>( i ), h );
+
+        return n;
+    }
+
+private:
+    void resize( state_type const & y )
+    {
+        detail::ode_resize( m_k1, y );
+        detail::ode_resize( m_k2, y );
+        detail::ode_resize( m_k3, y );
+        detail::ode_resize( m_k4, y );
+        detail::ode_resize( m_y , y );
+    }
+
+private:
+    deriv_type m_k1, m_k2, m_k3, m_k4;
+    state_type m_y;
+};
+
+/**
+ * \brief class "rk45" integrates State with adaptive steps of the Dormand-Prince
+ * 5(4) Runge-Kutta method; the error estimate of a step must stay within
+ * atol + rtol * |y| for each component.
+ */
+template< typename State, typename Time = quantity<time_interval_d> >
+class rk45
+{
+public:
+    typedef State state_type;
+
+    typedef Time time_type;
+
+    typedef typename state_derivative<State, Time>::type deriv_type;
+
+    typedef typename state_tolerance<State>::type tolerance_type;
+
+    /**
+     * absolute tolerance atol in the units of the state, and relative tolerance rtol.
+     */
+    rk45( tolerance_type const & atol, double const rtol )
+    : m_atol( atol ), m_rtol( rtol ), m_k1(), m_k2(), m_k3(), m_k4(), m_k5(), m_k6(), m_k7(), m_y(), m_e() { }
+
+    /**
+     * try to advance y from t by dt. If the error is within the tolerance, advance y
+     * and t and return true, otherwise leave them and return false. Either way set
+     * dt to the step size to use next. Throws ode_error if the step size underflows.
+     */
+    template< typename System >
+    bool try_step( System && sys, state_type & y, time_type & t, time_type & dt )
+    {
+        if ( t + dt == t )
+            throw ode_error( "rk45: step size underflow" );
+
+        resize( y );
+
+        time_type const h = dt;
+
+        sys( y, m_k1, t );
+
+        detail::ode_axpy( m_y, y, m_k1, h * ( 1.0 / 5 ) );
+        sys( m_y, m_k2, t + h * ( 1.0 / 5 ) );
+
+        detail::ode_axpy( m_y, y, m_k1, h * ( 3.0 / 40 ) );
+        detail::ode_axpy( m_y, m_y, m_k2, h * ( 9.0 / 40 ) );
+        sys( m_y, m_k3, t + h * ( 3.0 / 10 ) );
+
+        detail::ode_axpy( m_y, y, m_k1, h * ( 44.0 / 45 ) );
+        detail::ode_axpy( m_y, m_y, m_k2, h * ( -56.0 / 15 ) );
+        detail::ode_axpy( m_y, m_y, m_k3, h * ( 32.0 / 9 ) );
+        sys( m_y, m_k4, t + h * ( 4.0 / 5 ) );
+
+        detail::ode_axpy( m_y, y, m_k1, h * ( 19372.0 / 6561 ) );
+        detail::ode_axpy( m_y, m_y, m_k2, h * ( -25360.0 / 2187 ) );
+        detail::ode_axpy( m_y, m_y, m_k3, h * ( 64448.0 / 6561 ) );
+        detail::ode_axpy( m_y, m_y, m_k4, h * ( -212.0 / 729 ) );
+        sys( m_y, m_k5, t + h * ( 8.0 / 9 ) );
+
+        detail::ode_axpy( m_y, y, m_k1, h * ( 9017.0 / 3168 ) );
+        detail::ode_axpy( m_y, m_y, m_k2, h * ( -355.0 / 33 ) );
+        detail::ode_axpy( m_y, m_y, m_k3, h * ( 46732.0 / 5247 ) );
+        detail::ode_axpy( m_y, m_y, m_k4, h * ( 49.0 / 176 ) );
+        detail::ode_axpy( m_y, m_y, m_k5, h * ( -5103.0 / 18656 ) );
+        sys( m_y, m_k6, t + h );
+
+        // fifth-order solution, and the derivative there for the error estimate.
+
+        detail::ode_axpy( m_y, y, m_k1, h * ( 35.0 / 384 ) );
+        detail::ode_axpy( m_y, m_y, m_k3, h * ( 500.0 / 1113 ) );
+        detail::ode_axpy( m_y, m_y, m_k4, h * ( 125.0 / 192 ) );
+        detail::ode_axpy( m_y, m_y, m_k5, h * ( -2187.0 / 6784 ) );
+        detail::ode_axpy( m_y, m_y, m_k6, h * ( 11.0 / 84 ) );
+        sys( m_y, m_k7, t + h );
+
+        // difference of the fifth- and fourth-order solutions.
+
+        detail::ode_scale( m_e, m_k1, h * ( 71.0 / 57600 ) );
+        detail::ode_axpy( m_e, m_e, m_k3, h * ( -71.0 / 16695 ) );
+        detail::ode_axpy( m_e, m_e, m_k4, h * ( 71.0 / 1920 ) );
+        detail::ode_axpy( m_e, m_e, m_k5, h * ( -17253.0 / 339200 ) );
+        detail::ode_axpy( m_e, m_e, m_k6, h * ( 22.0 / 525 ) );
+        detail::ode_axpy( m_e, m_e, m_k7, h * ( -1.0 / 40 ) );
+
+        double const ratio = detail::ode_error_ratio( m_e, y, m_y, m_atol, m_rtol );
+        bool   const accept = ratio <= 1;
+
+        // grow or shrink the step as the error ratio goes with h^5.
+
+        double const factor = ratio > 0 ? 0.9 * std::pow( ratio, -0.2 ) : 5.0;
+
+        dt = h * std::min( std::max( factor, 0.2 ), accept ? 5.0 : 0.9 );
+
+        if ( accept )
+        {
+            using std::swap;
+            swap( y, m_y );
+            t = t + h;
+        }
+        return accept;
+    }
+
+    /**
+     * advance y from t to t_end, starting with step size dt; returns the number of accepted steps.
+     */
+    template< typename System >
+    std::size_t integrate( System && sys, state_type & y, time_type t, time_type const t_end, time_type dt )
+    {
+        std::size_t steps = 0;
+
+        while ( t < t_end )
+        {
+            bool const last = !( t + dt < t_end );
+            time_type h = last ? t_end - t : dt;
+
+            if ( try_step( sys, y, t, h ) )
+            {
+                ++steps;
+
+                if ( last )
+                    break;
+            }
+            dt = h;
+        }
+        return steps;
+    }
+
+private:
+    void resize( state_type const & y )
+    {
+        detail::ode_resize( m_k1, y );
+        detail::ode_resize( m_k2, y );
+        detail::ode_resize( m_k3, y );
+        detail::ode_resize( m_k4, y );
+        detail::ode_resize( m_k5, y );
+        detail::ode_resize( m_k6, y );
+        detail::ode_resize( m_k7, y );
+        detail::ode_resize( m_y , y );
+        detail::ode_resize( m_e , y );
+    }
+
+private:
+    tolerance_type m_atol;
+    double m_rtol;
+    deriv_type m_k1, m_k2, m_k3, m_k4, m_k5, m_k6, m_k7;
+    state_type m_y, m_e;
+};
+
+/**
+ * \brief class "velocity_verlet" integrates a second-order system x'' = a(x, t)
+ * with fixed steps of the symplectic velocity Verlet method. The acceleration
+ * is written by a function a( x, acc, t ).
+ */
+template< typename Position, typename Time = quantity<time_interval_d> >
+class velocity_verlet
+{
+public:
+    typedef Position position_type;
+
+    typedef Time time_type;
+
+    typedef typename state_derivative<Position, Time>::type velocity_type;
+
+    typedef typename state_derivative<velocity_type, Time>::type acceleration_type;
+
+    velocity_verlet() : m_a(), m_valid( false ) { }
+
+    /**
+     * forget the acceleration kept from the previous step; call when x was changed
+     * other than by do_step().
+     */
+    void reset() { m_valid = false; }
+
+    /**
+     * advance x and v from t to t + dt.
+     */
+    template< typename Acceleration >
+    void do_step( Acceleration && acc, position_type & x, velocity_type & v, time_type const t, time_type const dt )
+    {
+        if ( !m_valid )
+        {
+            detail::ode_resize( m_a, x );
+            acc( x, m_a, t );
+            m_valid = true;
+        }
+
+        time_type const half = dt * 0.5;
+
+        detail::ode_axpy( v, v, m_a, half );
+        detail::ode_axpy( x, x, v, dt );
+        acc( x, m_a, t + dt );
+        detail::ode_axpy( v, v, m_a, half );
+    }
+
+    /**
+     * advance x and v from t to t_end in equal steps of at most dt; returns the number of steps.
+     */
+    template< typename Acceleration >
+    std::size_t integrate( Acceleration && acc, position_type & x, velocity_type & v, time_type const t, time_type const t_end, time_type const dt )
+    {
+        std::size_t const n = detail::ode_steps( t, t_end, dt );
+        time_type   const h = n ? ( t_end - t ) / static_cast<double>( n ) : dt;
+
+        for ( std::size_t i = 0; i < n; ++i )
+            do_step( acc, x, v, t + h * static_cast<double>( i ), h );
+
+        return n;
+    }
+
+private:
+    acceleration_type m_a;
+    bool m_valid;
+};
+
+}} // namespace phys::units
+
+#endif // PHYS_UNITS_QUANTITY_ODE_HPP_INCLUDED
+
+/*
+ * end of file
+ */
@@ -0,0 +1,401 @@
+/**
+ * \file quantity_point.hpp
+ *
+ * \brief   Points on affine scales such as degree Celsius and Fahrenheit, as opposed to differences.
+ * \author  Martin Moene
+ * \date    16 October 2026
+ * \since   1.2
+ *
+ * This code is provided as-is, with no warrantee of correctness.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+/*
+ * A temperature of 20 degree Celsius is a point on the Celsius scale, 293.15 K;
+ * a temperature difference of 20 degree Celsius is 20 K. quantity<> models
+ * differences: degree_celsius in quantity.hpp and degree_fahrenheit in
+ * other_units.hpp are units of temperature difference.
+ *
+ * A quantity_point<Origin, T> is a point on the scale Origin, which gives its
+ * dimensions, the size of its unit in SI units (scale) and the SI value of
+ * its zero (offset), both as std::ratio. Its magnitude is in the units of
+ * the scale: celsius_point<> t( detail::magnitude_tag, 20 ) is 20 degree
+ * Celsius. Following the rules of affine spaces,
+ *
+ *   point - point       gives a difference, a quantity in SI units,
+ *   point +- difference gives a point,
+ *   point + point       does not compile.
+ *
+ * A conversion between scales, x * ( S1 / S2 ) + ( O1 - O2 ) / S2, takes
+ * one multiply-add: the factor and the term are computed exactly from the
+ * rationals at compile time and rounded once. convert_points() converts
+ * arrays of raw magnitudes, such as samples of temperature sensors, in a
+ * loop that the compiler vectorizes.
+ */
+
+#ifndef PHYS_UNITS_QUANTITY_POINT_HPP_INCLUDED
+#define PHYS_UNITS_QUANTITY_POINT_HPP_INCLUDED
+
+#include "phys/units/quantity.hpp"
+
+#include <cstddef>
+#include <ratio>
+#include <type_traits>
+
+/// namespace phys.
+
+namespace phys {
+
+/// namespace units.
+
+namespace units {
+
+/// namespace origins: affine scales, with the size of their unit and their zero in SI units.
+
+namespace origins {
+
+struct kelvin
+{
+    typedef thermodynamic_temperature_d dimension_type;
+    typedef std::ratio<     1      > scale;
+    typedef std::ratio<     0      > offset;
+};
+
+struct celsius
+{
+    typedef thermodynamic_temperature_d dimension_type;
+    typedef std::ratio<     1      > scale;
+    typedef std::ratio< 27315, 100 > offset;
+};
+
+struct fahrenheit
+{
+    typedef thermodynamic_temperature_d dimension_type;
+    typedef std::ratio<     5,   9 > scale;
+    typedef std::ratio< 45967, 180 > offset;
+};
+
+struct rankine
+{
+    typedef thermodynamic_temperature_d dimension_type;
+    typedef std::ratio<     5,   9 > scale;
+    typedef std::ratio<     0      > offset;
+};
+
+} // namespace origins
+
+/// namespace detail.
+
+namespace detail {
+
+/**
+ * the value of ratio R in type T.
+ */
+template< typename R, typename T >
+constexpr T ratio_value()
+{
+    return static_cast<T>( R::num ) / static_cast<T>( R::den );
+}
+
+/**
+ * \brief The "affine" template converts a magnitude on scale From to scale To
+ * as x * factor + term, with factor and term exact rationals.
+ */
+template< typename From, typename To, typename T >
+struct affine
+{
+    static_assert( std::is_same< typename From::dimension_type, typename To::dimension_type >::value,
+        "scales must have the same dimensions" );
+
+    typedef std::ratio_divide< typename From::scale, typename To::scale > factor_ratio;
+
+    typedef std::ratio_divide< std::ratio_subtract< typename From::offset, typename To::offset >, typename To::scale > term_ratio;
+
+    static constexpr T factor() { return ratio_value<factor_ratio, T>(); }
+
+    static constexpr T term() { return ratio_value<term_ratio, T>(); }
+
+    static constexpr T apply( T const x ) { return x * factor() + term(); }
+};
+
+} // namespace detail
+
+/**
+ * \brief class "quantity_point" is a point on the affine scale Origin, such as
+ * a temperature in degree Celsius; its magnitude is in units of the scale.
+ */
+template< typename Origin, typename T = Rep >
+class quantity_point
+{
+public:
+    typedef typename Origin::dimension_type dimension_type;
+
+    typedef Origin origin_type;
+
+    typedef T value_type;
+
+    /// the difference of two points.
+
+    typedef quantity<dimension_type, T> difference_type;
+
+    constexpr quantity_point() : m_value{} { }
+
+    /**
+     * initializing constructor from a magnitude in units of the scale;
+     * requires magnitude_tag to prevent constructing a point from a raw magnitude.
+     */
+    template< typename X >
+    constexpr explicit quantity_point( detail::magnitude_tag_t, X x )
+    : m_value( x ) { }
+
+    /**
+     * converting constructor from a point on the same scale.
+     */
+    template< typename X >
+    constexpr quantity_point( quantity_point<Origin, X> const & x )
+    : m_value( x.magnitude() ) { }
+
+    /**
+     * converting constructor from a point on another scale, with one multiply-add.
+     */
+    template< typename O, typename X, typename = typename std::enable_if< !std::is_same<O, Origin>::value >::type >
+    constexpr quantity_point( quantity_point<O, X> const & x )
+    : m_value( detail::affine<O, Origin, T>::apply( x.magnitude() ) ) { }
+
+    /**
+     * constructor from the point's value in SI units, e.g. 293.15 * kelvin.
+     */
+    template< typename X >
+    constexpr explicit quantity_point( quantity<dimension_type, X> const & x )
+    : m_value( detail::affine<si_origin, Origin, T>::apply( x.magnitude() ) ) { }
+
+    /**
+     * the point's value in SI units, e.g. 293.15 K for 20 degree Celsius.
+     */
+    constexpr difference_type si() const
+    {
+        return difference_type( detail::magnitude_tag, detail::affine<Origin, si_origin, T>::apply( m_value ) );
+    }
+
+    /**
+     * the point's magnitude, in units of the scale.
+     */
+    constexpr value_type magnitude() const { return m_value; }
+
+    /**
+     * the point's dimensions.
+     */
+    constexpr dimension_type dimension() const { return dimension_type{}; }
+
+    /// point += difference
+
+    template< typename X >
+    quantity_point & operator+=( quantity<dimension_type, X> const & y )
+    {
+        return m_value += y.magnitude() * to_scale(), *this;
+    }
+
+    /// point -= difference
+
+    template< typename X >
+    quantity_point & operator-=( quantity<dimension_type, X> const & y )
+    {
+        return m_value -= y.magnitude() * to_scale(), *this;
+    }
+
+    /// factor from SI units to units of the scale.
+
+    static constexpr T to_scale() { return detail::ratio_value< std::ratio_divide< std::ratio<1>, typename Origin::scale >, T >(); }
+
+    /// factor from units of the scale to SI units.
+
+    static constexpr T from_scale() { return detail::ratio_value< typename Origin::scale, T >(); }
+
+private:
+    struct si_origin
+    {
+        typedef typename Origin::dimension_type dimension_type;
+        typedef std::ratio<1> scale;
+        typedef std::ratio<0> offset;
+    };
+
+private:
+    T m_value;
+
+    static_assert( Origin::scale::num > 0, "scale must be positive" );
+};
+
+/// a temperature in degree Celsius.
+
+template< typename T = Rep >
+using celsius_point = quantity_point< origins::celsius, T >;
+
+/// a temperature in degree Fahrenheit.
+
+template< typename T = Rep >
+using fahrenheit_point = quantity_point< origins::fahrenheit, T >;
+
+/// a temperature in kelvin, on the scale from absolute zero.
+
+template< typename T = Rep >
+using kelvin_point = quantity_point< origins::kelvin, T >;
+
+/// a temperature in degree Rankine.
+
+template< typename T = Rep >
+using rankine_point = quantity_point< origins::rankine, T >;
+
+/// the point with magnitude x on scale Origin, e.g. make_point<origins::celsius>( 20.0 ).
+
+template< typename Origin, typename T >
+constexpr quantity_point<Origin, T> make_point( T const x )
+{
+    return quantity_point<Origin, T>( detail::magnitude_tag, x );
+}
+
+/// convert to another scale with one multiply-add, e.g. point_cast<origins::fahrenheit>( t ).
+
+template< typename To, typename O, typename X >
+constexpr quantity_point<To, X> point_cast( quantity_point<O, X> const & x )
+{
+    return quantity_point<To, X>( x );
+}
+
+// Affine arithmetic; mixed scales convert explicitly.
+
+/// point - point: a difference in SI units.
+
+template< typename O, typename X, typename Y >
+constexpr quantity< typename O::dimension_type, detail::PromoteAdd<X, Y> >
+operator-( quantity_point<O, X> const & x, quantity_point<O, Y> const & y )
+{
+    return quantity< typename O::dimension_type, detail::PromoteAdd<X, Y> >( detail::magnitude_tag,
+        ( x.magnitude() - y.magnitude() ) * quantity_point<O, detail::PromoteAdd<X, Y> >::from_scale() );
+}
+
+/// point + difference
+
+template< typename O, typename X, typename Y >
+constexpr quantity_point< O, detail::PromoteAdd<X, Y> >
+operator+( quantity_point<O, X> const & x, quantity< typename O::dimension_type, Y > const & y )
+{
+    return quantity_point< O, detail::PromoteAdd<X, Y> >( detail::magnitude_tag,
+        x.magnitude() + y.magnitude() * quantity_point<O, detail::PromoteAdd<X, Y> >::to_scale() );
+}
+
+/// difference + point
+
+template< typename O, typename X, typename Y >
+constexpr quantity_point< O, detail::PromoteAdd<X, Y> >
+operator+( quantity< typename O::dimension_type, X > const & x, quantity_point<O, Y> const & y )
+{
+    return y + x;
+}
+
+/// point - difference
+
+template< typename O, typename X, typename Y >
+constexpr quantity_point< O, detail::PromoteAdd<X, Y> >
+operator-( quantity_point<O, X> const & x, quantity< typename O::dimension_type, Y > const & y )
+{
+    return quantity_point< O, detail::PromoteAdd<X, Y> >( detail::magnitude_tag,
+        x.magnitude() - y.magnitude() * quantity_point<O, detail::PromoteAdd<X, Y> >::to_scale() );
+}
+
+// Comparison operators within one scale
+
+/// equality.
+
+template< typename O, typename X, typename Y >
+constexpr bool operator==( quantity_point<O, X> const & x, quantity_point<O, Y> const & y )
+{
+    return x.magnitude() == y.magnitude();
+}
+
+/// inequality.
+
+template< typename O, typename X, typename Y >
+constexpr bool operator!=( quantity_point<O, X> const & x, quantity_point<O, Y> const & y )
+{
+    return x.magnitude() != y.magnitude();
+}
+
+/// less-than.
+
+template< typename O, typename X, typename Y >
+constexpr bool operator<( quantity_point<O, X> const & x, quantity_point<O, Y> const & y )
+{
+    return x.magnitude() < y.magnitude();
+}
+
+/// less-equal.
+
+template< typename O, typename X, typename Y >
+constexpr bool operator<=( quantity_point<O, X> const & x, quantity_point<O, Y> const & y )
+{
+    return x.magnitude() <= y.magnitude();
+}
+
+/// greater-than.
+
+template< typename O, typename X, typename Y >
+constexpr bool operator>( quantity_point<O, X> const & x, quantity_point<O, Y> const & y )
+{
+    return x.magnitude() > y.magnitude();
+}
+
+/// greater-equal.
+
+template< typename O, typename X, typename Y >
+constexpr bool operator>=( quantity_point<O, X> const & x, quantity_point<O, Y> const & y )
+{
+    return x.magnitude() >= y.magnitude();
+}
+
+// Bulk conversion
+
+/**
+ * convert the raw magnitudes in [first, last) on scale From to scale To and store
+ * them from out on, with one multiply-add each; returns the end of the output.
+ * out may be first. E.g. convert_points<origins::fahrenheit, origins::kelvin>( ... ).
+ */
+template< typename From, typename To, typename T >
+T * convert_points( T const * first, T const * last, T * out )
+{
+    typedef detail::affine<From, To, T> affine;
+
+    T const factor = affine::factor();
+    T const term   = affine::term();
+
+    std::size_t const n = static_cast<std::size_t>( last - first );
+
+    for ( std::size_t i = 0; i < n; ++i )
+        out[i] = first[i] * factor + term;
+
+    return out + n;
+}
+
+/**
+ * convert the points in [first, last) to the scale of out and store them from out on;
+ * returns the end of the output.
+ */
+template< typename From, typename X, typename To, typename Y >
+quantity_point<To, Y> * convert( quantity_point<From, X> const * first, quantity_point<From, X> const * last, quantity_point<To, Y> * out )
+{
+    std::size_t const n = static_cast<std::size_t>( last - first );
+
+    for ( std::size_t i = 0; i < n; ++i )
+        out[i] = quantity_point<To, Y>( first[i] );
+
+    return out + n;
+}
+
+}} // namespace phys::units
+
+#endif // PHYS_UNITS_QUANTITY_POINT_HPP_INCLUDED
+
+/*
+ * end of file
+ */
@@ -0,0 +1,295 @@
+/**
+ * \file quantity_span.hpp
+ *
+ * \brief   Non-owning views of raw magnitude buffers as quantities, and memory-mapped files.
+ * \author  Martin Moene
+ * \date    16 October 2026
+ * \since   1.2
+ *
+ * This code is provided as-is, with no warrantee of correctness.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+/*
+ * A quantity_span<Dims, T> views a contiguous array of T, such as a block of
+ * doubles in shared memory, as an array of quantity<Dims, T> without copying:
+ * a quantity is a standard-layout class with the magnitude as its only member.
+ * A quantity_span<Dims, T const> is read-only.
+ *
+ * A mapped_file maps a file into memory read-only with mmap(); map_span()
+ * views (part of) it as quantities. The file's page cache is used directly,
+ * so that only the pages that are used are read. mapped_file is available
+ * where PHYS_UNITS_HAVE_MMAP is 1, by default on POSIX systems.
+ */
+
+#ifndef PHYS_UNITS_QUANTITY_SPAN_HPP_INCLUDED
+#define PHYS_UNITS_QUANTITY_SPAN_HPP_INCLUDED
+
+#include "phys/units/quantity.hpp"
+#include "phys/units/quantity_vector.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+// Configuration
+
+#ifndef PHYS_UNITS_HAVE_MMAP
+# if defined( __unix__ ) || defined( __unix ) || ( defined( __APPLE__ ) && defined( __MACH__ ) )
+#  define PHYS_UNITS_HAVE_MMAP  1
+# else
+#  define PHYS_UNITS_HAVE_MMAP  0
+# endif
+#endif
+
+#if PHYS_UNITS_HAVE_MMAP
+# include <cerrno>
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+/// namespace phys.
+
+namespace phys {
+
+/// namespace units.
+
+namespace units {
+
+/**
+ * \brief class "quantity_span" is a non-owning view of a contiguous array of
+ * magnitudes of type T as quantities with dimensions Dims; T may be const.
+ */
+template< typename Dims, typename T = Rep >
+class quantity_span
+{
+public:
+    typedef Dims dimension_type;
+
+    typedef typename std::remove_cv<T>::type magnitude_type;
+
+    typedef quantity<Dims, magnitude_type> value_type;
+
+    typedef typename std::conditional< std::is_const<T>::value, value_type const, value_type >::type element_type;
+
+    typedef element_type * iterator;
+
+    typedef element_type & reference;
+
+    typedef std::size_t size_type;
+
+    static_assert( detail::is_layout_compatible<Dims, magnitude_type>::value,
+        "quantity must be layout-compatible with its magnitude type" );
+
+    constexpr quantity_span() : m_data(), m_size() { }
+
+    /**
+     * view the n quantities at data.
+     */
+    constexpr quantity_span( element_type * data, size_type const n ) : m_data( data ), m_size( n ) { }
+
+    /**
+     * view the n raw magnitudes at data, in SI units;
+     * requires magnitude_tag to prevent viewing raw magnitudes by accident.
+     */
+    quantity_span( detail::magnitude_tag_t, T * data, size_type const n )
+    : m_data( reinterpret_cast<element_type *>( data ) ), m_size( n ) { }
+
+    /**
+     * view the elements of a quantity_vector.
+     */
+    quantity_span( quantity_vector<Dims, magnitude_type> & v ) : m_data( v.data() ), m_size( v.size() ) { }
+
+    template< typename U = T, typename = typename std::enable_if< std::is_const<U>::value >::type >
+    quantity_span( quantity_vector<Dims, magnitude_type> const & v ) : m_data( v.data() ), m_size( v.size() ) { }
+
+    /**
+     * a writable span converts to a read-only one.
+     */
+    template< typename U, typename = typename std::enable_if< std::is_same< U const, T >::value && !std::is_same<U, T>::value >::type >
+    constexpr quantity_span( quantity_span<Dims, U> const & other ) : m_data( other.data() ), m_size( other.size() ) { }
+
+    quantity_span( quantity_span const & ) = default;
+
+    quantity_span & operator=( quantity_span const & ) = default;
+
+    constexpr size_type size() const { return m_size; }
+
+    constexpr bool empty() const { return m_size == 0; }
+
+    reference operator[]( size_type const i ) const { return m_data[i]; }
+
+    constexpr element_type * data() const { return m_data; }
+
+    constexpr iterator begin() const { return m_data; }
+
+    constexpr iterator end() const { return m_data + m_size; }
+
+    /**
+     * the raw magnitudes, in place.
+     */
+    T * magnitudes() const { return reinterpret_cast<T *>( m_data ); }
+
+    /**
+     * the count elements from offset on.
+     */
+    quantity_span subspan( size_type const offset, size_type const count ) const
+    {
+        assert( offset <= m_size && count <= m_size - offset && "subspan out of range" );
+
+        return quantity_span( m_data + offset, count );
+    }
+
+    /**
+     * the span's dimensions.
+     */
+    constexpr dimension_type dimension() const { return dimension_type{}; }
+
+private:
+    element_type * m_data;
+    size_type m_size;
+};
+
+/**
+ * view the n raw magnitudes at data as quantities with dimensions Dims, e.g.
+ * quantity_span<pressure_d, double const> p = make_span<pressure_d>( block, n );
+ */
+template< typename Dims, typename T >
+quantity_span<Dims, T> make_span( T * data, std::size_t const n )
+{
+    return quantity_span<Dims, T>( detail::magnitude_tag, data, n );
+}
+
+#if PHYS_UNITS_HAVE_MMAP
+
+/**
+ * \brief class "mapped_file" maps a file read-only into memory; move-only.
+ */
+class mapped_file
+{
+public:
+    mapped_file() : m_data(), m_size() { }
+
+    /**
+     * map the file at path; throws std::system_error if it cannot be opened or mapped.
+     */
+    explicit mapped_file( std::string const & path )
+    : m_data(), m_size()
+    {
+        int const fd = ::open( path.c_str(), O_RDONLY );
+
+        if ( fd < 0 )
+            fail( "cannot open", path );
+
+        struct stat st;
+
+        if ( ::fstat( fd, &st ) != 0 )
+        {
+            int const error = errno;
+            ::close( fd );
+            errno = error;
+            fail( "cannot stat", path );
+        }
+
+        m_size = static_cast<std::size_t>( st.st_size );
+
+        if ( m_size > 0 )
+        {
+            void * const data = ::mmap( nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0 );
+            int const error = errno;
+
+            ::close( fd );
+
+            if ( data == MAP_FAILED )
+            {
+                errno = error;
+                fail( "cannot map", path );
+            }
+            m_data = data;
+        }
+        else
+        {
+            ::close( fd );
+        }
+    }
+
+    mapped_file( mapped_file && other ) : m_data( other.m_data ), m_size( other.m_size )
+    {
+        other.m_data = nullptr;
+        other.m_size = 0;
+    }
+
+    mapped_file & operator=( mapped_file && other )
+    {
+        std::swap( m_data, other.m_data );
+        std::swap( m_size, other.m_size );
+        return *this;
+    }
+
+    mapped_file( mapped_file const & ) = delete;
+
+    mapped_file & operator=( mapped_file const & ) = delete;
+
+    ~mapped_file()
+    {
+        if ( m_data )
+            ::munmap( m_data, m_size );
+    }
+
+    /**
+     * the mapped bytes; page-aligned.
+     */
+    void const * data() const { return m_data; }
+
+    std::size_t size() const { return m_size; }
+
+private:
+    static void fail( char const * what, std::string const & path )
+    {
+        throw std::system_error( errno, std::generic_category(), std::string( "mapped_file: " ) + what + " '" + path + "'" );
+    }
+
+private:
+    void * m_data;
+    std::size_t m_size;
+};
+
+/**
+ * view the raw magnitudes of type T in file from byte offset on as quantities with
+ * dimensions Dims: count of them, or all up to the end of the file if count is -1.
+ * Throws std::out_of_range if they do not fit the file or are not aligned for T.
+ */
+template< typename Dims, typename T >
+quantity_span<Dims, T const> map_span( mapped_file const & file, std::size_t const offset = 0, std::size_t const count = std::size_t( -1 ) )
+{
+    if ( offset > file.size() || offset % alignof( T ) != 0 )
+        throw std::out_of_range( "map_span: offset out of range or not aligned" );
+
+    std::size_t const available = ( file.size() - offset ) / sizeof( T );
+
+    if ( count != std::size_t( -1 ) && count > available )
+        throw std::out_of_range( "map_span: file too short" );
+
+    T const * const data = reinterpret_cast<T const *>( static_cast<char const *>( file.data() ) + offset );
+
+    return quantity_span<Dims, T const>( detail::magnitude_tag, data, count == std::size_t( -1 ) ? available : count );
+}
+
+#endif // PHYS_UNITS_HAVE_MMAP
+
+}} // namespace phys::units
+
+#endif // PHYS_UNITS_QUANTITY_SPAN_HPP_INCLUDED
+
+/*
+ * end of file
+ */
@@ -0,0 +1,609 @@
+/**
+ * \file quantity_vec.hpp
+ *
+ * \brief   Fixed-size vectors and matrices of quantities, such as forces and inertia tensors.
+ * \author  Martin Moene
+ * \date    16 October 2026
+ * \since   1.2
+ *
+ * This code is provided as-is, with no warrantee of correctness.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+/*
+ * A quantity_vec<Dims, T, N> holds N quantities with dimensions Dims, and a
+ * quantity_mat<Dims, T, R, C> an R x C matrix of them, e.g. a force vector
+ * and an inertia tensor. The quantities are stored in one array with the
+ * alignment of T, and the operations loop over their magnitudes as an array
+ * of T, so that the fixed-length loops vectorize with unaligned loads.
+ * The types are not over-aligned: before C++17, new and std::vector do not
+ * honour extended alignment, and padding would make a vec3 of double take
+ * 32 instead of 24 bytes.
+ *
+ * The result dimensions of products follow from detail::product_dimensions
+ * and detail::Product, as for quantity: the cross product of a length and a
+ * force vector is a torque vector, their dot product an energy, and an
+ * inertia tensor times an angular velocity vector an angular momentum vector.
+ */
+
+#ifndef PHYS_UNITS_QUANTITY_VEC_HPP_INCLUDED
+#define PHYS_UNITS_QUANTITY_VEC_HPP_INCLUDED
+
+#include "phys/units/quantity.hpp"
+#include "phys/units/quantity_vector.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+/// namespace phys.
+
+namespace phys {
+
+/// namespace units.
+
+namespace units {
+
+/// namespace detail.
+
+namespace detail {
+
+/**
+ * apply f to the indices 0 to N-1 in order, as straight-line code, so that the
+ * short fixed-length loops of the operations unroll without -O3.
+ */
+template< std::size_t N >
+struct unrolled
+{
+    template< typename F >
+    static void apply( F const & f )
+    {
+        unrolled< N - 1 >::apply( f );
+        f( N - 1 );
+    }
+};
+
+template<>
+struct unrolled< 0 >
+{
+    template< typename F >
+    static void apply( F const & ) { }
+};
+
+} // namespace detail
+
+/**
+ * \brief class "quantity_vec" is a vector of N quantities with dimensions Dims,
+ * stored as an array.
+ */
+template< typename Dims, typename T = Rep, std::size_t N = 3 >
+class quantity_vec
+{
+public:
+    typedef Dims dimension_type;
+
+    typedef T magnitude_type;
+
+    typedef quantity<Dims, T> value_type;
+
+    typedef value_type & reference;
+
+    typedef value_type const & const_reference;
+
+    typedef std::size_t size_type;
+
+    static_assert( detail::is_layout_compatible<Dims, T>::value,
+        "quantity must be layout-compatible with its magnitude type" );
+
+    /// zero vector.
+
+    quantity_vec() : m_data() { }
+
+    /**
+     * from N quantities, e.g. quantity_vec<force_d>( 1 * newton, 0 * newton, 0 * newton ).
+     */
+    template< typename... X, typename = typename std::enable_if< sizeof...( X ) == N && ( N > 1 ) >::type >
+    quantity_vec( quantity<Dims, X> const &... q ) : m_data{ value_type( q )... } { }
+
+    /**
+     * from N raw magnitudes at data, in SI units;
+     * requires magnitude_tag to prevent constructing from raw magnitudes by accident.
+     */
+    quantity_vec( detail::magnitude_tag_t, T const * data ) : m_data()
+    {
+        detail::unrolled< N >::apply( [&]( std::size_t i ) { m_data[i] = value_type( detail::magnitude_tag, data[i] ); } );
+    }
+
+    static constexpr size_type size() { return N; }
+
+    reference       operator[]( size_type i )       { return data()[i]; }
+    const_reference operator[]( size_type i ) const { return data()[i]; }
+
+    value_type       * data()       { return m_data; }
+    value_type const * data() const { return m_data; }
+
+    value_type       * begin()       { return data(); }
+    value_type const * begin() const { return data(); }
+
+    value_type       * end()       { return data() + N; }
+    value_type const * end() const { return data() + N; }
+
+    /**
+     * the raw magnitudes.
+     */
+    T       * magnitudes()       { return reinterpret_cast<T       *>( m_data ); }
+    T const * magnitudes() const { return reinterpret_cast<T const *>( m_data ); }
+
+    /**
+     * the vector's dimensions.
+     */
+    constexpr dimension_type dimension() const { return dimension_type{}; }
+
+    /// vec += vec
+
+    template< typename X >
+    quantity_vec & operator+=( quantity_vec<Dims, X, N> const & y )
+    {
+        detail::unrolled< N >::apply( [&]( std::size_t i ) { magnitudes()[i] += y.magnitudes()[i]; } );
+        return *this;
+    }
+
+    /// vec -= vec
+
+    template< typename X >
+    quantity_vec & operator-=( quantity_vec<Dims, X, N> const & y )
+    {
+        detail::unrolled< N >::apply( [&]( std::size_t i ) { magnitudes()[i] -= y.magnitudes()[i]; } );
+        return *this;
+    }
+
+    /// vec *= num
+
+    template< typename X, typename = detail::PromoteMulScalar<T, X> >
+    quantity_vec & operator*=( X const & y )
+    {
+        detail::unrolled< N >::apply( [&]( std::size_t i ) { magnitudes()[i] *= y; } );
+        return *this;
+    }
+
+    /// vec /= num
+
+    template< typename X, typename = detail::PromoteMulScalar<T, X> >
+    quantity_vec & operator/=( X const & y )
+    {
+        detail::unrolled< N >::apply( [&]( std::size_t i ) { magnitudes()[i] /= y; } );
+        return *this;
+    }
+
+private:
+    value_type m_data[N];
+};
+
+/**
+ * \brief class "quantity_mat" is an R x C matrix of quantities with dimensions
+ * Dims, stored row by row as an array.
+ */
+template< typename Dims, typename T = Rep, std::size_t R = 3, std::size_t C = R >
+class quantity_mat
+{
+public:
+    typedef Dims dimension_type;
+
+    typedef T magnitude_type;
+
+    typedef quantity<Dims, T> value_type;
+
+    typedef value_type & reference;
+
+    typedef value_type const & const_reference;
+
+    typedef std::size_t size_type;
+
+    static_assert( detail::is_layout_compatible<Dims, T>::value,
+        "quantity must be layout-compatible with its magnitude type" );
+
+    /// zero matrix.
+
+    quantity_mat() : m_data() { }
+
+    /**
+     * from R * C quantities, row by row.
+     */
+    template< typename... X, typename = typename std::enable_if< sizeof...( X ) == R * C && ( R * C > 1 ) >::type >
+    quantity_mat( quantity<Dims, X> const &... q ) : m_data{ value_type( q )... } { }
+
+    /**
+     * from R * C raw magnitudes at data, row by row, in SI units;
+     * requires magnitude_tag to prevent constructing from raw magnitudes by accident.
+     */
+    quantity_mat( detail::magnitude_tag_t, T const * data ) : m_data()
+    {
+        detail::unrolled< R * C >::apply( [&]( std::size_t i ) { m_data[i] = value_type( detail::magnitude_tag, data[i] ); } );
+    }
+
+    /**
+     * the diagonal matrix with x on the diagonal.
+     */
+    template< typename X >
+    static quantity_mat diagonal( quantity<Dims, X> const & x )
+    {
+        static_assert( R == C, "diagonal matrix must be square" );
+
+        quantity_mat result;
+
+        detail::unrolled< R >::apply( [&]( std::size_t i ) { result.m_data[i * C + i] = x; } );
+        return result;
+    }
+
+    static constexpr size_type rows() { return R; }
+
+    static constexpr size_type cols() { return C; }
+
+    reference       operator()( size_type r, size_type c )       { return m_data[r * C + c]; }
+    const_reference operator()( size_type r, size_type c ) const { return m_data[r * C + c]; }
+
+    /**
+     * the raw magnitudes, row by row.
+     */
+    T       * magnitudes()       { return reinterpret_cast<T       *>( m_data ); }
+    T const * magnitudes() const { return reinterpret_cast<T const *>( m_data ); }
+
+    /**
+     * the matrix's dimensions.
+     */
+    constexpr dimension_type dimension() const { return dimension_type{}; }
+
+    /// mat += mat
+
+    template< typename X >
+    quantity_mat & operator+=( quantity_mat<Dims, X, R, C> const & y )
+    {
+        detail::unrolled< R * C >::apply( [&]( std::size_t i ) { magnitudes()[i] += y.magnitudes()[i]; } );
+        return *this;
+    }
+
+    /// mat -= mat
+
+    template< typename X >
+    quantity_mat & operator-=( quantity_mat<Dims, X, R, C> const & y )
+    {
+        detail::unrolled< R * C >::apply( [&]( std::size_t i ) { magnitudes()[i] -= y.magnitudes()[i]; } );
+        return *this;
+    }
+
+    /// mat *= num
+
+    template< typename X, typename = detail::PromoteMulScalar<T, X> >
+    quantity_mat & operator*=( X const & y )
+    {
+        detail::unrolled< R * C >::apply( [&]( std::size_t i ) { magnitudes()[i] *= y; } );
+        return *this;
+    }
+
+    /// mat /= num
+
+    template< typename X, typename = detail::PromoteMulScalar<T, X> >
+    quantity_mat & operator/=( X const & y )
+    {
+        detail::unrolled< R * C >::apply( [&]( std::size_t i ) { magnitudes()[i] /= y; } );
+        return *this;
+    }
+
+private:
+    value_type m_data[R * C];
+};
+
+// Vector operators
+
+/// - vec
+
+template< typename D, typename X, std::size_t N >
+quantity_vec<D, X, N> operator-( quantity_vec<D, X, N> const & x )
+{
+    quantity_vec<D, X, N> result;
+
+    detail::unrolled< N >::apply( [&]( std::size_t i ) { result.magnitudes()[i] = -x.magnitudes()[i]; } );
+    return result;
+}
+
+/// vec + vec
+
+template< typename D, typename X, typename Y, std::size_t N >
+quantity_vec< D, detail::PromoteAdd<X, Y>, N >
+operator+( quantity_vec<D, X, N> const & x, quantity_vec<D, Y, N> const & y )
+{
+    quantity_vec< D, detail::PromoteAdd<X, Y>, N > result;
+
+    detail::unrolled< N >::apply( [&]( std::size_t i ) { result.magnitudes()[i] = x.magnitudes()[i] + y.magnitudes()[i]; } );
+    return result;
+}
+
+/// vec - vec
+
+template< typename D, typename X, typename Y, std::size_t N >
+quantity_vec< D, detail::PromoteAdd<X, Y>, N >
+operator-( quantity_vec<D, X, N> const & x, quantity_vec<D, Y, N> const & y )
+{
+    quantity_vec< D, detail::PromoteAdd<X, Y>, N > result;
+
+    detail::unrolled< N >::apply( [&]( std::size_t i ) { result.magnitudes()[i] = x.magnitudes()[i] - y.magnitudes()[i]; } );
+    return result;
+}
+
+/// vec * num
+
+template< typename D, typename X, typename Y, std::size_t N >
+quantity_vec< D, detail::PromoteMulScalar<X, Y>, N >
+operator*( quantity_vec<D, X, N> const & x, Y const & y )
+{
+    quantity_vec< D, detail::PromoteMulScalar<X, Y>, N > result;
+
+    detail::unrolled< N >::apply( [&]( std::size_t i ) { result.magnitudes()[i] = x.magnitudes()[i] * y; } );
+    return result;
+}
+
+/// num * vec
+
+template< typename D, typename X, typename Y, std::size_t N >
+quantity_vec< D, detail::PromoteMulScalar<X, Y>, N >
+operator*( X const & x, quantity_vec<D, Y, N> const & y )
+{
+    return y * x;
+}
+
+/// vec / num
+
+template< typename D, typename X, typename Y, std::size_t N >
+quantity_vec< D, detail::PromoteMulScalar<X, Y>, N >
+operator/( quantity_vec<D, X, N> const & x, Y const & y )
+{
+    quantity_vec< D, detail::PromoteMulScalar<X, Y>, N > result;
+
+    detail::unrolled< N >::apply( [&]( std::size_t i ) { result.magnitudes()[i] = x.magnitudes()[i] / y; } );
+    return result;
+}
+
+/// vec * quan, e.g. velocity times time interval
+
+template< typename DX, typename X, typename DY, typename Y, std::size_t N >
+quantity_vec< detail::product_dimensions<DX, DY>, detail::PromoteMul<X, Y>, N >
+operator*( quantity_vec<DX, X, N> const & x, quantity<DY, Y> const & y )
+{
+    quantity_vec< detail::product_dimensions<DX, DY>, detail::PromoteMul<X, Y>, N > result;
+
+    detail::unrolled< N >::apply( [&]( std::size_t i ) { result.magnitudes()[i] = x.magnitudes()[i] * y.magnitude(); } );
+    return result;
+}
+
+/// quan * vec, e.g. mass times acceleration
+
+template< typename DX, typename X, typename DY, typename Y, std::size_t N >
+quantity_vec< detail::product_dimensions<DX, DY>, detail::PromoteMul<X, Y>, N >
+operator*( quantity<DX, X> const & x, quantity_vec<DY, Y, N> const & y )
+{
+    quantity_vec< detail::product_dimensions<DX, DY>, detail::PromoteMul<X, Y>, N > result;
+
+    detail::unrolled< N >::apply( [&]( std::size_t i ) { result.magnitudes()[i] = x.magnitude() * y.magnitudes()[i]; } );
+    return result;
+}
+
+/// vec / quan, e.g. force divided by mass
+
+template< typename DX, typename X, typename DY, typename Y, std::size_t N >
+quantity_vec< detail::quotient_dimensions<DX, DY>, detail::PromoteMul<X, Y>, N >
+operator/( quantity_vec<DX, X, N> const & x, quantity<DY, Y> const & y )
+{
+    quantity_vec< detail::quotient_dimensions<DX, DY>, detail::PromoteMul<X, Y>, N > result;
+
+    detail::unrolled< N >::apply( [&]( std::size_t i ) { result.magnitudes()[i] = x.magnitudes()[i] / y.magnitude(); } );
+    return result;
+}
+
+/**
+ * dot product; its dimensions are the product of those of x and y.
+ */
+template< typename DX, typename X, typename DY, typename Y, std::size_t N >
+detail::Product<DX, DY, X, Y>
+dot( quantity_vec<DX, X, N> const & x, quantity_vec<DY, Y, N> const & y )
+{
+    detail::PromoteMul<X, Y> sum = detail::PromoteMul<X, Y>();
+
+    detail::unrolled< N >::apply( [&]( std::size_t i ) { sum += x.magnitudes()[i] * y.magnitudes()[i]; } );
+
+    return detail::collapse< detail::product_dimensions<DX, DY>, detail::PromoteMul<X, Y> >::make( sum );
+}
+
+/**
+ * cross product of three-vectors, e.g. a length and a force vector give a torque vector.
+ */
+template< typename DX, typename X, typename DY, typename Y >
+quantity_vec< detail::product_dimensions<DX, DY>, detail::PromoteMul<X, Y>, 3 >
+cross( quantity_vec<DX, X, 3> const & x, quantity_vec<DY, Y, 3> const & y )
+{
+    X const * const a = x.magnitudes();
+    Y const * const b = y.magnitudes();
+
+    quantity_vec< detail::product_dimensions<DX, DY>, detail::PromoteMul<X, Y>, 3 > result;
+
+    result.magnitudes()[0] = a[1] * b[2] - a[2] * b[1];
+    result.magnitudes()[1] = a[2] * b[0] - a[0] * b[2];
+    result.magnitudes()[2] = a[0] * b[1] - a[1] * b[0];
+    return result;
+}
+
+/**
+ * Euclidean length, with the dimensions of the elements.
+ */
+template< typename D, typename X, std::size_t N >
+quantity<D, X> norm( quantity_vec<D, X, N> const & x )
+{
+    X sum = X();
+
+    detail::unrolled< N >::apply( [&]( std::size_t i ) { sum += x.magnitudes()[i] * x.magnitudes()[i]; } );
+
+    return quantity<D, X>( detail::magnitude_tag, detail::magnitude_root<2>::of( sum ) );
+}
+
+/// equality.
+
+template< typename D, typename X, typename Y, std::size_t N >
+bool operator==( quantity_vec<D, X, N> const & x, quantity_vec<D, Y, N> const & y )
+{
+    for ( std::size_t i = 0; i < N; ++i )
+    {
+        if ( !( x.magnitudes()[i] == y.magnitudes()[i] ) )
+            return false;
+    }
+    return true;
+}
+
+/// inequality.
+
+template< typename D, typename X, typename Y, std::size_t N >
+bool operator!=( quantity_vec<D, X, N> const & x, quantity_vec<D, Y, N> const & y )
+{
+    return !( x == y );
+}
+
+// Matrix operators
+
+/// mat + mat
+
+template< typename D, typename X, typename Y, std::size_t R, std::size_t C >
+quantity_mat< D, detail::PromoteAdd<X, Y>, R, C >
+operator+( quantity_mat<D, X, R, C> const & x, quantity_mat<D, Y, R, C> const & y )
+{
+    quantity_mat< D, detail::PromoteAdd<X, Y>, R, C > result;
+
+    detail::unrolled< R * C >::apply( [&]( std::size_t i ) { result.magnitudes()[i] = x.magnitudes()[i] + y.magnitudes()[i]; } );
+    return result;
+}
+
+/// mat - mat
+
+template< typename D, typename X, typename Y, std::size_t R, std::size_t C >
+quantity_mat< D, detail::PromoteAdd<X, Y>, R, C >
+operator-( quantity_mat<D, X, R, C> const & x, quantity_mat<D, Y, R, C> const & y )
+{
+    quantity_mat< D, detail::PromoteAdd<X, Y>, R, C > result;
+
+    detail::unrolled< R * C >::apply( [&]( std::size_t i ) { result.magnitudes()[i] = x.magnitudes()[i] - y.magnitudes()[i]; } );
+    return result;
+}
+
+/// mat * num
+
+template< typename D, typename X, typename Y, std::size_t R, std::size_t C >
+quantity_mat< D, detail::PromoteMulScalar<X, Y>, R, C >
+operator*( quantity_mat<D, X, R, C> const & x, Y const & y )
+{
+    quantity_mat< D, detail::PromoteMulScalar<X, Y>, R, C > result;
+
+    detail::unrolled< R * C >::apply( [&]( std::size_t i ) { result.magnitudes()[i] = x.magnitudes()[i] * y; } );
+    return result;
+}
+
+/// num * mat
+
+template< typename D, typename X, typename Y, std::size_t R, std::size_t C >
+quantity_mat< D, detail::PromoteMulScalar<X, Y>, R, C >
+operator*( X const & x, quantity_mat<D, Y, R, C> const & y )
+{
+    return y * x;
+}
+
+/**
+ * matrix-vector product, e.g. an inertia tensor and an angular velocity give an angular momentum.
+ */
+template< typename DM, typename X, typename DV, typename Y, std::size_t R, std::size_t C >
+quantity_vec< detail::product_dimensions<DM, DV>, detail::PromoteMul<X, Y>, R >
+operator*( quantity_mat<DM, X, R, C> const & m, quantity_vec<DV, Y, C> const & v )
+{
+    typedef detail::PromoteMul<X, Y> Z;
+
+    quantity_vec< detail::product_dimensions<DM, DV>, Z, R > result;
+
+    detail::unrolled< R >::apply( [&]( std::size_t r )
+    {
+        Z sum = Z();
+
+        detail::unrolled< C >::apply( [&]( std::size_t c ) { sum += m.magnitudes()[r * C + c] * v.magnitudes()[c]; } );
+
+        result.magnitudes()[r] = sum;
+    } );
+    return result;
+}
+
+/**
+ * matrix product.
+ */
+template< typename DX, typename X, typename DY, typename Y, std::size_t R, std::size_t K, std::size_t C >
+quantity_mat< detail::product_dimensions<DX, DY>, detail::PromoteMul<X, Y>, R, C >
+operator*( quantity_mat<DX, X, R, K> const & x, quantity_mat<DY, Y, K, C> const & y )
+{
+    quantity_mat< detail::product_dimensions<DX, DY>, detail::PromoteMul<X, Y>, R, C > result;
+
+    detail::unrolled< R * K >::apply( [&]( std::size_t rk )
+    {
+        std::size_t const r = rk / K;
+
+        detail::unrolled< C >::apply( [&]( std::size_t c ) { result.magnitudes()[r * C + c] += x.magnitudes()[rk] * y.magnitudes()[( rk % K ) * C + c]; } );
+    } );
+    return result;
+}
+
+/**
+ * transposed matrix.
+ */
+template< typename D, typename X, std::size_t R, std::size_t C >
+quantity_mat<D, X, C, R> transpose( quantity_mat<D, X, R, C> const & x )
+{
+    quantity_mat<D, X, C, R> result;
+
+    for ( std::size_t r = 0; r < R; ++r )
+    {
+        for ( std::size_t c = 0; c < C; ++c )
+            result.magnitudes()[c * R + r] = x.magnitudes()[r * C + c];
+    }
+    return result;
+}
+
+/// equality.
+
+template< typename D, typename X, typename Y, std::size_t R, std::size_t C >
+bool operator==( quantity_mat<D, X, R, C> const & x, quantity_mat<D, Y, R, C> const & y )
+{
+    for ( std::size_t i = 0; i < R * C; ++i )
+    {
+        if ( !( x.magnitudes()[i] == y.magnitudes()[i] ) )
+            return false;
+    }
+    return true;
+}
+
+/// inequality.
+
+template< typename D, typename X, typename Y, std::size_t R, std::size_t C >
+bool operator!=( quantity_mat<D, X, R, C> const & x, quantity_mat<D, Y, R, C> const & y )
+{
+    return !( x == y );
+}
+
+/// three-vector of quantities of type Q, e.g. vec3< quantity<force_d> >.
+
+template< typename Q >
+using vec3 = quantity_vec< typename Q::dimension_type, typename Q::value_type, 3 >;
+
+/// 3 x 3 matrix of quantities of type Q, e.g. mat3< quantity< dimensions<2, 1, 0> > > for an inertia tensor.
+
+template< typename Q >
+using mat3 = quantity_mat< typename Q::dimension_type, typename Q::value_type, 3, 3 >;
+
+}} // namespace phys::units
+
+#endif // PHYS_UNITS_QUANTITY_VEC_HPP_INCLUDED
+
+/*
+ * end of file
+ */
@@ -0,0 +1,380 @@
+/**
+ * \file quantity_vector.hpp
+ *
+ * \brief   Contiguous, aligned container of quantities with element-wise arithmetic.
+ * \author  Martin Moene
+ * \date    16 October 2026
+ * \since   1.2
+ *
+ * This code is provided as-is, with no warrantee of correctness.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+/*
+ * A quantity_vector<Dims, T> stores the magnitudes of its elements in one
+ * aligned array of T, so that bulk arithmetic runs as plain loops over T
+ * that the compiler can vectorize. The dimensions are carried by the type,
+ * exactly as with quantity<Dims, T>.
+ *
+ * Arithmetic on quantity_vector is lazy, see quantity_expression.hpp:
+ * assigning an expression to a quantity_vector evaluates it in one pass.
+ */
+
+#ifndef PHYS_UNITS_QUANTITY_VECTOR_HPP_INCLUDED
+#define PHYS_UNITS_QUANTITY_VECTOR_HPP_INCLUDED
+
+#include "phys/units/quantity.hpp"
+#include "phys/units/quantity_expression.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Configuration
+
+#ifndef  PHYS_UNITS_VECTOR_ALIGNMENT
+# define PHYS_UNITS_VECTOR_ALIGNMENT  64
+#endif
+
+/// namespace phys.
+
+namespace phys {
+
+/// namespace units.
+
+namespace units {
+
+/// namespace detail.
+
+namespace detail {
+
+/**
+ * allocator that aligns storage to Align bytes, for aligned SIMD loads and stores.
+ */
+template< typename T, std::size_t Align = PHYS_UNITS_VECTOR_ALIGNMENT >
+struct aligned_allocator
+{
+    typedef T value_type;
+
+    static_assert( Align >= alignof( void * ) && ( Align & ( Align - 1 ) ) == 0,
+        "alignment must be a power of two, at least that of a pointer" );
+
+    template< typename U >
+    struct rebind { typedef aligned_allocator<U, Align> other; };
+
+    aligned_allocator() { }
+
+    template< typename U >
+    aligned_allocator( aligned_allocator<U, Align> const & ) { }
+
+    /// over-allocate and keep the original address just before the aligned block.
+
+    T * allocate( std::size_t n )
+    {
+        void * raw = std::malloc( n * sizeof( T ) + Align + sizeof( void * ) );
+
+        if ( raw == nullptr )
+            throw std::bad_alloc();
+
+        std::size_t const addr = reinterpret_cast<std::size_t>( raw ) + sizeof( void * );
+        void ** aligned = reinterpret_cast<void **>( ( addr + Align - 1 ) & ~( Align - 1 ) );
+        aligned[-1] = raw;
+
+        return reinterpret_cast<T *>( aligned );
+    }
+
+    void deallocate( T * p, std::size_t )
+    {
+        if ( p != nullptr )
+            std::free( reinterpret_cast<void **>( p )[-1] );
+    }
+};
+
+template< typename T, typename U, std::size_t A >
+inline bool operator==( aligned_allocator<T, A> const &, aligned_allocator<U, A> const & ) { return true; }
+
+template< typename T, typename U, std::size_t A >
+inline bool operator!=( aligned_allocator<T, A> const &, aligned_allocator<U, A> const & ) { return false; }
+
+/**
+ * true if an array of T may be viewed as an array of quantity<D, T>.
+ */
+template< typename D, typename T >
+struct is_layout_compatible : std::integral_constant< bool,
+    std::is_standard_layout< quantity<D, T> >::value &&
+    sizeof ( quantity<D, T> ) == sizeof ( T ) &&
+    alignof( quantity<D, T> ) == alignof( T ) > { };
+
+/**
+ * container type generator: a quantity_vector for quantities and
+ * an aligned std::vector for dimensionless (collapsed) results.
+ */
+template< typename Q >
+struct vector_of
+{
+    typedef std::vector< Q, aligned_allocator<Q> > type;
+};
+
+template< typename D, typename T >
+struct vector_of< quantity<D, T> >
+{
+    typedef quantity_vector< D, T > type;
+};
+
+template< typename Q >
+using VectorOf = typename vector_of<Q>::type;
+
+/// raw magnitudes of a container.
+
+template< typename D, typename T >
+inline T * magnitudes( quantity_vector<D, T> & v ) { return v.magnitudes(); }
+
+template< typename T >
+inline T * magnitudes( std::vector< T, aligned_allocator<T> > & v ) { return v.data(); }
+
+/// magnitude of an element.
+
+template< typename D, typename T >
+constexpr T magnitude_of( quantity<D, T> const & x ) { return x.magnitude(); }
+
+template< typename T >
+constexpr T magnitude_of( T const & x ) { return x; }
+
+/**
+ * the kernel behind all evaluation: r[i] = magnitude of e[i].
+ */
+template< typename T, typename E >
+inline void evaluate_n( T * r, E const & e, std::size_t const n )
+{
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        r[i] = magnitude_of( e[i] );
+    }
+}
+
+} // namespace detail
+
+/**
+ * \brief class "quantity_vector" is a contiguous container of quantities
+ * with dimensions Dims. Magnitudes are stored as an aligned array of T;
+ * element-wise arithmetic yields a vector_expr of the correct result type.
+ */
+template< typename Dims, typename T /*= Rep */ >
+class quantity_vector
+{
+public:
+    typedef Dims dimension_type;
+
+    typedef T magnitude_type;
+
+    typedef quantity<Dims, T> value_type;
+
+    typedef value_type & reference;
+
+    typedef value_type const & const_reference;
+
+    typedef value_type * iterator;
+
+    typedef value_type const * const_iterator;
+
+    typedef std::size_t size_type;
+
+    typedef quantity_vector<Dims, T> this_type;
+
+    typedef std::vector< T, detail::aligned_allocator<T> > storage_type;
+
+    static_assert( detail::is_layout_compatible<Dims, T>::value,
+        "quantity must be layout-compatible with its magnitude type" );
+
+    quantity_vector() : m_data() { }
+
+    /**
+     * n zero-valued elements.
+     */
+    explicit quantity_vector( size_type n ) : m_data( n ) { }
+
+    /**
+     * n copies of value.
+     */
+    quantity_vector( size_type n, value_type const & value ) : m_data( n, value.magnitude() ) { }
+
+    quantity_vector( std::initializer_list<value_type> values )
+    : m_data()
+    {
+        m_data.reserve( values.size() );
+
+        for ( auto const & q : values )
+            m_data.push_back( q.magnitude() );
+    }
+
+    /**
+     * construct from raw magnitudes [first, last);
+     * requires magnitude_tag to prevent constructing from raw magnitudes by accident.
+     */
+    template< typename X >
+    quantity_vector( detail::magnitude_tag_t, X const * first, X const * last )
+    : m_data( first, last ) { }
+
+    /**
+     * take over raw magnitudes, e.g. from a dynamic_vector;
+     * requires magnitude_tag to prevent constructing from raw magnitudes by accident.
+     */
+    quantity_vector( detail::magnitude_tag_t, storage_type && data )
+    : m_data( std::move( data ) ) { }
+
+    /**
+     * evaluate expression, see quantity_expression.hpp.
+     */
+    template< typename Op, typename L, typename R >
+    quantity_vector( vector_expr<Op, L, R> const & e )
+    : m_data( e.size() )
+    {
+        assign( e );
+    }
+
+    template< typename Op, typename L, typename R >
+    quantity_vector & operator=( vector_expr<Op, L, R> const & e )
+    {
+        m_data.resize( e.size() );
+        return assign( e );
+    }
+
+    size_type size()  const { return m_data.size(); }
+
+    size_type max_size() const { return m_data.max_size(); }
+
+    bool empty() const { return m_data.empty(); }
+
+    void clear() { m_data.clear(); }
+
+    void reserve( size_type n ) { m_data.reserve( n ); }
+
+    void resize( size_type n ) { m_data.resize( n ); }
+
+    void push_back( value_type const & q ) { m_data.push_back( q.magnitude() ); }
+
+    reference       operator[]( size_type i )       { return data()[i]; }
+    const_reference operator[]( size_type i ) const { return data()[i]; }
+
+    value_type       * data()       { return reinterpret_cast<value_type       *>( m_data.data() ); }
+    value_type const * data() const { return reinterpret_cast<value_type const *>( m_data.data() ); }
+
+    iterator       begin()       { return data(); }
+    const_iterator begin() const { return data(); }
+
+    iterator       end()       { return data() + size(); }
+    const_iterator end() const { return data() + size(); }
+
+    /**
+     * the raw, aligned magnitudes.
+     */
+    magnitude_type       * magnitudes()       { return m_data.data(); }
+    magnitude_type const * magnitudes() const { return m_data.data(); }
+
+    /**
+     * the container's dimensions.
+     */
+    constexpr dimension_type dimension() const { return dimension_type{}; }
+
+private:
+    template< typename E >
+    quantity_vector & assign( E const & e )
+    {
+        static_assert( std::is_convertible< typename E::value_type, value_type >::value,
+            "expression must yield quantities of the dimensions of the quantity_vector" );
+
+        detail::evaluate_n( m_data.data(), e, m_data.size() );
+        return *this;
+    }
+
+private:
+    storage_type m_data;
+};
+
+/**
+ * evaluate expression into a new container, a quantity_vector or,
+ * for dimensionless results, an aligned std::vector.
+ */
+template< typename Op, typename L, typename R >
+detail::VectorOf< typename vector_expr<Op, L, R>::value_type >
+evaluate( vector_expr<Op, L, R> const & e )
+{
+    detail::VectorOf< typename vector_expr<Op, L, R>::value_type > result( e.size() );
+    detail::evaluate_n( detail::magnitudes( result ), e, e.size() );
+    return result;
+}
+
+// Compound assignment operators, evaluated in place.
+
+/// vec += vec, vec += expr, vec += quan
+
+template< typename D, typename X, typename Y >
+auto operator+=( quantity_vector<D, X> & x, Y const & y ) -> decltype( x = x + y )
+{
+    return x = x + y;
+}
+
+/// vec -= vec, vec -= expr, vec -= quan
+
+template< typename D, typename X, typename Y >
+auto operator-=( quantity_vector<D, X> & x, Y const & y ) -> decltype( x = x - y )
+{
+    return x = x - y;
+}
+
+/// vec *= num, vec *= expr
+
+template< typename D, typename X, typename Y >
+auto operator*=( quantity_vector<D, X> & x, Y const & y ) -> decltype( x = x * y )
+{
+    return x = x * y;
+}
+
+/// vec /= num, vec /= expr
+
+template< typename D, typename X, typename Y >
+auto operator/=( quantity_vector<D, X> & x, Y const & y ) -> decltype( x = x / y )
+{
+    return x = x / y;
+}
+
+// Comparison operators
+
+/// equality.
+
+template< typename D, typename X, typename Y >
+bool operator==( quantity_vector<D, X> const & x, quantity_vector<D, Y> const & y )
+{
+    if ( x.size() != y.size() )
+        return false;
+
+    for ( std::size_t i = 0; i < x.size(); ++i )
+    {
+        if ( x[i] != y[i] )
+            return false;
+    }
+    return true;
+}
+
+/// inequality.
+
+template< typename D, typename X, typename Y >
+bool operator!=( quantity_vector<D, X> const & x, quantity_vector<D, Y> const & y )
+{
+    return !( x == y );
+}
+
+}} // namespace phys::units
+
+#endif // PHYS_UNITS_QUANTITY_VECTOR_HPP_INCLUDED
+
+/*
+ * end of file
+ */
@@ -0,0 +1,373 @@
+/**
+ * \file scaled_quantity.hpp
+ *
+ * \brief   Quantities stored in a unit that is a compile-time rational multiple of the SI unit.
+ * \author  Martin Moene
+ * \date    16 October 2026
+ * \since   1.2
+ *
+ * This code is provided as-is, with no warrantee of correctness.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+/*
+ * A scaled_quantity<Dims, Scale, T> stores its magnitude in units of Scale
+ * times the SI unit of Dims, where Scale is a std::ratio. For example,
+ * scaled_quantity<length_d, scales::foot> holds a length in feet.
+ *
+ * Data can thus be kept in its native unit. Arithmetic within one scale
+ * needs no conversion at all; a conversion to another scale or to quantity
+ * (SI) is a single multiplication by a factor that is computed exactly from
+ * the rationals at compile time. Converting feet to meter directly rather
+ * than via inch therefore rounds once.
+ */
+
+#ifndef PHYS_UNITS_SCALED_QUANTITY_HPP_INCLUDED
+#define PHYS_UNITS_SCALED_QUANTITY_HPP_INCLUDED
+
+#include "phys/units/quantity.hpp"
+
+#include <ratio>
+#include <type_traits>
+
+/// namespace phys.
+
+namespace phys {
+
+/// namespace units.
+
+namespace units {
+
+/*
+ * declare now, define later.
+ */
+template< typename Dims, typename Scale, typename T = Rep >
+class scaled_quantity;
+
+/// namespace detail.
+
+namespace detail {
+
+/**
+ * the value of ratio R in type T.
+ */
+template< typename R, typename T >
+constexpr T scale_factor()
+{
+    return static_cast<T>( R::num ) / static_cast<T>( R::den );
+}
+
+/**
+ * factor to convert a magnitude in units of scale From to units of scale To.
+ */
+template< typename From, typename To, typename T >
+constexpr T conversion_factor()
+{
+    return scale_factor< std::ratio_divide<From, To>, T >();
+}
+
+/**
+ * R if scales S1 and S2 are equal, however spelled, e.g. std::ratio<381, 1250> and scales::foot.
+ */
+template< typename S1, typename S2, typename R >
+using EnableIfSameScale = typename std::enable_if< std::ratio_equal<S1, S2>::value, R >::type;
+
+/**
+ * a scaled_quantity is a quantity for the scalar operators of quantity.hpp.
+ */
+template< typename D, typename S, typename T >
+struct is_quantity< scaled_quantity<D, S, T> > : std::true_type {};
+
+} // namespace detail
+
+/// namespace scales: scales of common units not approved for use with SI, see other_units.hpp.
+
+namespace scales {
+
+typedef std::ratio<         254,     10000 > inch;
+typedef std::ratio<        3048,     10000 > foot;
+typedef std::ratio<        9144,     10000 > yard;
+typedef std::ratio<     1609344,      1000 > mile;
+typedef std::ratio<        1852,         1 > mile_nautical;
+
+typedef std::ratio<          60,         1 > minute;
+typedef std::ratio<        3600,         1 > hour;
+typedef std::ratio<       86400,         1 > day;
+
+typedef std::ratio<        1852,      3600 > knot;
+typedef std::ratio<        1000,      3600 > kilometer_per_hour;
+typedef std::ratio<     1609344,   3600000 > mile_per_hour;
+
+typedef std::ratio<    45359237, 100000000 > pound;
+typedef std::ratio<105505585262, 100000000 > btu_it;
+typedef std::ratio<       41868,     10000 > calorie_it;
+
+} // namespace scales
+
+/**
+ * \brief class "scaled_quantity" stores the magnitude of a quantity in units
+ * of Scale times the SI unit of Dims.
+ */
+template< typename Dims, typename Scale, typename T /*= Rep */ >
+class scaled_quantity
+{
+public:
+    typedef Dims dimension_type;
+
+    typedef Scale scale_type;
+
+    typedef T value_type;
+
+    typedef scaled_quantity<Dims, Scale, T> this_type;
+
+    constexpr scaled_quantity() : m_value{} { }
+
+    /**
+     * initializing constructor from a magnitude in units of Scale;
+     * requires magnitude_tag to prevent constructing a quantity from a raw magnitude.
+     */
+    template <typename X>
+    constexpr explicit scaled_quantity( detail::magnitude_tag_t, X x )
+    : m_value( x ) { }
+
+    /**
+     * converting constructor from a scaled quantity of the same scale, also if
+     * spelled differently, e.g. std::ratio<381, 1250> for scales::foot.
+     */
+    template <typename S, typename X, typename std::enable_if< std::ratio_equal<S, Scale>::value, int >::type = 0 >
+    constexpr scaled_quantity( scaled_quantity<Dims, S, X> const & x )
+    : m_value( x.magnitude() ) { }
+
+    /**
+     * converting constructor from a scaled quantity of a different scale.
+     */
+    template <typename S, typename X, typename std::enable_if< !std::ratio_equal<S, Scale>::value, int >::type = 0 >
+    constexpr scaled_quantity( scaled_quantity<Dims, S, X> const & x )
+    : m_value( x.magnitude() * detail::conversion_factor<S, Scale, T>() ) { }
+
+    /**
+     * converting constructor from a quantity in SI units.
+     */
+    template <typename X>
+    constexpr scaled_quantity( quantity<Dims, X> const & x )
+    : m_value( x.magnitude() * detail::conversion_factor<std::ratio<1>, Scale, T>() ) { }
+
+    /**
+     * conversion to a quantity in SI units.
+     */
+    constexpr operator quantity<Dims, T>() const
+    {
+        return quantity<Dims, T>( detail::magnitude_tag, m_value * detail::scale_factor<Scale, T>() );
+    }
+
+    /**
+     * the quantity in SI units.
+     */
+    constexpr quantity<Dims, T> si() const { return *this; }
+
+    /**
+     * the scaled quantity's magnitude, in units of Scale.
+     */
+    constexpr value_type magnitude() const { return m_value; }
+
+    /**
+     * the scaled quantity's dimensions.
+     */
+    constexpr dimension_type dimension() const { return dimension_type{}; }
+
+    /// squan += squan
+
+    template <typename S, typename Y>
+    detail::EnableIfSameScale< S, Scale, scaled_quantity & > operator+=( scaled_quantity<Dims, S, Y> const & y )
+    {
+        return m_value += y.magnitude(), *this;
+    }
+
+    /// squan -= squan
+
+    template <typename S, typename Y>
+    detail::EnableIfSameScale< S, Scale, scaled_quantity & > operator-=( scaled_quantity<Dims, S, Y> const & y )
+    {
+        return m_value -= y.magnitude(), *this;
+    }
+
+    /// squan *= num
+
+    template <typename Y>
+    scaled_quantity & operator*=( Y const & y )
+    {
+        return m_value *= y, *this;
+    }
+
+    /// squan /= num
+
+    template <typename Y>
+    scaled_quantity & operator/=( Y const & y )
+    {
+        return m_value /= y, *this;
+    }
+
+private:
+    T m_value;
+
+    static_assert( ! Dims::is_all_zero, "scaled quantity dimensions must not all be zero" );
+    static_assert( Scale::num > 0, "scale must be positive" );
+};
+
+/// convert to another scale with a single multiplication, e.g. scale_cast<scales::inch>( length_in_feet ).
+
+template <typename To, typename D, typename S, typename X>
+constexpr scaled_quantity<D, To, X>
+scale_cast( scaled_quantity<D, S, X> const & x )
+{
+    return scaled_quantity<D, To, X>( x );
+}
+
+/// convert a quantity in SI units to the given scale.
+
+template <typename To, typename D, typename X>
+constexpr scaled_quantity<D, To, X>
+scale_cast( quantity<D, X> const & x )
+{
+    return scaled_quantity<D, To, X>( x );
+}
+
+// Arithmetic within one scale, however spelled; mixed scales convert explicitly or via quantity.
+
+/// + squan
+
+template <typename D, typename S, typename X>
+constexpr scaled_quantity<D, S, X>
+operator+( scaled_quantity<D, S, X> const & x )
+{
+   return scaled_quantity<D, S, X>( detail::magnitude_tag, +x.magnitude() );
+}
+
+/// - squan
+
+template <typename D, typename S, typename X>
+constexpr scaled_quantity<D, S, X>
+operator-( scaled_quantity<D, S, X> const & x )
+{
+   return scaled_quantity<D, S, X>( detail::magnitude_tag, -x.magnitude() );
+}
+
+/// squan + squan
+
+template <typename D, typename S, typename S2, typename X, typename Y>
+constexpr detail::EnableIfSameScale< S, S2, scaled_quantity<D, S, detail::PromoteAdd<X,Y>> >
+operator+( scaled_quantity<D, S, X> const & x, scaled_quantity<D, S2, Y> const & y )
+{
+   return scaled_quantity<D, S, detail::PromoteAdd<X,Y>>( detail::magnitude_tag, x.magnitude() + y.magnitude() );
+}
+
+/// squan - squan
+
+template <typename D, typename S, typename S2, typename X, typename Y>
+constexpr detail::EnableIfSameScale< S, S2, scaled_quantity<D, S, detail::PromoteAdd<X,Y>> >
+operator-( scaled_quantity<D, S, X> const & x, scaled_quantity<D, S2, Y> const & y )
+{
+   return scaled_quantity<D, S, detail::PromoteAdd<X,Y>>( detail::magnitude_tag, x.magnitude() - y.magnitude() );
+}
+
+/// squan * num
+
+template <typename D, typename S, typename X, typename Y>
+constexpr scaled_quantity<D, S, detail::PromoteMulScalar<X,Y>>
+operator*( scaled_quantity<D, S, X> const & x, const Y & y )
+{
+   return scaled_quantity<D, S, detail::PromoteMulScalar<X,Y>>( detail::magnitude_tag, x.magnitude() * y );
+}
+
+/// num * squan
+
+template <typename D, typename S, typename X, typename Y>
+constexpr scaled_quantity<D, S, detail::PromoteMulScalar<X,Y>>
+operator*( const X & x, scaled_quantity<D, S, Y> const & y )
+{
+   return scaled_quantity<D, S, detail::PromoteMulScalar<X,Y>>( detail::magnitude_tag, x * y.magnitude() );
+}
+
+/// squan / num
+
+template <typename D, typename S, typename X, typename Y>
+constexpr scaled_quantity<D, S, detail::PromoteMulScalar<X,Y>>
+operator/( scaled_quantity<D, S, X> const & x, const Y & y )
+{
+   return scaled_quantity<D, S, detail::PromoteMulScalar<X,Y>>( detail::magnitude_tag, x.magnitude() / y );
+}
+
+/// squan / squan: the ratio of two quantities of the same scale.
+
+template <typename D, typename S, typename S2, typename X, typename Y>
+constexpr detail::EnableIfSameScale< S, S2, detail::PromoteMul<X,Y> >
+operator/( scaled_quantity<D, S, X> const & x, scaled_quantity<D, S2, Y> const & y )
+{
+   return x.magnitude() / y.magnitude();
+}
+
+// Comparison operators within one scale
+
+/// equality.
+
+template <typename D, typename S, typename S2, typename X, typename Y>
+constexpr detail::EnableIfSameScale< S, S2, bool >
+operator==( scaled_quantity<D, S, X> const & x, scaled_quantity<D, S2, Y> const & y )
+{
+   return x.magnitude() == y.magnitude();
+}
+
+/// inequality.
+
+template <typename D, typename S, typename S2, typename X, typename Y>
+constexpr detail::EnableIfSameScale< S, S2, bool >
+operator!=( scaled_quantity<D, S, X> const & x, scaled_quantity<D, S2, Y> const & y )
+{
+   return x.magnitude() != y.magnitude();
+}
+
+/// less-than.
+
+template <typename D, typename S, typename S2, typename X, typename Y>
+constexpr detail::EnableIfSameScale< S, S2, bool >
+operator<( scaled_quantity<D, S, X> const & x, scaled_quantity<D, S2, Y> const & y )
+{
+   return x.magnitude() < y.magnitude();
+}
+
+/// less-equal.
+
+template <typename D, typename S, typename S2, typename X, typename Y>
+constexpr detail::EnableIfSameScale< S, S2, bool >
+operator<=( scaled_quantity<D, S, X> const & x, scaled_quantity<D, S2, Y> const & y )
+{
+   return x.magnitude() <= y.magnitude();
+}
+
+/// greater-than.
+
+template <typename D, typename S, typename S2, typename X, typename Y>
+constexpr detail::EnableIfSameScale< S, S2, bool >
+operator>( scaled_quantity<D, S, X> const & x, scaled_quantity<D, S2, Y> const & y )
+{
+   return x.magnitude() > y.magnitude();
+}
+
+/// greater-equal.
+
+template <typename D, typename S, typename S2, typename X, typename Y>
+constexpr detail::EnableIfSameScale< S, S2, bool >
+operator>=( scaled_quantity<D, S, X> const & x, scaled_quantity<D, S2, Y> const & y )
+{
+   return x.magnitude() >= y.magnitude();
+}
+
+}} // namespace phys::units
+
+#endif // PHYS_UNITS_SCALED_QUANTITY_HPP_INCLUDED
+
+/*
+ * end of file
+ */
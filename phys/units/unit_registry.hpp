@@ -0,0 +1,481 @@
+/**
+ * \file unit_registry.hpp
+ *
+ * \brief   Run-time lookup of unit symbols such as "kWh", "mi/h" or "psi" by their factor and dimensions.
+ * \author  Martin Moene
+ * \date    16 October 2026
+ * \since   1.2
+ *
+ * This code is provided as-is, with no warrantee of correctness.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+/*
+ * from_chars() knows the SI symbols of unit_table in quantity_io_input.hpp.
+ * Configuration files and data feeds also use the common symbols of the
+ * units of other_units.hpp, such as mi, lb, psi and kWh. detail::registry_table
+ * lists those, with the same layout as unit_table.
+ *
+ * A unit_registry holds both tables. At construction it searches a seed for
+ * which a hash maps every symbol to its own slot: a perfect hash, so that
+ * looking up a symbol takes one hash and one comparison. intern() parses
+ * other text, such as "kg m/s^2" or "mi/h", with the grammar of from_chars()
+ * over the symbols of both tables and memoizes the result under the text in
+ * an open-addressing table. After that, find() returns the same unit for
+ * that text in O(1), without allocation:
+ *
+ *   unit_registry registry;
+ *
+ *   registered_unit const & unit = registry.intern( header_unit );  // once
+ *   dynamic_quantity<> const q   = make_quantity( value, unit );   // per value
+ *
+ * The units are interned: a registered_unit stays at its address for the
+ * life of the registry, and each text is stored once. find() may be called
+ * from several threads at once; intern() must not run concurrently with
+ * other calls. Units with an offset, such as degree Fahrenheit as a point
+ * on a scale, are not registered; see quantity_point.hpp.
+ */
+
+#ifndef PHYS_UNITS_UNIT_REGISTRY_HPP_INCLUDED
+#define PHYS_UNITS_UNIT_REGISTRY_HPP_INCLUDED
+
+#include "phys/units/dynamic_quantity.hpp"
+#include "phys/units/other_units.hpp"
+#include "phys/units/quantity_io_input.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+/// namespace phys.
+
+namespace phys {
+
+/// namespace units.
+
+namespace units {
+
+/// unit error, e.g. when a unit symbol is not known.
+
+struct unit_error : public quantity_error
+{
+    unit_error( std::string const text )
+        : quantity_error( text ) { }
+};
+
+/**
+ * \brief struct "registered_unit" is a unit interned in a unit_registry:
+ * its text, its factor to SI units and its dimensions.
+ */
+struct registered_unit
+{
+    char const *  symbol;
+    std::size_t   length;
+    long double   factor;
+    dimension_key key;
+
+    /// true if the unit has dimensions Dims.
+
+    template< typename Dims >
+    bool has_dimensions() const { return key == dimension_key::of<Dims>(); }
+};
+
+/// namespace detail.
+
+namespace detail {
+
+/**
+ * FNV-1a hash of a symbol, varied by seed.
+ */
+inline std::uint64_t symbol_hash( char const * text, std::size_t const length, std::uint64_t const seed )
+{
+    std::uint64_t hash = 0xcbf29ce484222325u ^ ( seed * 0x9e3779b97f4a7c15u );
+
+    for ( std::size_t i = 0; i < length; ++i )
+    {
+        hash ^= static_cast<unsigned char>( text[i] );
+        hash *= 0x100000001b3u;
+    }
+    return hash ^ ( hash >> 29 );
+}
+
+/// factor to SI units of a quantity or of a dimensionless number, such as degree_angle.
+
+template< typename D, typename T >
+constexpr long double registry_factor( quantity<D, T> const & q ) { return q.magnitude(); }
+
+constexpr long double registry_factor( Rep const x ) { return x; }
+
+/// dimensions of a quantity, or none for a number.
+
+template< typename Q >
+struct registry_dims { typedef dimensionless_d type; };
+
+template< typename D, typename T >
+struct registry_dims< quantity<D, T> > { typedef D type; };
+
+template< typename Q >
+using RegistryDims = typename registry_dims< typename std::decay<Q>::type >::type;
+
+/**
+ * unit_entry for symbol with the factor and dimensions of the constant q, so
+ * that the dimensions cannot differ from those of q.
+ */
+#define PHYS_UNITS_REGISTRY_ENTRY( symbol, prefixable, q ) \
+    { symbol, sizeof( symbol ) - 1, prefixable, registry_factor( q ), { \
+        RegistryDims< decltype( q ) >::dim1, RegistryDims< decltype( q ) >::dim2, \
+        RegistryDims< decltype( q ) >::dim3, RegistryDims< decltype( q ) >::dim4, \
+        RegistryDims< decltype( q ) >::dim5, RegistryDims< decltype( q ) >::dim6, \
+        RegistryDims< decltype( q ) >::dim7 } }
+
+/**
+ * common symbols of units that are not in unit_table, with the factors and
+ * dimensions of quantity.hpp and other_units.hpp.
+ */
+constexpr unit_entry registry_table[] =
+{
+    // length
+    PHYS_UNITS_REGISTRY_ENTRY( "mi",    false, mile ),
+    PHYS_UNITS_REGISTRY_ENTRY( "nmi",   false, mile_nautical ),
+    PHYS_UNITS_REGISTRY_ENTRY( "yd",    false, yard ),
+    PHYS_UNITS_REGISTRY_ENTRY( "ft",    false, foot ),
+    PHYS_UNITS_REGISTRY_ENTRY( "in",    false, inch ),
+    PHYS_UNITS_REGISTRY_ENTRY( "au",    false, astronomical_unit ),
+    PHYS_UNITS_REGISTRY_ENTRY( "ly",    false, light_year ),
+    PHYS_UNITS_REGISTRY_ENTRY( "pc",    true,  parsec ),
+
+    // area and volume
+    PHYS_UNITS_REGISTRY_ENTRY( "ha",    false, hectare ),
+    PHYS_UNITS_REGISTRY_ENTRY( "acre",  false, acre ),
+    PHYS_UNITS_REGISTRY_ENTRY( "l",     true,  liter ),
+    PHYS_UNITS_REGISTRY_ENTRY( "gal",   false, gallon_us ),  // not the unit of acceleration
+    PHYS_UNITS_REGISTRY_ENTRY( "bbl",   false, barrel ),
+
+    // mass and force
+    PHYS_UNITS_REGISTRY_ENTRY( "t",     true,  tonne ),
+    PHYS_UNITS_REGISTRY_ENTRY( "lb",    false, pound_avdp ),
+    PHYS_UNITS_REGISTRY_ENTRY( "oz",    false, ounce_avdp ),
+    PHYS_UNITS_REGISTRY_ENTRY( "slug",  false, slug ),
+    PHYS_UNITS_REGISTRY_ENTRY( "lbf",   false, pound_force ),
+    PHYS_UNITS_REGISTRY_ENTRY( "kgf",   false, kilogram_force ),
+    PHYS_UNITS_REGISTRY_ENTRY( "dyn",   false, dyne ),
+
+    // speed
+    PHYS_UNITS_REGISTRY_ENTRY( "mph",   false, mile / hour ),
+    PHYS_UNITS_REGISTRY_ENTRY( "kn",    false, knot ),
+
+    // pressure
+    PHYS_UNITS_REGISTRY_ENTRY( "bar",   true,  bar ),
+    PHYS_UNITS_REGISTRY_ENTRY( "psi",   false, psi ),
+    PHYS_UNITS_REGISTRY_ENTRY( "atm",   false, atmosphere_std ),
+    PHYS_UNITS_REGISTRY_ENTRY( "Torr",  false, torr ),
+    PHYS_UNITS_REGISTRY_ENTRY( "mmHg",  false, cm_mercury / 10 ),
+    PHYS_UNITS_REGISTRY_ENTRY( "inHg",  false, inches_mercury ),
+
+    // energy, power and charge
+    PHYS_UNITS_REGISTRY_ENTRY( "Wh",    true,  watt * hour ),
+    PHYS_UNITS_REGISTRY_ENTRY( "eV",    true,  electronvolt ),
+    PHYS_UNITS_REGISTRY_ENTRY( "cal",   true,  calorie_th ),
+    PHYS_UNITS_REGISTRY_ENTRY( "BTU",   false, btu_it ),
+    PHYS_UNITS_REGISTRY_ENTRY( "Btu",   false, btu_it ),
+    PHYS_UNITS_REGISTRY_ENTRY( "erg",   false, erg ),
+    PHYS_UNITS_REGISTRY_ENTRY( "therm", false, therm_us ),
+    PHYS_UNITS_REGISTRY_ENTRY( "hp",    false, horsepower ),
+    PHYS_UNITS_REGISTRY_ENTRY( "Ah",    true,  ampere * hour ),
+
+    // angle and rotation
+    PHYS_UNITS_REGISTRY_ENTRY( "deg",   false, degree_angle ),
+    PHYS_UNITS_REGISTRY_ENTRY( "rpm",   false, rpm ),
+};
+
+#undef PHYS_UNITS_REGISTRY_ENTRY
+
+} // namespace detail
+
+/**
+ * \brief class "unit_registry" looks up unit symbols and compound units given
+ * as text by their factor to SI units and their dimensions.
+ */
+class unit_registry
+{
+public:
+    /**
+     * the registry of the symbols of unit_table and detail::registry_table.
+     */
+    unit_registry()
+    : unit_registry( detail::registry_table, detail::registry_table + sizeof detail::registry_table / sizeof detail::registry_table[0] ) { }
+
+    /**
+     * the registry of the symbols of unit_table and of [first, last), which must
+     * stay valid for the life of the registry; throws unit_error for a symbol
+     * that occurs twice.
+     */
+    unit_registry( detail::unit_entry const * first, detail::unit_entry const * last )
+    : m_units(), m_texts(), m_entries(), m_perfect(), m_seed( 0 ), m_memo(), m_memo_count( 0 )
+    {
+        for ( detail::unit_entry const & entry : detail::unit_table )
+        {
+            if ( entry.length > 0 )
+                add_entry( entry );
+        }
+
+        for ( ; first != last; ++first )
+            add_entry( *first );
+
+        build_perfect_hash();
+    }
+
+    unit_registry( unit_registry const & ) = delete;
+
+    unit_registry & operator=( unit_registry const & ) = delete;
+
+    unit_registry( unit_registry && ) = default;
+
+    unit_registry & operator=( unit_registry && ) = default;
+
+    /**
+     * number of units, symbols and interned texts.
+     */
+    std::size_t size() const { return m_units.size(); }
+
+    /**
+     * the unit with text [first, last) if it is a symbol or has been interned,
+     * otherwise nullptr; O(1), without allocation.
+     */
+    registered_unit const * find( char const * first, char const * last ) const
+    {
+        std::size_t const length = static_cast<std::size_t>( last - first );
+
+        std::uint64_t const hash = detail::symbol_hash( first, length, m_seed );
+
+        if ( std::size_t const i = m_perfect[ hash & ( m_perfect.size() - 1 ) ] )
+        {
+            if ( equal( m_units[i - 1], first, length ) )
+                return &m_units[i - 1];
+        }
+
+        if ( m_memo.empty() )
+            return nullptr;
+
+        std::size_t const mask = m_memo.size() - 1;
+
+        for ( std::size_t slot = memo_slot( hash ) & mask; ; slot = ( slot + 1 ) & mask )
+        {
+            std::size_t const i = m_memo[slot];
+
+            if ( i == 0 )
+                return nullptr;
+
+            if ( equal( m_units[i - 1], first, length ) )
+                return &m_units[i - 1];
+        }
+    }
+
+    registered_unit const * find( std::string const & text ) const
+    {
+        return find( text.data(), text.data() + text.size() );
+    }
+
+    /**
+     * the unit with text [first, last), e.g. "kg m/s^2", parsed as by from_chars()
+     * on first use and remembered; throws unit_error if the text is not a unit.
+     */
+    registered_unit const & intern( char const * first, char const * last )
+    {
+        if ( registered_unit const * const unit = find( first, last ) )
+            return *unit;
+
+        detail::unit_value value;
+
+        from_chars_result const result = detail::parse_unit( first, last, value, lookup( *this ) );
+
+        if ( result.ec != std::errc() || result.ptr != last )
+            throw unit_error( "unit_registry: unknown unit '" + std::string( first, last ) + "'" );
+
+        dimension_key const key = dimension_key::from_exponents( value.dims );
+
+        m_texts.emplace_back( first, last );
+
+        registered_unit const unit = { m_texts.back().c_str(), m_texts.back().size(), value.factor, key };
+
+        m_units.push_back( unit );
+        memoize( m_units.size() );
+
+        return m_units.back();
+    }
+
+    registered_unit const & intern( std::string const & text )
+    {
+        return intern( text.data(), text.data() + text.size() );
+    }
+
+private:
+    /// symbol lookup for parse_unit() in the perfect hash.
+
+    struct lookup
+    {
+        explicit lookup( unit_registry const & registry ) : registry( registry ) { }
+
+        detail::unit_entry const * operator()( char const * text, std::size_t const length ) const
+        {
+            std::size_t const i = registry.m_perfect[ detail::symbol_hash( text, length, registry.m_seed ) & ( registry.m_perfect.size() - 1 ) ];
+
+            return i != 0 && equal( registry.m_units[i - 1], text, length ) ? registry.m_entries[i - 1] : nullptr;
+        }
+
+        unit_registry const & registry;
+    };
+
+    /// the memo uses the high bits of the hash of the perfect hash, so that a lookup hashes once.
+
+    static std::size_t memo_slot( std::uint64_t const hash )
+    {
+        return static_cast<std::size_t>( hash >> 32 );
+    }
+
+    static bool equal( registered_unit const & unit, char const * text, std::size_t const length )
+    {
+        return unit.length == length && std::memcmp( unit.symbol, text, length ) == 0;
+    }
+
+    void add_entry( detail::unit_entry const & entry )
+    {
+        int exponents[7];
+
+        for ( int i = 0; i < 7; ++i )
+            exponents[i] = entry.dims[i];
+
+        registered_unit const unit = { entry.symbol, entry.length, entry.factor, dimension_key::from_exponents( exponents ) };
+
+        m_units.push_back( unit );
+        m_entries.push_back( &entry );
+    }
+
+    /**
+     * find a seed for which all symbols hash to their own slot, in a table of
+     * at least twice as many slots as symbols, doubled after 64 seeds.
+     */
+    void build_perfect_hash()
+    {
+        std::size_t const n = m_units.size();
+
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            for ( std::size_t k = 0; k < i; ++k )
+            {
+                if ( equal( m_units[k], m_units[i].symbol, m_units[i].length ) )
+                    throw unit_error( "unit_registry: duplicate symbol '" + std::string( m_units[i].symbol ) + "'" );
+            }
+        }
+
+        for ( std::size_t size = 2; ; size *= 2 )
+        {
+            if ( size < 2 * n )
+                continue;
+
+            for ( std::uint64_t seed = 1; seed <= 64; ++seed )
+            {
+                std::vector<std::uint32_t> slots( size );
+
+                std::size_t i = 0;
+
+                for ( ; i < n; ++i )
+                {
+                    std::uint32_t & slot = slots[ detail::symbol_hash( m_units[i].symbol, m_units[i].length, seed ) & ( size - 1 ) ];
+
+                    if ( slot != 0 )
+                        break;
+
+                    slot = static_cast<std::uint32_t>( i + 1 );
+                }
+
+                if ( i == n )
+                {
+                    m_perfect.swap( slots );
+                    m_seed = seed;
+                    return;
+                }
+            }
+        }
+    }
+
+    /**
+     * enter unit i + 1 in the open-addressing table, kept at most half full.
+     */
+    void memoize( std::size_t const i )
+    {
+        if ( 2 * ( m_memo_count + 1 ) > m_memo.size() )
+        {
+            std::vector<std::uint32_t> old( std::max<std::size_t>( 16, 2 * m_memo.size() ) );
+            old.swap( m_memo );
+
+            for ( std::uint32_t const k : old )
+            {
+                if ( k != 0 )
+                    insert( k );
+            }
+        }
+
+        insert( static_cast<std::uint32_t>( i ) );
+        ++m_memo_count;
+    }
+
+    void insert( std::uint32_t const i )
+    {
+        registered_unit const & unit = m_units[i - 1];
+
+        std::size_t const mask = m_memo.size() - 1;
+
+        std::size_t slot = memo_slot( detail::symbol_hash( unit.symbol, unit.length, m_seed ) ) & mask;
+
+        while ( m_memo[slot] != 0 )
+            slot = ( slot + 1 ) & mask;
+
+        m_memo[slot] = i;
+    }
+
+private:
+    std::deque<registered_unit> m_units;
+    std::deque<std::string> m_texts;
+    std::vector<detail::unit_entry const *> m_entries;
+    std::vector<std::uint32_t> m_perfect;
+    std::uint64_t m_seed;
+    std::vector<std::uint32_t> m_memo;
+    std::size_t m_memo_count;
+};
+
+/**
+ * the factor that converts a number in unit from to unit to; throws
+ * dimension_error if the units have different dimensions.
+ */
+inline long double conversion_factor( registered_unit const & from, registered_unit const & to )
+{
+    detail::require_same( from.key, to.key );
+
+    return from.factor / to.factor;
+}
+
+/**
+ * the quantity value in unit, in SI units.
+ */
+template< typename T >
+dynamic_quantity<T> make_quantity( T const value, registered_unit const & unit )
+{
+    return dynamic_quantity<T>( detail::magnitude_tag, static_cast<T>( value * unit.factor ), unit.key );
+}
+
+}} // namespace phys::units
+
+#endif // PHYS_UNITS_UNIT_REGISTRY_HPP_INCLUDED
+
+/*
+ * end of file
+ */
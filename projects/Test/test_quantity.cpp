@@ -17,8 +17,16 @@
 //#define TEST_COMPILE_TIME
 
 #include "phys/units/quantity.hpp"
+#include "phys/units/fixed_point.hpp"
+#include "phys/units/float16.hpp"
+#include "phys/units/quantity_convert.hpp"
+#include "phys/units/quantity_point.hpp"
 #include "phys/units/io_output_eng.hpp"
 #include "phys/units/other_units.hpp"
+#include "phys/units/scaled_quantity.hpp"
+
+#include <array>
+#include <vector>
 
 #include "test_util.hpp"  // include before lest.hpp
 
@@ -348,6 +356,14 @@ const lest::test functions[] =
 
         EXPECT( s( square( f1 ) ) == "4.000000 m+2 kg+2 s-4" );
         EXPECT( s( cube(   f1 ) ) == "8.000000 m+3 kg+3 s-6" );
+
+        // powers are evaluated by multiplication, also at compile time
+
+        constexpr quantity<volume_d> v = nth_power<3>( 2 * meter );
+
+        EXPECT( v.magnitude() == 8 );
+        EXPECT( nth_power<5>( 3 * meter ).magnitude() == 3 * 3 * 3 * 3 * 3 );
+        EXPECT( nth_power<-3>( 2 * meter ).magnitude() == 0.125 );
     },
 
     "quantity root functions", []
@@ -363,6 +379,12 @@ const lest::test functions[] =
         EXPECT( s( nth_root<-2>( hv ) ) == "0.010000 m-2" );
         EXPECT( s( nth_root<-4>( hv ) ) == "0.100000 m-1" );
 
+        quantity<dimensions< 6, 0, 0 > > sv( 64 * cube( square( meter ) ) );
+
+        EXPECT( s( nth_root< 6>( sv ) ) == "2.000000 m" );
+        EXPECT( s( nth_root< 3>( sv ) ) == "4.000000 m+2" );
+        EXPECT( s( nth_root<-3>( sv ) ) == "0.250000 m-2" );
+
         // special roots
 
         EXPECT( s( sqrt( hv ) ) == "100.000000 m+2" );
@@ -472,6 +494,22 @@ const lest::test ud_literals[] =
         EXPECT( to_string( 1._ys ) == "1.00 ys" );
     },
 
+    "cooked literals with float and double magnitude", []
+    {
+        using namespace phys::units::literals;
+
+        auto const f = f32::operator "" _km( 1.5L );
+        auto const d = f64::operator "" _ms( 20ULL );
+
+        static_assert( std::is_same< decltype( f ), quantity<length_d, float> const >::value, "float literal" );
+        static_assert( std::is_same< decltype( d ), quantity<time_interval_d, double> const >::value, "double literal" );
+        static_assert( std::is_same< decltype( 2.0f * f ), quantity<length_d, float> >::value, "no promotion" );
+
+        EXPECT( f.magnitude() == 1500.0f );
+        EXPECT( d.magnitude() == 0.02 );
+        EXPECT( s( f64::operator "" _kg( 2ULL ) ) == "2.000000 kg" );
+    },
+
     "cooked literals defects", []
     {
         // prefix smaller than 1 with integral type
@@ -479,6 +517,352 @@ const lest::test ud_literals[] =
     },
 };
 
+const lest::test scaled_quantities[] =
+{
+    "scaled quantity stores its magnitude in units of its scale", []
+    {
+        scaled_quantity<length_d, scales::foot> const length( detail::magnitude_tag, 10 );
+
+        EXPECT( length.magnitude() == 10 );
+        EXPECT( s( length.si() ) == "3.048000 m" );
+        EXPECT( s( quantity<length_d>( length ) ) == "3.048000 m" );
+    },
+
+    "scaled quantity converts with one multiplication by an exact factor", []
+    {
+        constexpr scaled_quantity<length_d, scales::foot> length( detail::magnitude_tag, 1 );
+
+        constexpr scaled_quantity<length_d, scales::inch> in = length;
+        constexpr scaled_quantity<length_d, std::milli  > mm = scale_cast<std::milli>( length );
+
+        static_assert( detail::conversion_factor<scales::foot, scales::inch, double>() == 12, "exact factor" );
+
+        EXPECT( in.magnitude() == 12 );
+        EXPECT( mm.magnitude() == 304.8 );
+        EXPECT_THAT( scale_cast<scales::foot>( 1 * mile ).magnitude(), close_to( 5280.0, 1e-9 ) );
+        EXPECT_THAT( scale_cast<scales::knot>( 1852 * meter / hour ).magnitude(), close_to( 1.0, 1e-12 ) );
+    },
+
+    "scaled quantity arithmetic within one scale", []
+    {
+        typedef scaled_quantity<energy_d, scales::btu_it> btu;
+
+        btu a( detail::magnitude_tag, 3 );
+        btu b( detail::magnitude_tag, 4 );
+
+        EXPECT( ( a + b ).magnitude() == 7 );
+        EXPECT( ( b - a ).magnitude() == 1 );
+        EXPECT( ( 2 * a ).magnitude() == 6 );
+        EXPECT( ( a * 2 ).magnitude() == 6 );
+        EXPECT( ( b / 2 ).magnitude() == 2 );
+        EXPECT( ( b / a ) == 4.0 / 3 );
+        EXPECT( ( -a ).magnitude() == -3 );
+
+        EXPECT( ( a += b ).magnitude() == 7 );
+        EXPECT( ( a -= b ).magnitude() == 3 );
+        EXPECT( ( a *= 2 ).magnitude() == 6 );
+        EXPECT( ( a /= 3 ).magnitude() == 2 );
+    },
+
+    "scaled quantity comparison within one scale", []
+    {
+        typedef scaled_quantity<time_interval_d, scales::hour> hours;
+
+        hours const h1( detail::magnitude_tag, 1 );
+        hours const h2( detail::magnitude_tag, 2 );
+
+        EXPECT( ( h1 == h1 ) );
+        EXPECT( ( h1 != h2 ) );
+        EXPECT( ( h1 <  h2 ) );
+        EXPECT( ( h1 <= h2 ) );
+        EXPECT( ( h2 >  h1 ) );
+        EXPECT( ( h2 >= h1 ) );
+    },
+
+    "scaled quantity treats equal scales as one scale, however spelled", []
+    {
+        typedef scaled_quantity<length_d, scales::foot           > foot;
+        typedef scaled_quantity<length_d, std::ratio<381, 1250>  > reduced_foot;
+
+        constexpr foot         f( detail::magnitude_tag, 3 );
+        constexpr reduced_foot r = f;
+        constexpr foot         g = r;
+
+        EXPECT( r.magnitude() == 3 );
+        EXPECT( g.magnitude() == 3 );
+        EXPECT( ( f + r ).magnitude() == 6 );
+        EXPECT( ( f - r ).magnitude() == 0 );
+        EXPECT( ( f / r ) == 1 );
+        EXPECT( ( f == r ) );
+        EXPECT( ( r <= f ) );
+
+        foot h( detail::magnitude_tag, 1 );
+
+        EXPECT( ( h += r ).magnitude() == 4 );
+        EXPECT( ( h -= r ).magnitude() == 1 );
+    },
+};
+
+const lest::test fixed_points[] =
+{
+    "fixed point converts to and from integers and floating point", []
+    {
+        constexpr q16_16 x( 1.5 );
+
+        static_assert( x.raw() == 0x18000, "1.5 in Q16.16" );
+
+        EXPECT( q16_16( 3 ).raw() == 3 * 65536 );
+        EXPECT( q16_16( -0.1 ).raw() == -6554 );
+        EXPECT( static_cast<double>( q16_16( 0.25 ) ) == 0.25 );
+        EXPECT( q8_8( 200 ).raw() == 32767 );
+        EXPECT( q8_8( -200.0 ).raw() == -32768 );
+        EXPECT( q8_8( std::nan( "" ) ).raw() == 0 );
+    },
+
+    "fixed point arithmetic shifts the product and the dividend", []
+    {
+        q16_16 const a( 1.5 );
+        q16_16 const b( 2.25 );
+
+        EXPECT( ( a * b == q16_16( 3.375 ) ) );
+        EXPECT( ( b / a == q16_16( 1.5 ) ) );
+        EXPECT( ( a + b == q16_16( 3.75 ) ) );
+        EXPECT( ( a - b == q16_16( -0.75 ) ) );
+        EXPECT( ( a * 4 == q16_16( 6 ) ) );
+        EXPECT( ( 4 * a == q16_16( 6 ) ) );
+        EXPECT( ( b / 3 == q16_16( 0.75 ) ) );
+        EXPECT( ( 3 / a == q16_16( 2 ) ) );
+        EXPECT( ( q16_16::from_raw( 1 ) * q16_16( 0.5 ) == q16_16::from_raw( 1 ) ) );
+    },
+
+    "fixed point arithmetic saturates", []
+    {
+        q8_8 const big( 100 );
+        q8_8 const max = q8_8::from_raw( 32767 );
+        q8_8 const min = q8_8::from_raw( -32768 );
+
+        EXPECT( ( big + big == max ) );
+        EXPECT( ( -big - big == min ) );
+        EXPECT( ( big * big == max ) );
+        EXPECT( ( big * -3 == min ) );
+        EXPECT( ( big / q8_8( 0.25 ) == max ) );
+        EXPECT( ( big / q8_8() == max ) );
+        EXPECT( ( -big / 0 == min ) );
+        EXPECT( ( -min == max ) );
+    },
+
+    "quantity with fixed-point representation", []
+    {
+        typedef quantity<length_d, q16_16> length;
+
+        constexpr length d = 2.5 * meter;
+        quantity<time_interval_d, q16_16> const t = 0.5 * second;
+
+        auto const v = d / t;
+
+        static_assert( std::is_same< decltype( v ), quantity<speed_d, q16_16> const >::value, "fixed-point speed" );
+
+        EXPECT( ( v.magnitude() == q16_16( 5 ) ) );
+        EXPECT( ( d * d / d == d ) );
+        EXPECT( ( abs( -d ) == d ) );
+        EXPECT( ( sqrt( d * d ) == d ) );
+        EXPECT( ( nth_root<4>( square( d * d ) ) == d ) );
+        EXPECT( ( nth_root<3>( d * d * d ) == d ) );
+        EXPECT( ( 2 * d - d == d ) );
+        EXPECT( quantity<speed_d>( v ) == 5.0 * meter / second );
+    },
+};
+
+const lest::test storage_types[] =
+{
+    "half and bfloat16 round to nearest even", []
+    {
+        EXPECT( half( 1 + 1.0f / 2048 ).bits() == 0x3c00 );
+        EXPECT( half( 1 + 3.0f / 2048 ).bits() == 0x3c02 );
+        EXPECT( half( 65519.0f ).bits() == 0x7bff );
+        EXPECT( half( 65520.0f ).bits() == 0x7c00 );
+        EXPECT( half( -3e-8f ).bits() == 0x8001 );
+        EXPECT( std::isnan( float( half( std::nanf( "" ) ) ) ) );
+
+        EXPECT( bfloat16( 1 + 1.0f / 256 ).bits() == 0x3f80 );
+        EXPECT( bfloat16( 1 + 3.0f / 256 ).bits() == 0x3f82 );
+        EXPECT( bfloat16( 1e38f ).bits() == 0x7e96 );
+        EXPECT( std::isnan( float( bfloat16( std::nanf( "" ) ) ) ) );
+    },
+
+    "half and bfloat16 round a double once", []
+    {
+        double const h = 1 + std::ldexp( 1.0, -11 ) + std::ldexp( 1.0, -40 );
+        double const b = 1 + std::ldexp( 1.0, -8  ) + std::ldexp( 1.0, -40 );
+
+        EXPECT( half( h ).bits() == 0x3c01 );
+        EXPECT( half( -h ).bits() == 0xbc01 );
+        EXPECT( half( 1 + std::ldexp( 1.0, -11 ) ).bits() == 0x3c00 );
+        EXPECT( half( 65520.0 ).bits() == 0x7c00 );
+        EXPECT( half( 1e300 ).bits() == 0x7c00 );
+        EXPECT( half( 1e-300 ).bits() == 0x0000 );
+        EXPECT( half( 2 ).bits() == 0x4000 );
+        EXPECT( std::isnan( float( half( std::nan( "" ) ) ) ) );
+
+        EXPECT( bfloat16( b ).bits() == 0x3f81 );
+        EXPECT( bfloat16( 1e300 ).bits() == 0x7f80 );
+
+        quantity<pressure_d> const p( detail::magnitude_tag, h );
+        quantity<pressure_d, half> stored;
+
+        convert( &p, &p + 1, &stored );
+
+        EXPECT( stored.magnitude().bits() == 0x3c01 );
+    },
+
+    "half and bfloat16 convert every number exactly to float and back", []
+    {
+        int failures = 0;
+
+        for ( unsigned bits = 0; bits < 0x10000; ++bits )
+        {
+            half     const h = half    ::from_bits( static_cast<std::uint16_t>( bits ) );
+            bfloat16 const b = bfloat16::from_bits( static_cast<std::uint16_t>( bits ) );
+
+            failures += !std::isnan( float( h ) ) && half    ( float( h ) ).bits() != bits;
+            failures += !std::isnan( float( b ) ) && bfloat16( float( b ) ).bits() != bits;
+        }
+        EXPECT( failures == 0 );
+        EXPECT( float( half::from_bits( 0x0001 ) ) == std::ldexp( 1.0f, -24 ) );
+        EXPECT( float( half::from_bits( 0xfbff ) ) == -65504.0f );
+    },
+
+    "quantity with 16-bit storage widens to float in arithmetic", []
+    {
+        quantity<thermodynamic_temperature_d, half> t = 293.15 * kelvin;
+        quantity<pressure_d, bfloat16> const p = 101325 * pascal;
+
+        static_assert( sizeof( t ) == 2, "two bytes of storage" );
+        static_assert( std::is_same< decltype( t + t ), quantity<thermodynamic_temperature_d, float> >::value, "sum in float" );
+        static_assert( std::is_same< decltype( p / t ), decltype( quantity<pressure_d, float>() / quantity<thermodynamic_temperature_d, float>() ) >::value, "quotient in float" );
+        static_assert( std::is_same< decltype( 2.0 * t ), quantity<thermodynamic_temperature_d, double> >::value, "double scalar wins" );
+
+        EXPECT( t.magnitude() == 293.25f );
+        EXPECT( p.magnitude() == 101376.0f );
+        EXPECT( ( t + t ).magnitude() == 586.5f );
+
+        t += 1 * kelvin;
+
+        EXPECT( t.magnitude() == 294.25f );
+    },
+
+    "convert narrows and widens arrays of quantities", []
+    {
+        std::vector< quantity<length_d, float> > samples;
+
+        for ( int i = 0; i < 100; ++i )
+        {
+            samples.push_back( quantity<length_d, float>( detail::magnitude_tag, 0.5f * i ) );
+        }
+
+        std::vector< quantity<length_d, half> > stored( samples.size() );
+        std::vector< quantity<length_d, float> > restored( samples.size() );
+
+        EXPECT( convert( samples.data(), samples.data() + samples.size(), stored.data() ) == stored.data() + stored.size() );
+
+        convert( stored.data(), stored.data() + stored.size(), restored.data() );
+
+        EXPECT( ( restored == samples ) );
+    },
+};
+
+const lest::test conversions[] =
+{
+    "conversion_factor is the ratio of units of the same dimensions", []
+    {
+        EXPECT( conversion_factor( foot, meter ) == 0.3048 );
+        EXPECT( conversion_factor( bar, pascal ) == 1e5 );
+        EXPECT( std::abs( conversion_factor( psi, bar ) - 0.06894757 ) < 1e-12 );
+    },
+
+    "convert converts arrays of numbers from one unit to another", []
+    {
+        std::vector<double> const feet = { 1, 2, 10, -4 };
+        std::vector<double> meters( feet.size() );
+
+        convert( feet, foot, meter, meters );
+
+        EXPECT( meters[0] == 0.3048 );
+        EXPECT( meters[2] == 3.048 );
+        EXPECT( meters[3] == -1.2192 );
+
+        std::array<float, 3> gallons = {{ 1, 2, 4 }};
+
+        EXPECT( convert( gallons.data(), gallons.data() + gallons.size(), gallon_us, liter, gallons.data() ) == gallons.data() + 3 );
+        EXPECT( std::abs( gallons[2] - 15.141648f ) < 1e-5f );
+    },
+
+    "conversion_table converts between units chosen at run time", []
+    {
+        conversion_table<pressure_d> const table = { pascal, bar, psi };
+
+        std::vector<double> const in = { 1, 2 };
+        std::vector<double> out( in.size() );
+
+        table.convert( in, 1, 0, out );
+
+        EXPECT( table.size() == 3u );
+        EXPECT( table.factor( 0, 0 ) == 1 );
+        EXPECT( table.factor( 2, 1 ) == conversion_factor( psi, bar ) );
+        EXPECT( out[1] == 2e5 );
+    },
+};
+
+const lest::test temperature_points[] =
+{
+    "quantity_point converts between temperature scales", []
+    {
+        celsius_point<> const t = make_point<origins::celsius>( 100.0 );
+
+        EXPECT( std::abs( fahrenheit_point<>( t ).magnitude() - 212.0 ) < 1e-12 );
+        EXPECT( std::abs( point_cast<origins::kelvin>( t ).magnitude() - 373.15 ) < 1e-12 );
+        EXPECT( std::abs( point_cast<origins::celsius>( make_point<origins::fahrenheit>( -40.0 ) ).magnitude() + 40.0 ) < 1e-12 );
+        EXPECT( std::abs( point_cast<origins::rankine>( make_point<origins::kelvin>( 0.0 ) ).magnitude() ) < 1e-12 );
+        EXPECT( std::abs( t.si().magnitude() - 373.15 ) < 1e-12 );
+        EXPECT( std::abs( celsius_point<>( 273.15 * kelvin ).magnitude() ) < 1e-12 );
+    },
+
+    "quantity_point distinguishes points and differences", []
+    {
+        celsius_point<> const cold = make_point<origins::celsius>( 10.0 );
+        celsius_point<> const warm = make_point<origins::celsius>( 30.0 );
+
+        EXPECT( ( warm - cold == 20 * kelvin ) );
+        EXPECT( ( cold + 20 * kelvin == warm ) );
+        EXPECT( ( warm - 20 * kelvin == cold ) );
+        EXPECT( ( cold < warm ) );
+
+        fahrenheit_point<> f = make_point<origins::fahrenheit>( 50.0 );
+        f += 10 * kelvin;
+
+        EXPECT( std::abs( f.magnitude() - 68.0 ) < 1e-12 );
+        EXPECT( std::abs( ( make_point<origins::fahrenheit>( 212.0 ) - make_point<origins::fahrenheit>( 32.0 ) ).magnitude() - 100.0 ) < 1e-12 );
+    },
+
+    "convert_points converts arrays of sensor samples with one multiply-add", []
+    {
+        std::vector<double> const fahrenheit = { 32, 212, -40 };
+        std::vector<double> kelvins( fahrenheit.size() );
+
+        EXPECT( ( convert_points<origins::fahrenheit, origins::kelvin>( fahrenheit.data(), fahrenheit.data() + 3, kelvins.data() ) == kelvins.data() + 3 ) );
+        EXPECT( std::abs( kelvins[0] - 273.15 ) < 1e-12 );
+        EXPECT( std::abs( kelvins[1] - 373.15 ) < 1e-12 );
+        EXPECT( std::abs( kelvins[2] - 233.15 ) < 1e-12 );
+
+        std::array< celsius_point<>, 2 > const celsius = {{ make_point<origins::celsius>( 0.0 ), make_point<origins::celsius>( 37.0 ) }};
+        std::array< fahrenheit_point<>, 2 > out;
+
+        convert( celsius.data(), celsius.data() + 2, out.data() );
+
+        EXPECT( std::abs( out[1].magnitude() - 98.6 ) < 1e-12 );
+    },
+};
+
 const lest::test units[] =
 {
     "base units", []
@@ -781,6 +1165,11 @@ int main()
     + lest::run( functions )
     + lest::run( prefixes )
     + lest::run( ud_literals )
+    + lest::run( scaled_quantities )
+    + lest::run( fixed_points )
+    + lest::run( storage_types )
+    + lest::run( conversions )
+    + lest::run( temperature_points )
     + lest::run( units )
     ;
 
@@ -19,6 +19,18 @@
 #include "phys/units/quantity.hpp"
 #include "phys/units/io_symbols.hpp"
 #include "phys/units/io_output_eng.hpp"
+#include "phys/units/io_input.hpp"
+#include "phys/units/dynamic_quantity.hpp"
+#include "phys/units/quantity_io_binary.hpp"
+#include "phys/units/quantity_io_csv.hpp"
+#include "phys/units/unit_registry.hpp"
+
+#include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <random>
 
 #include "test_util.hpp"  // include before lest.hpp
 
@@ -32,6 +44,67 @@
 using namespace phys::units;
 using namespace phys::units::literals;
 
+/// parse text, require all text to be consumed on success.
+
+template< typename Q >
+std::errc parse( std::string const & text, Q & q )
+{
+    from_chars_result const result = from_chars( text.data(), text.data() + text.size(), q );
+
+    return result.ec == std::errc() && result.ptr != text.data() + text.size() ? std::errc::invalid_argument : result.ec;
+}
+
+/// LC_NUMERIC with a decimal comma while in scope, if such a locale is installed.
+
+class decimal_comma_locale
+{
+public:
+    decimal_comma_locale() : m_active( false )
+    {
+        for ( char const * name : { "de_DE.UTF-8", "de_DE.utf8", "de_DE", "nl_NL.UTF-8", "fr_FR.UTF-8" } )
+        {
+            if ( std::setlocale( LC_NUMERIC, name ) && *std::localeconv()->decimal_point == ',' )
+            {
+                m_active = true;
+                return;
+            }
+        }
+        std::setlocale( LC_NUMERIC, "C" );
+    }
+
+    ~decimal_comma_locale() { std::setlocale( LC_NUMERIC, "C" ); }
+
+    decimal_comma_locale( decimal_comma_locale const & ) = delete;
+
+    decimal_comma_locale & operator=( decimal_comma_locale const & ) = delete;
+
+    bool active() const { return m_active; }
+
+private:
+    bool m_active;
+};
+
+/// dimensions found by dispatch().
+
+struct which_dimensions
+{
+    int & found;
+
+    void operator()( length_d ) const { found = 1; }
+    void operator()( speed_d  ) const { found = 2; }
+};
+
+/// text written by to_chars(), or the error message.
+
+template< typename Dims, typename T >
+std::string tc( quantity<Dims, T> const & q, std::size_t const size = 64 )
+{
+    char text[64];
+    to_chars_result const result = to_chars( text, text + size, q );
+
+    return result.ec == std::errc() ? std::string( text, result.ptr ) : lest::to_string( result.ec );
+}
+
 const lest::test output[] =
 {
     "quantity output conversions", []
@@ -65,11 +138,200 @@ const lest::test output[] =
         EXPECT( os.str() == "1.23 km" );
     },
 
+    "quantity engineering stream output honours width, fill and adjustment", []
+    {
+        using namespace phys::units::io::eng;
+
+        std::ostringstream os;
+        os << "[" << std::setw( 10 ) << 12.5 * meter << "]";
+        os << "[" << std::setw( 10 ) << std::left << std::setfill( '*' ) << 12.5 * meter << "]" << std::setw( 0 ) << 1;
+
+        EXPECT( os.str() == "[    12.5 m][12.5 m****]1" );
+    },
+
+    "quantity engineering output to character buffer", []
+    {
+        using namespace phys::units::io::eng;
+
+        char text[16];
+
+        to_chars_result result = to_engineering_chars( text, text + sizeof text, 1.23_km );
+        EXPECT( std::string( text, result.ptr ) == "1.23 km" );
+        EXPECT( result.ec == std::errc() );
+
+        result = to_engineering_chars( text, text + 4, 1.23_km );
+        EXPECT( result.ec == std::errc::value_too_large );
+
+        EXPECT( to_string( 999.9 * meter ) == "1000 m" );
+        EXPECT( to_string( 1e-3 * meter ) == "1.00 mm" );
+        EXPECT( to_string( -0.0 * meter ) == "-0.00 m" );
+        EXPECT( to_string( 2.5e30 * meter ) == "2.50e30 m" );
+        EXPECT( to_string( 12.5 * newton, 2, true, true ) == "+12e0 N" );
+        EXPECT( to_engineering_string( 0.5, 3, false, false, "m s-1" ) == "500 m(m s-1)" );
+        EXPECT( to_engineering_string( std::numeric_limits<double>::infinity() ) == "INFINITE" );
+    },
+
+    "quantity unit symbols are compile-time constants", []
+    {
+        static_assert( unit_info< dimensions<1, 2, -1> >::c_symbol()[0] == 'm', "c_symbol() must be constexpr" );
+        static_assert( unit_info< force_d >::c_symbol()[0] == 'N', "c_symbol() must be constexpr" );
+
+        EXPECT( std::string( unit_info< dimensions<1, 2, -1> >::c_symbol() ) == "m kg+2 s-1" );
+        EXPECT( std::string( unit_info< dimensions<0, 0, 12, 0, 0, -10, 1> >::c_symbol() ) == "s+12 mol-10 cd" );
+        EXPECT( std::string( unit_info< dimensions<0, 0, 0, 0, 0, 0, 0> >::c_symbol() ) == "[]" );
+        EXPECT( std::string( unit_info< dimensions<0, 3, 0> >::c_name() ) == "kg+3" );
+        EXPECT( std::string( unit_info< force_d >::c_name() ) == "newton" );
+        EXPECT( unit_info< force_d >::symbol() == "N" );
+    },
+
+    "quantity output to character buffer", []
+    {
+        EXPECT( tc( 12.5 * meter ) == "12.5 m" );
+        EXPECT( tc( 0.1 * meter ) == "0.1 m" );
+        EXPECT( tc( -2 * newton ) == "-2 N" );
+        EXPECT( tc( 1e-20 * meter ) == "1e-20 m" );
+        EXPECT( tc( meter / 3 ) == "0.3333333333333333 m" );
+        EXPECT( tc( 2 * meter * meter * second ) == "2 m+2 s" );
+        EXPECT( tc( quantity<length_d, float>( 0.1f * meter ) ) == "0.1 m" );
+    },
+
+    "quantity output to character buffer reads back exactly", []
+    {
+        Rep const values[] = { 0.1, 1.0 / 3, 2.0 / 3, 1e23, 5e-324, 1.7976931348623157e308, 123456.789 };
+
+        for ( Rep value : values )
+        {
+            quantity<speed_d> v;
+
+            EXPECT( parse( tc( value * meter / second ), v ) == std::errc() );
+            EXPECT( v.magnitude() == value );
+        }
+    },
+
+    "quantity output to character buffer is the same with and without std::to_chars", []
+    {
+        EXPECT( tc( 1e14 * meter ) == "1e+14 m" );
+        EXPECT( tc( 100000 * meter ) == "1e+05 m" );
+        EXPECT( tc( 123456 * meter ) == "123456 m" );
+        EXPECT( tc( 1.2345678901234567e20 * meter ) == "123456789012345667584 m" );
+        EXPECT( tc( 12300000 * meter ) == "12300000 m" );
+        EXPECT( tc( 0.001 * meter ) == "0.001 m" );
+        EXPECT( tc( 1e-5 * meter ) == "1e-05 m" );
+        EXPECT( tc( -0.0 * meter ) == "-0 m" );
+        EXPECT( tc( 5e-324 * meter ) == "5e-324 m" );
+        EXPECT( tc( 1.7976931348623157e308 * meter ) == "1.7976931348623157e+308 m" );
+        EXPECT( tc( quantity<length_d, float>( 1e10f * meter ) ) == "1e+10 m" );
+    },
+
+    "quantity output of long double does not depend on the C locale", []
+    {
+        typedef quantity<length_d, long double> length_ld;
+
+        length_ld const values[] = { length_ld( 1.5L * meter ), length_ld( 0.1L * meter ), length_ld( meter / 3.0L ), length_ld( 1e300L * meter ) };
+        std::string expected[4];
+
+        for ( std::size_t i = 0; i < 4; ++i )
+            expected[i] = tc( values[i] );
+
+        EXPECT( expected[0] == "1.5 m" );
+
+        decimal_comma_locale const locale;
+
+        if ( !locale.active() )
+            return;
+
+        for ( std::size_t i = 0; i < 4; ++i )
+        {
+            length_ld q;
+
+            EXPECT( tc( values[i] ) == expected[i] );
+            EXPECT( parse( expected[i], q ) == std::errc() );
+            EXPECT( q.magnitude() == values[i].magnitude() );
+        }
+    },
+
+    "quantity output to character buffer of random values reads back exactly", []
+    {
+        std::mt19937_64 random( 42 );
+
+        for ( int i = 0; i < 100000; ++i )
+        {
+            std::uint64_t const bits = random();
+
+            double d;
+            float  f;
+            std::memcpy( &d, &bits, sizeof d );
+            std::memcpy( &f, &bits, sizeof f );
+
+            if ( !std::isfinite( d ) || !std::isfinite( f ) )
+                continue;
+
+            char text[64], expected[64];
+            char * const end = detail::shortest_chars( text, text + sizeof text, d ).ptr;
+            char * const expected_end = detail::format_shortest( expected, expected + sizeof expected, d ).ptr;
+
+            EXPECT( std::string( text, end ) == std::string( expected, expected_end ) );
+            EXPECT( std::strtod( std::string( text, end ).c_str(), nullptr ) == d );
+
+            char * const f_end = detail::shortest_chars( text, text + sizeof text, f ).ptr;
+            char * const f_expected_end = detail::format_shortest( expected, expected + sizeof expected, f ).ptr;
+
+            EXPECT( std::string( text, f_end ) == std::string( expected, f_expected_end ) );
+            EXPECT( std::strtof( std::string( text, f_end ).c_str(), nullptr ) == f );
+        }
+    },
+
+    "quantity output to character buffer reports too small buffer", []
+    {
+        EXPECT( tc( 12.5 * meter, 6 ) == "12.5 m" );
+        EXPECT( tc( 12.5 * meter, 5 ) == lest::to_string( std::errc::value_too_large ) );
+        EXPECT( tc( 12.5 * meter, 3 ) == lest::to_string( std::errc::value_too_large ) );
+    },
+
     "quantity output exceptions", []
     {
         EXPECT_THROWS_AS( prefix( "x" ), prefix_error );
     },
 
+    "quantity prefix factors", []
+    {
+        char const * const symbols[] = { "Y", "Z", "E", "P", "T", "G", "M", "k", "h", "da", "d", "c", "m", "u", "n", "p", "f", "a", "z", "y" };
+        long double  const factors[] = { yotta, zetta, exa, peta, tera, giga, mega, kilo, hecto, deka, deci, centi, milli, micro, nano, pico, femto, atto, zepto, yocto };
+
+        for ( std::size_t i = 0; i < sizeof symbols / sizeof symbols[0]; ++i )
+        {
+            EXPECT( prefix( symbols[i] ) == Rep( factors[i] ) );
+            EXPECT( prefix( std::string( symbols[i] ) ) == Rep( factors[i] ) );
+        }
+
+        EXPECT( prefix( "kilo", 1 ) == Rep( kilo ) );
+        EXPECT( prefix( "dam" , 2 ) == Rep( deka ) );
+    },
+
+    "quantity prefix rejects non-prefixes", []
+    {
+        EXPECT_THROWS_AS( prefix( ""   ), prefix_error );
+        EXPECT_THROWS_AS( prefix( "D"  ), prefix_error );
+        EXPECT_THROWS_AS( prefix( "ad" ), prefix_error );
+        EXPECT_THROWS_AS( prefix( "kk" ), prefix_error );
+        EXPECT_THROWS_AS( prefix( "dam" ), prefix_error );
+        EXPECT_THROWS_AS( prefix( "kilo", 4 ), prefix_error );
+    },
+
+    "quantity prefix reports error code instead of throwing", []
+    {
+        std::error_code ec;
+
+        EXPECT( prefix( "M", 1, ec ) == Rep( mega ) );
+        EXPECT( !ec );
+
+        EXPECT( prefix( "x", 1, ec ) == Rep( 0 ) );
+        EXPECT( ( ec == std::errc::invalid_argument ) );
+
+        EXPECT( prefix( "k", 1, ec ) == Rep( kilo ) );
+        EXPECT( !ec );
+    },
+
     "quantity base unit names", []
     {
         EXPECT( to_unit_name( meter    ) == "meter" );
@@ -167,10 +429,543 @@ const lest::test output[] =
 
 };
 
+const lest::test input[] =
+{
+    "quantity input of numbers", []
+    {
+        quantity<length_d> q;
+
+        EXPECT( parse( "12.5 m", q ) == std::errc() ); EXPECT( q.magnitude() == 12.5 );
+        EXPECT( parse( "-3m"   , q ) == std::errc() ); EXPECT( q.magnitude() == -3.0 );
+        EXPECT( parse( "+.5 m" , q ) == std::errc() ); EXPECT( q.magnitude() == 0.5 );
+        EXPECT( parse( "1e3 m" , q ) == std::errc() ); EXPECT( q.magnitude() == 1000.0 );
+        EXPECT( parse( "25E-1 m", q ) == std::errc() ); EXPECT( q.magnitude() == 2.5 );
+        EXPECT( parse( "0.1 m" , q ) == std::errc() ); EXPECT( q.magnitude() == 0.1 );
+        EXPECT( parse( "1.7976931348623157e308 m", q ) == std::errc() ); EXPECT( q.magnitude() == 1.7976931348623157e308 );
+        EXPECT( parse( "123456789012345678901234 m", q ) == std::errc() ); EXPECT( q.magnitude() == 123456789012345678901234.0 );
+        EXPECT( parse( "4.9e-324 m", q ) == std::errc() ); EXPECT( q.magnitude() == 4.9e-324 );
+        EXPECT( parse( "1e-400 m", q ) == std::errc::result_out_of_range );
+        EXPECT( parse( "1e999 m", q ) == std::errc::result_out_of_range );
+    },
+
+    "quantity input of numbers does not depend on the C locale", []
+    {
+        decimal_comma_locale const locale;
+
+        if ( !locale.active() )
+            return;
+
+        quantity<length_d> q;
+        std::string const text = "1,5 m";
+
+        EXPECT( parse( "1.7976931348623157e308 m", q ) == std::errc() ); EXPECT( q.magnitude() == 1.7976931348623157e308 );
+        EXPECT( parse( "0.1000000000000000000001 m", q ) == std::errc() ); EXPECT( q.magnitude() == 0.1 );
+        EXPECT( parse( "0." + std::string( 80, '1' ) + " m", q ) == std::errc() ); EXPECT( q.magnitude() == 0.11111111111111111 );
+        EXPECT( from_chars( text.data(), text.data() + text.size(), q ).ptr == text.data() + 1 );
+    },
+
+    "quantity input of prefixed and named units", []
+    {
+        quantity<length_d> d;
+        quantity<mass_d  > m;
+        quantity<force_d > F;
+        quantity<electric_resistance_d> R;
+        quantity<time_interval_d> t;
+
+        EXPECT( parse( "1.5 km", d ) == std::errc() ); EXPECT( d.magnitude() == 1500.0 );
+        EXPECT( parse( "2 dam" , d ) == std::errc() ); EXPECT( d.magnitude() ==   20.0 );
+        EXPECT( parse( "3 kg"  , m ) == std::errc() ); EXPECT( m.magnitude() ==    3.0 );
+        EXPECT( parse( "3 g"   , m ) == std::errc() ); EXPECT( m.magnitude() == 0.003 );
+        EXPECT( parse( "7 kN"  , F ) == std::errc() ); EXPECT( F.magnitude() == 7000.0 );
+        EXPECT( parse( "2 MOhm", R ) == std::errc() ); EXPECT( R.magnitude() == 2e6 );
+        EXPECT( parse( "5 min" , t ) == std::errc() ); EXPECT( t.magnitude() == 300.0 );
+        EXPECT( parse( "2 h"   , t ) == std::errc() ); EXPECT( t.magnitude() == 7200.0 );
+        EXPECT( parse( "4 ms"  , t ) == std::errc() ); EXPECT( t.magnitude() == 0.004 );
+    },
+
+    "quantity input of compound units", []
+    {
+        quantity<speed_d > v;
+        quantity<energy_d> E;
+        quantity<volume_d> V;
+        quantity<specific_heat_capacity_d> c;
+
+        EXPECT( parse( "36 km/h"    , v ) == std::errc() ); EXPECT( s( v.magnitude() ) == "10.000000" );
+        EXPECT( parse( "3 m s-1"    , v ) == std::errc() ); EXPECT( v.magnitude() == 3.0 );
+        EXPECT( parse( "3 m*s^-1"   , v ) == std::errc() ); EXPECT( v.magnitude() == 3.0 );
+        EXPECT( parse( "3 m / s"    , v ) == std::errc() ); EXPECT( v.magnitude() == 3.0 );
+        EXPECT( parse( "2 m+2 kg s-2", E ) == std::errc() ); EXPECT( E.magnitude() == 2.0 );
+        EXPECT( parse( "2 N.m"      , E ) == std::errc() ); EXPECT( E.magnitude() == 2.0 );
+        EXPECT( parse( "2 kW h"     , E ) == std::errc() ); EXPECT( E.magnitude() == 7.2e6 );
+        EXPECT( parse( "5 cm3"      , V ) == std::errc() ); EXPECT( e( V.magnitude() ) == "5.0e-06" );
+        EXPECT( parse( "5 mL"       , V ) == std::errc() ); EXPECT( e( V.magnitude() ) == "5.0e-06" );
+        EXPECT( parse( "4.2 kJ/kg/K", c ) == std::errc() ); EXPECT( s( c.magnitude() ) == "4200.000000" );
+    },
+
+    "quantity input round-trips output", []
+    {
+        using namespace phys::units::io;
+
+        quantity<dimensions<2, 1, -1>> q;
+        quantity<speed_d> v;
+
+        EXPECT( parse( to_string( 2.5 * meter * meter * kilogram / second ), q ) == std::errc() );
+        EXPECT( q.magnitude() == 2.5 );
+        EXPECT( parse( to_string( 2.5 * meter / second ), v ) == std::errc() );
+        EXPECT( v.magnitude() == 2.5 );
+    },
+
+    "quantity input stops at first character that does not fit", []
+    {
+        quantity<length_d> q;
+        std::string const text = "12 km, 3 m";
+
+        from_chars_result const result = from_chars( text.data(), text.data() + text.size(), q );
+
+        EXPECT( result.ec == std::errc() );
+        EXPECT( result.ptr == text.data() + 5 );
+        EXPECT( q.magnitude() == 12000.0 );
+
+        std::string const spaced = "12 m next";
+
+        EXPECT( from_chars( spaced.data(), spaced.data() + spaced.size(), q ).ptr == spaced.data() + 4 );
+    },
+
+    "quantity input reports errors", []
+    {
+        quantity<length_d> q = 1 * meter;
+
+        EXPECT( parse( ""       , q ) == std::errc::invalid_argument );
+        EXPECT( parse( "m"      , q ) == std::errc::invalid_argument );
+        EXPECT( parse( " 1 m"   , q ) == std::errc::invalid_argument );
+        EXPECT( parse( "1 xyz"  , q ) == std::errc::invalid_argument );
+        EXPECT( parse( "1 m/"   , q ) == std::errc::invalid_argument );
+        EXPECT( parse( "1 m^"   , q ) == std::errc::invalid_argument );
+        EXPECT( parse( "1 kmin" , q ) == std::errc::invalid_argument );
+        EXPECT( parse( "1 s"    , q ) == std::errc::argument_out_of_domain );
+        EXPECT( parse( "1 m2"   , q ) == std::errc::argument_out_of_domain );
+        EXPECT( parse( "1"      , q ) == std::errc::argument_out_of_domain );
+        EXPECT( q.magnitude() == 1.0 );
+    },
+};
+
+const lest::test dynamic[] =
+{
+    "dimension key packs the exponents", []
+    {
+        dimension_key const force = dimension_key::of<force_d>();
+
+        EXPECT( force.exponent( 0 ) ==  1 );
+        EXPECT( force.exponent( 1 ) ==  1 );
+        EXPECT( force.exponent( 2 ) == -2 );
+        EXPECT( force.exponent( 3 ) ==  0 );
+        EXPECT( to_string( force ) == "m kg s-2" );
+        EXPECT( to_string( dimension_key() ) == "" );
+        EXPECT( ( to_string( dimension_key::of< dimensions<1, 2, -1> >() ) == unit_info< dimensions<1, 2, -1> >::symbol() ) );
+        EXPECT( to_string( dimension_key::of<electric_resistance_d>() ) == "m+2 kg s-3 A-2" );
+
+        EXPECT( ( dimension_key::of<length_d>() * dimension_key::of<length_d>() == dimension_key::of<area_d>() ) );
+        EXPECT( ( dimension_key::of<length_d>() / dimension_key::of<time_interval_d>() == dimension_key::of<speed_d>() ) );
+        EXPECT( ( force / force == dimension_key() ) );
+        EXPECT( ( dimension_key() / dimension_key::of<frequency_d>() == dimension_key::of<time_interval_d>() ) );
+        EXPECT( ( dimension_power( force, 3 ) == dimension_key::of< dimensions<3, 3, -6> >() ) );
+
+        int const most[7] = { 127, 0, 0, 0, 0, 0, -128 };
+
+        EXPECT_THROWS_AS( ( dimension_key::from_exponents( most ) * dimension_key::of<length_d>() ).bits(), dimension_error );
+        EXPECT_THROWS_AS( ( dimension_key::from_exponents( most ) / dimension_key::of<luminous_intensity_d>() ).bits(), dimension_error );
+        EXPECT_THROWS_AS( dimension_root( force, 2 ).bits(), dimension_error );
+    },
+
+    "dynamic quantity arithmetic checks the dimensions at run time", []
+    {
+        dynamic_quantity<> const d = 3 * meter;
+        dynamic_quantity<> const t = 2 * second;
+
+        dynamic_quantity<> const v = d / t;
+
+        EXPECT( v.has_dimensions<speed_d>() );
+        EXPECT( quantity_cast<speed_d>( v ).magnitude() == 1.5 );
+        EXPECT( quantity_cast<length_d>( d + d - 2 * d / 2.0 ).magnitude() == 3.0 );
+        EXPECT( quantity_cast<length_d>( sqrt( d * d ) ).magnitude() == 3.0 );
+        EXPECT( quantity_cast<time_interval_d>( 1 / ( 1.0 / t ) ).magnitude() == 2.0 );
+        EXPECT( ( d < d * 2 ) );
+        EXPECT( ( abs( -d ) == d ) );
+
+        EXPECT_THROWS_AS( ( d + t ).magnitude(), dimension_error );
+        EXPECT_THROWS_AS( d < t, dimension_error );
+        EXPECT_THROWS_AS( sqrt( d ).magnitude(), dimension_error );
+        EXPECT_THROWS_AS( quantity_cast<mass_d>( d ).magnitude(), dimension_error );
+    },
+
+    "dynamic quantity mixes with static quantities", []
+    {
+        dynamic_quantity<> d = 3 * meter;
+
+        EXPECT( quantity_cast<length_d>( d + 2 * meter ).magnitude() == 5.0 );
+        EXPECT( quantity_cast<length_d>( 2 * meter - d ).magnitude() == -1.0 );
+        EXPECT( quantity_cast<speed_d>( d / ( 2 * second ) ).magnitude() == 1.5 );
+        EXPECT( quantity_cast<area_d>( 2 * meter * d ).magnitude() == 6.0 );
+        EXPECT( ( d == 3 * meter ) );
+        EXPECT( ( 3 * meter == d ) );
+        EXPECT( ( d != 2 * meter ) );
+        EXPECT( ( d < 4 * meter ) );
+        EXPECT( ( 4 * meter > d ) );
+        EXPECT( ( d <= 3 * meter ) );
+        EXPECT( ( d >= 3 * meter ) );
+        EXPECT( quantity_cast<length_d>( d += 1 * meter ).magnitude() == 4.0 );
+        EXPECT( quantity_cast<length_d>( d -= 2 * meter ).magnitude() == 2.0 );
+
+        EXPECT_THROWS_AS( ( d + 1 * second ).magnitude(), dimension_error );
+        EXPECT_THROWS_AS( d < 1 * second, dimension_error );
+        EXPECT_THROWS_AS( ( d += 1 * second ).magnitude(), dimension_error );
+    },
+
+    "dynamic quantity input reads any unit", []
+    {
+        dynamic_quantity<> q;
+
+        EXPECT( parse( "36 km/h", q ) == std::errc() );
+        EXPECT( q.has_dimensions<speed_d>() );
+        EXPECT( s( q.magnitude() ) == "10.000000" );
+
+        EXPECT( parse( "2 " + to_string( dimension_key::of<electric_resistance_d>() ), q ) == std::errc() );
+        EXPECT( q.has_dimensions<electric_resistance_d>() );
+        EXPECT( q.magnitude() == 2.0 );
+
+        EXPECT( parse( "2", q ) == std::errc() );
+        EXPECT( q.dimension().is_dimensionless() );
+        EXPECT( parse( "1 xyz", q ) == std::errc::invalid_argument );
+    },
+
+    "dynamic vector converts to quantity_vector with a single check", []
+    {
+        dynamic_vector<> column( dimension_key::of<length_d>() );
+
+        column.push_back( 1 * meter );
+        column.push_back( 2 * meter );
+
+        EXPECT_THROWS_AS( ( column.push_back( 1 * second ), true ), dimension_error );
+        EXPECT_THROWS_AS( quantity_cast<speed_d>( column ).size(), dimension_error );
+
+        quantity_vector<length_d> const copy = quantity_cast<length_d>( column );
+
+        EXPECT( copy.size() == 2u );
+        EXPECT( ( copy[1] == 2 * meter ) );
+
+        double const * const storage = column.magnitudes();
+
+        quantity_vector<length_d> const moved = quantity_cast<length_d>( std::move( column ) );
+
+        EXPECT( moved.magnitudes() == storage );
+        EXPECT( ( moved == copy ) );
+
+        int found = 0;
+        which_dimensions const which = { found };
+
+        EXPECT( ( dispatch< length_d, speed_d >( dimension_key::of<speed_d>(), which ) ) );
+        EXPECT( found == 2 );
+        EXPECT( !( dispatch< length_d, speed_d >( dimension_key::of<mass_d>(), which ) ) );
+    },
+};
+
+const lest::test binary[] =
+{
+    "column round-trips through a stream", []
+    {
+        quantity_vector<force_d> const v = { 1 * newton, 2 * newton, 3 * newton };
+        std::stringstream ss;
+
+        write_column( ss, v );
+
+        EXPECT( ss.str().size() == sizeof( column_header ) + 3 * sizeof( double ) );
+        EXPECT( ( read_column<force_d, double>( ss ) == v ) );
+    },
+
+    "column reader checks the header once at open", []
+    {
+        quantity_vector<length_d> const v = { 1 * meter, 2 * meter };
+        std::ostringstream os;
+
+        write_column( os, v );
+
+        std::string const file = os.str();
+
+        std::istringstream length( file ), time( file ), single( file ), truncated( file.substr( 0, file.size() - 1 ) ), other( "not a column file" );
+
+        EXPECT( ( read_column<length_d, double>( length ).size() == 2u ) );
+        EXPECT_THROWS_AS( ( read_column<time_interval_d, double>( time ).size() ), column_error );
+        EXPECT_THROWS_AS( ( read_column<length_d, float>( single ).size() ), column_error );
+        EXPECT_THROWS_AS( ( read_column<length_d, double>( truncated ).size() ), column_error );
+        EXPECT_THROWS_AS( ( read_column<length_d, double>( other ).size() ), column_error );
+    },
+
+    "column reader rejects a corrupt count without allocating for it", []
+    {
+        quantity_vector<length_d> const v = { 1 * meter, 2 * meter };
+        std::ostringstream os;
+
+        write_column( os, v );
+
+        std::string huge = os.str(), large = os.str();
+        std::uint64_t const huge_count = ~std::uint64_t( 0 ), large_count = std::uint64_t( 1 ) << 40;
+
+        std::memcpy( &huge [ offsetof( column_header, count ) ], &huge_count , sizeof huge_count  );
+        std::memcpy( &large[ offsetof( column_header, count ) ], &large_count, sizeof large_count );
+
+        std::istringstream huge_is( huge ), large_is( large );
+
+        EXPECT_THROWS_AS( ( read_column<length_d, double>( huge_is  ).size() ), column_error );
+        EXPECT_THROWS_AS( ( read_column<length_d, double>( large_is ).size() ), column_error );
+    },
+
+    "column view refers to the magnitudes in place", []
+    {
+        quantity_vector<force_d> const v = { 1 * newton, 2 * newton, 3 * newton };
+        std::ostringstream os;
+
+        write_column( os, v );
+
+        std::string const file = os.str();
+        quantity_vector<force_d> buffer( file.size() / sizeof( double ) );
+
+        std::memcpy( buffer.magnitudes(), file.data(), file.size() );
+
+        column_view<force_d, double> const view = view_column<force_d, double>( buffer.magnitudes(), file.size() );
+
+        EXPECT( view.size() == 3u );
+        EXPECT( view.magnitudes() == buffer.magnitudes() + sizeof( column_header ) / sizeof( double ) );
+        EXPECT( ( view[2] == 3 * newton ) );
+        EXPECT( view.unit() == unit_info<force_d>::symbol() );
+
+        EXPECT_THROWS_AS( ( view_column<force_d, double>( buffer.magnitudes(), file.size() - 1 ).size() ), column_error );
+        EXPECT_THROWS_AS( ( view_column<energy_d, double>( buffer.magnitudes(), file.size() ).size() ), column_error );
+    },
+
+    "column writer patches the count when it finishes", []
+    {
+        quantity<length_d> const more[] = { 2 * meter, 3 * meter };
+        std::stringstream ss;
+        {
+            column_writer<length_d> writer( ss );
+
+            writer.push_back( 1 * meter );
+            writer.write( more, more + 2 );
+
+            EXPECT( writer.size() == 3u );
+        }
+        quantity_vector<length_d> const v = read_column<length_d, double>( ss );
+
+        EXPECT( v.size() == 3u );
+        EXPECT( ( v[2] == 3 * meter ) );
+    },
+
+    "column writer reports stream failures", []
+    {
+        struct discard : std::streambuf { int overflow( int c ) override { return c; } } buf;
+        std::ostream os( &buf );
+
+        EXPECT_THROWS_AS( ( column_writer<length_d>( os ), true ), column_error );
+
+        std::stringstream ss;
+        {
+            column_writer<length_d> writer( ss );
+
+            writer.push_back( 1 * meter );
+            ss.setstate( std::ios::badbit );
+
+            EXPECT_THROWS_AS( writer.push_back( 2 * meter ).size(), column_error );
+            EXPECT( writer.size() == 1u );
+            EXPECT_THROWS_AS( ( writer.finish(), true ), column_error );
+        }
+        {
+            std::stringstream failing;
+            column_writer<length_d> writer( failing );
+
+            failing.setstate( std::ios::badbit );
+        }
+    },
+};
+
+const lest::test csv[] =
+{
+    "csv reader parses the units of the header once", []
+    {
+        std::istringstream is( "time [s], speed [km/h] ,\"force [kN]\",label\n" );
+        csv_reader reader( is );
+
+        EXPECT( reader.size() == 4u );
+        EXPECT( reader.column( 1 ).name == "speed" );
+        EXPECT( reader.column( 1 ).unit == "km/h" );
+        EXPECT( reader.column( 1 ).has_dimensions<speed_d>() );
+        EXPECT( reader.column( 2 ).name == "force" );
+        EXPECT( reader.column( 2 ).factor() == 1000.0L );
+        EXPECT( reader.column( 3 ).has_dimensions<dimensionless_d>() );
+        EXPECT( reader.find( "label" ) == 3u );
+
+        quantity_vector<length_d> v;
+
+        EXPECT_THROWS_AS( ( reader.bind( "speed", v ), true ), csv_error );
+        EXPECT_THROWS_AS( reader.find( "mass" ), csv_error );
+
+        std::istringstream unknown( "speed [km/x]\n" );
+
+        EXPECT_THROWS_AS( csv_reader( unknown ).size(), csv_error );
+    },
+
+    "csv reader reads bound columns in chunks of rows", []
+    {
+        std::istringstream is( "time [s],speed [km/h],force [kN],label\r\n0,36,1.5,a\r\n1,72, 2 ,b\r\n\r\n2,,3,c" );
+        csv_reader reader( is, '\0', 8 );
+
+        quantity_vector<speed_d> speed;
+        quantity_vector<force_d> force;
+
+        reader.bind( "speed", speed );
+        reader.bind( 2, force );
+
+        EXPECT( reader.read( 2 ) == 2u );
+        EXPECT( speed.size() == 2u );
+        EXPECT( speed[0].magnitude() == 10.0 );
+        EXPECT( speed[1].magnitude() == 20.0 );
+        EXPECT( ( force[1] == 2000 * newton ) );
+
+        EXPECT( reader.read( 2 ) == 1u );
+        EXPECT( speed.size() == 1u );
+        EXPECT( std::isnan( speed[0].magnitude() ) );
+        EXPECT( ( force[0] == 3000 * newton ) );
+        EXPECT( reader.line() == 5u );
+
+        EXPECT( reader.read( 2 ) == 0u );
+        EXPECT( speed.empty() );
+    },
+
+    "csv reader keeps delimiters between quotes in the header", []
+    {
+        std::istringstream is( "\"force, total [kN]\",t [s]\n1.5,2\n" );
+        csv_reader reader( is );
+
+        EXPECT( reader.size() == 2u );
+        EXPECT( reader.column( 0 ).name == "force, total" );
+        EXPECT( reader.column( 0 ).has_dimensions<force_d>() );
+        EXPECT( reader.find( "t" ) == 1u );
+
+        quantity_vector<force_d> force;
+        reader.bind( 0, force );
+
+        EXPECT( reader.read( 10 ) == 1u );
+        EXPECT( ( force[0] == 1500 * newton ) );
+    },
+
+    "csv reader reads an empty line of a single column as NaN", []
+    {
+        std::istringstream is( "length [m]\n1\n\n3\n" );
+        csv_reader reader( is );
+
+        quantity_vector<length_d> length;
+        reader.bind( 0, length );
+
+        EXPECT( reader.read( 10 ) == 3u );
+        EXPECT( length[0].magnitude() == 1.0 );
+        EXPECT( std::isnan( length[1].magnitude() ) );
+        EXPECT( length[2].magnitude() == 3.0 );
+    },
+
+    "csv reader reads tab-separated values", []
+    {
+        std::istringstream is( "distance [km]\tduration [min]\n1\t2\n" );
+        csv_reader reader( is );
+
+        quantity_vector<time_interval_d> duration;
+        reader.bind( "duration", duration );
+
+        EXPECT( reader.read( 10 ) == 1u );
+        EXPECT( ( duration[0] == 120 * second ) );
+    },
+
+    "csv reader reports malformed rows with their line", []
+    {
+        std::istringstream is( "a [m],b [m]\n1,2\n1,x\n1\n1,36,99\n" );
+        csv_reader reader( is );
+
+        quantity_vector<length_d> b;
+        reader.bind( "b", b );
+
+        EXPECT( reader.read( 1 ) == 1u );
+        EXPECT_THROWS_AS( reader.read( 1 ), csv_error );
+        EXPECT( reader.line() == 3u );
+        EXPECT_THROWS_AS( reader.read( 1 ), csv_error );
+        EXPECT( reader.line() == 4u );
+        EXPECT_THROWS_AS( reader.read( 1 ), csv_error );
+        EXPECT( reader.line() == 5u );
+    },
+};
+
+const lest::test registry[] =
+{
+    "unit registry looks up SI and other symbols", []
+    {
+        unit_registry const registry;
+
+        registered_unit const * const psi_unit = registry.find( "psi" );
+        registered_unit const * const ohm_unit = registry.find( "Ohm" );
+
+        EXPECT( psi_unit != nullptr );
+        EXPECT( psi_unit->has_dimensions<pressure_d>() );
+        EXPECT( psi_unit->factor == psi.magnitude() );
+        EXPECT( ohm_unit != nullptr );
+        EXPECT( ohm_unit->has_dimensions<electric_resistance_d>() );
+        EXPECT( registry.find( "kWh" ) == nullptr );
+    },
+
+    "unit registry parses and memoizes compound units", []
+    {
+        unit_registry registry;
+        std::size_t const size = registry.size();
+
+        registered_unit const & kwh = registry.intern( "kWh" );
+        registered_unit const & mph = registry.intern( "mi/h" );
+        registered_unit const & newton_unit = registry.intern( "kg m/s^2" );
+
+        EXPECT( kwh.has_dimensions<energy_d>() );
+        EXPECT( kwh.factor == 3.6e6L );
+        EXPECT( mph.has_dimensions<speed_d>() );
+        EXPECT( std::abs( conversion_factor( mph, registry.intern( "mph" ) ) - 1 ) < 1e-15L );
+        EXPECT( newton_unit.has_dimensions<force_d>() );
+
+        EXPECT( registry.size() == size + 3u );
+        EXPECT( &registry.intern( "mi/h" ) == &mph );
+        EXPECT( registry.find( "kg m/s^2" ) == &newton_unit );
+        EXPECT( std::string( mph.symbol ) == "mi/h" );
+    },
+
+    "unit registry converts values and reports errors", []
+    {
+        unit_registry registry;
+
+        dynamic_quantity<> const q = make_quantity( 2.0, registry.intern( "lbf" ) );
+
+        EXPECT( ( quantity_cast<force_d>( q ) == 2 * pound_force ) );
+        EXPECT( registry.intern( "eV" ).factor == electronvolt.magnitude() );
+        EXPECT( registry.intern( "keV" ).has_dimensions<energy_d>() );
+        EXPECT( registry.intern( "deg" ).has_dimensions<dimensionless_d>() );
+        EXPECT( std::abs( conversion_factor( registry.intern( "bar" ), registry.intern( "psi" ) ) - 14.503774L ) < 1e-6L );
+
+        EXPECT_THROWS_AS( registry.intern( "furlongs" ).length, unit_error );
+        EXPECT_THROWS_AS( registry.intern( "km/" ).length, unit_error );
+        EXPECT_THROWS_AS( conversion_factor( registry.intern( "psi" ), registry.intern( "mi" ) ), dimension_error );
+    },
+};
+
 int main()
 {
     const int total = 0
     + lest::run( output )
+    + lest::run( input )
+    + lest::run( dynamic )
+    + lest::run( binary )
+    + lest::run( csv )
+    + lest::run( registry )
     ;
 
     if ( total )
@@ -0,0 +1,694 @@
+/**
+ * \file test_quantity_vector.cpp
+ *
+ * \brief   lest tests for quantity containers and bulk operations.
+ * \author  Martin Moene
+ * \date    16 October 2026
+ * \since   1.2
+ *
+ * This code is provided as-is, with no warrantee of correctness.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+//#define USE_HAMLEST
+
+#include "phys/units/quantity.hpp"
+#include "phys/units/quantity_vector.hpp"
+#include "phys/units/quantity_accumulator.hpp"
+#include "phys/units/quantity_algorithm.hpp"
+#include "phys/units/quantity_ode.hpp"
+#include "phys/units/quantity_span.hpp"
+#include "phys/units/quantity_vec.hpp"
+
+#include "test_util.hpp"  // include before lest.hpp
+
+#ifndef USE_HAMLEST
+# include "lest.hpp"
+#else
+# include "hamlest.hpp"
+  using namespace lest::match;
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace phys::units;
+using namespace phys::units::literals;
+
+const lest::test container[] =
+{
+    "quantity_vector can be default-constructed", []
+    {
+        quantity_vector<length_d> v;
+
+        EXPECT( v.size() == 0u );
+        EXPECT( v.empty() );
+        EXPECT( v.dimension() == length_d{} );
+    },
+
+    "quantity_vector can be size-constructed with zeros", []
+    {
+        quantity_vector<length_d> v( 3 );
+
+        EXPECT( v.size() == 3u );
+        EXPECT( s( v[0] ) == "0.000000 m" );
+        EXPECT( s( v[2] ) == "0.000000 m" );
+    },
+
+    "quantity_vector can be constructed from quantities and from magnitudes", []
+    {
+        double const raw[] = { 1, 2, 3 };
+
+        quantity_vector<length_d> v1{ 1 * meter, 2 * meter, 3 * meter };
+        quantity_vector<length_d> v2( detail::magnitude_tag, raw, raw + 3 );
+
+        EXPECT( v1.size() == 3u );
+        EXPECT( ( v1 == v2 ) );
+        EXPECT( s( v2[1] ) == "2.000000 m" );
+    },
+
+    "quantity_vector elements can be modified", []
+    {
+        quantity_vector<length_d> v( 2 );
+
+        v[0] = 3 * meter;
+        v[1] += 4 * meter;
+        v.push_back( 5 * meter );
+
+        EXPECT( s( v[0] ) == "3.000000 m" );
+        EXPECT( s( v[1] ) == "4.000000 m" );
+        EXPECT( s( v[2] ) == "5.000000 m" );
+        EXPECT( v.magnitudes()[2] == 5.0 );
+    },
+
+    "quantity_vector storage is aligned", []
+    {
+        quantity_vector<length_d> v( 7 );
+
+        EXPECT( 0u == reinterpret_cast<std::uintptr_t>( v.magnitudes() ) % PHYS_UNITS_VECTOR_ALIGNMENT );
+    },
+
+    "quantity_vector can be iterated", []
+    {
+        quantity_vector<length_d> v{ 1 * meter, 2 * meter, 3 * meter };
+
+        quantity<length_d> total;
+        for ( auto const & q : v )
+            total += q;
+
+        EXPECT( s( total ) == "6.000000 m" );
+    },
+};
+
+const lest::test arithmetic[] =
+{
+    "quantity_vector addition and subtraction", []
+    {
+        quantity_vector<length_d> a{ 1 * meter, 2 * meter };
+        quantity_vector<length_d> b{ 3 * meter, 5 * meter };
+
+        EXPECT( s( ( a + b )[1] ) ==  "7.000000 m" );
+        EXPECT( s( ( a - b )[1] ) == "-3.000000 m" );
+        EXPECT( s( ( a + meter )[0] ) == "2.000000 m" );
+        EXPECT( s( ( meter - a )[1] ) == "-1.000000 m" );
+        EXPECT( s( ( -a )[0] ) == "-1.000000 m" );
+
+        a += b;
+        EXPECT( s( a[0] ) == "4.000000 m" );
+        a -= meter;
+        EXPECT( s( a[0] ) == "3.000000 m" );
+    },
+
+    "quantity_vector multiplication and division by number", []
+    {
+        quantity_vector<length_d> a{ 2 * meter, 4 * meter };
+
+        EXPECT( s( ( a * 3 )[1] ) == "12.000000 m" );
+        EXPECT( s( ( 3 * a )[0] ) ==  "6.000000 m" );
+        EXPECT( s( ( a / 2 )[1] ) ==  "2.000000 m" );
+        EXPECT( s( ( 8 / a )[0] ) ==  "4.000000 m-1" );
+
+        a *= 2;
+        EXPECT( s( a[1] ) == "8.000000 m" );
+        a /= 4;
+        EXPECT( s( a[1] ) == "2.000000 m" );
+    },
+
+    "quantity_vector multiplication yields product dimensions", []
+    {
+        quantity_vector<force_d > F{ 2 * newton, 3 * newton };
+        quantity_vector<length_d> d{ 5 * meter,  7 * meter  };
+
+        quantity_vector<energy_d> E = F * d;
+
+        EXPECT( s( E[0] ) == "10.000000 m+2 kg s-2" );
+        EXPECT( s( E[1] ) == "21.000000 m+2 kg s-2" );
+        EXPECT( s( ( F * meter )[1] ) == "3.000000 m+2 kg s-2" );
+        EXPECT( s( ( meter * F )[0] ) == "2.000000 m+2 kg s-2" );
+    },
+
+    "quantity_vector division yields quotient dimensions", []
+    {
+        quantity_vector<length_d       > d{ 10 * meter, 30 * meter };
+        quantity_vector<time_interval_d> t{  2 * second, 3 * second };
+
+        quantity_vector<speed_d> v = d / t;
+
+        EXPECT( s( v[0] ) ==  "5.000000 m s-1" );
+        EXPECT( s( v[1] ) == "10.000000 m s-1" );
+        EXPECT( s( ( d / second )[0] ) == "10.000000 m s-1" );
+        EXPECT( s( ( meter / t )[0] ) == "0.500000 m s-1" );
+    },
+
+    "quantity_vector dimensionless results collapse to magnitudes", []
+    {
+        quantity_vector<length_d> a{ 6 * meter, 8 * meter };
+        quantity_vector<length_d> b{ 2 * meter, 4 * meter };
+
+        auto r = a / b;
+
+        EXPECT( r.size() == 2u );
+        EXPECT( r[0] == 3.0 );
+        EXPECT( r[1] == 2.0 );
+    },
+
+    "quantity_vector mixed magnitude types promote", []
+    {
+        quantity_vector<length_d, float > a{ quantity<length_d, float>( 1.5f * meter ) };
+        quantity_vector<length_d, double> b{ 2 * meter };
+
+        auto r = evaluate( a + b );
+
+        EXPECT( ( std::is_same< decltype( r ), quantity_vector<length_d, double> >::value ) );
+        EXPECT( s( r[0] ) == "3.500000 m" );
+    },
+};
+
+const lest::test expression[] =
+{
+    "vector expression is evaluated on assignment", []
+    {
+        quantity_vector<mass_d > m{ 2 * kilogram, 4 * kilogram };
+        quantity_vector<speed_d> v{ 3 * meter / second, 1 * meter / second };
+
+        quantity_vector<energy_d> E = 0.5 * m * square( v );
+
+        EXPECT( E.size() == 2u );
+        EXPECT( s( E[0] ) == "9.000000 m+2 kg s-2" );
+        EXPECT( s( E[1] ) == "2.000000 m+2 kg s-2" );
+    },
+
+    "vector expression yields element type of scalar computation", []
+    {
+        quantity_vector<force_d > F( 3 );
+        quantity_vector<length_d> d( 3 );
+
+        EXPECT( ( std::is_same< decltype( F * d )::value_type, quantity<energy_d> >::value ) );
+        EXPECT( ( std::is_same< decltype( d / d )::value_type, Rep >::value ) );
+        EXPECT( ( std::is_same< decltype( square( d ) / second )::value_type, quantity<dimensions<2, 0, -1>> >::value ) );
+    },
+
+    "vector expression elements can be accessed without evaluation", []
+    {
+        quantity_vector<length_d> a{ 1 * meter, 2 * meter };
+        quantity_vector<length_d> b{ 3 * meter, 4 * meter };
+
+        auto e = ( a + b ) * ( a - b ) / second;
+
+        EXPECT( e.size() == 2u );
+        EXPECT( s( e[1] ) == "-12.000000 m+2 s-1" );
+    },
+
+    "vector expression can be assigned to existing vector and to itself", []
+    {
+        quantity_vector<length_d> a{ 1 * meter, 2 * meter };
+        quantity_vector<length_d> b{ 3 * meter, 4 * meter };
+        quantity_vector<length_d> r;
+
+        r = a + 2 * b;
+        EXPECT( s( r[1] ) == "10.000000 m" );
+
+        r = r - a;
+        EXPECT( s( r[1] ) == "8.000000 m" );
+
+        r += b * b / meter;
+        EXPECT( s( r[1] ) == "24.000000 m" );
+
+        r *= a / b;
+        EXPECT( s( r[1] ) == "12.000000 m" );
+    },
+
+    "vector expression of operands of different sizes throws on evaluation", []
+    {
+        quantity_vector<length_d> a{ 1 * meter, 2 * meter };
+        quantity_vector<length_d> b{ 3 * meter, 4 * meter, 5 * meter };
+        quantity_vector<length_d> r{ 6 * meter };
+
+        EXPECT_THROWS_AS( quantity_vector<length_d>( a + 2 * b ).empty(), std::length_error );
+        EXPECT_THROWS_AS( ( r = a * ( b / meter ) ).empty(), std::length_error );
+        EXPECT_THROWS_AS( ( r += a ).empty(), std::length_error );
+        EXPECT( r.size() == 1u );
+        EXPECT( r[0] == 6 * meter );
+        EXPECT( ( a + 2 * meter ).size() == 2u );
+    },
+
+    "vector expression functions", []
+    {
+        quantity_vector<area_d  > a{ 4 * square( meter ), 9 * square( meter ) };
+        quantity_vector<length_d> d{ -2 * meter, 3 * meter };
+
+        EXPECT( s( sqrt( a )[1] ) == "3.000000 m" );
+        EXPECT( s( abs( d )[0] ) == "2.000000 m" );
+        EXPECT( s( cube( d )[0] ) == "-8.000000 m+3" );
+        EXPECT( s( ( -d )[0] ) == "2.000000 m" );
+        EXPECT( sqrt( d / d )[1] == 1.0 );
+    },
+
+    "vector expression with dimensionless result evaluates to magnitudes", []
+    {
+        quantity_vector<length_d> a{ 6 * meter, 8 * meter };
+        quantity_vector<length_d> b{ 2 * meter, 4 * meter };
+
+        auto r = evaluate( a / b );
+
+        EXPECT( ( std::is_same< decltype( r )::value_type, Rep >::value ) );
+        EXPECT( r.size() == 2u );
+        EXPECT( r[0] == 3.0 );
+    },
+};
+
+const lest::test reduction[] =
+{
+    "sum and mean of a range of quantities have the quantities' type", []
+    {
+        quantity_vector<power_d> const v{ 1 * watt, 2 * watt, 3 * watt, 4 * watt };
+
+        EXPECT( s( sum(  v.begin(), v.end() ) ) == "10.000000 m+2 kg s-3" );
+        EXPECT( s( mean( v.begin(), v.end() ) ) ==  "2.500000 m+2 kg s-3" );
+        EXPECT( s( sum(  v.begin(), v.begin() ) ) == "0.000000 m+2 kg s-3" );
+    },
+
+    "minmax_value gives the smallest and largest quantity", []
+    {
+        quantity_vector<length_d> const v{ 3 * meter, -1 * meter, 7 * meter, 2 * meter };
+
+        std::pair< quantity<length_d>, quantity<length_d> > const r = minmax_value( v.begin(), v.end() );
+
+        EXPECT( s( r.first  ) == "-1.000000 m" );
+        EXPECT( s( r.second ) ==  "7.000000 m" );
+    },
+
+    "dot product of force and length ranges is an energy", []
+    {
+        quantity_vector<force_d > const f{ 1 * newton, 2 * newton, 3 * newton };
+        quantity_vector<length_d> const d{ 4 * meter, 5 * meter, 6 * meter };
+
+        quantity<energy_d> const e = dot( f.begin(), f.end(), d.begin() );
+
+        EXPECT( s( e ) == "32.000000 m+2 kg s-2" );
+        EXPECT( dot( d.begin(), d.end(), d.begin() ) == square( 4 * meter ) + square( 5 * meter ) + square( 6 * meter ) );
+    },
+
+    "reductions work on plain numbers as well", []
+    {
+        std::vector<double> const v{ 1, 2, 3 };
+
+        EXPECT( sum( v.begin(), v.end() ) == 6 );
+        EXPECT( dot( v.begin(), v.end(), v.begin() ) == 14 );
+    },
+
+    "compensated summation keeps the rounding error small", []
+    {
+        std::vector< quantity<length_d> > const v( 10000000, 0.1 * meter );
+
+        EXPECT( sum( v.begin(), v.end() ) == 1e6 * meter );
+    },
+
+    "reductions give the same result with a thread_executor", []
+    {
+        quantity_vector<length_d> v( 1000003 );
+
+        for ( std::size_t i = 0; i < v.size(); ++i )
+        {
+            v[i] = ( i % 1000 ) * meter;
+        }
+
+        thread_executor const exec( 4 );
+
+        EXPECT( sum( v.begin(), v.end(), exec ) == sum( v.begin(), v.end() ) );
+        EXPECT( dot( v.begin(), v.end(), v.begin(), exec ) == dot( v.begin(), v.end(), v.begin() ) );
+        EXPECT( minmax_value( v.begin(), v.end(), exec ).second == 999 * meter );
+    },
+
+    "thread_executor rethrows an exception of a task after all tasks are done", []
+    {
+        thread_executor const exec( 4 );
+        std::vector<int> done( 8 );
+
+        auto const run = [&]
+        {
+            exec.bulk( done.size(), [&]( std::size_t const i )
+            {
+                done[i] = 1;
+
+                if ( i == 3 )
+                {
+                    throw std::runtime_error( "task 3" );
+                }
+            } );
+            return true;
+        };
+
+        EXPECT_THROWS_AS( run(), std::runtime_error );
+
+        EXPECT( std::count( done.begin(), done.end(), 1 ) == 8 );
+
+        quantity_vector<length_d> v( 1000003, 1 * meter );
+
+        for ( int i = 0; i < 100; ++i )
+        {
+            EXPECT( sum( v.begin(), v.end(), exec ) == 1000003 * meter );
+        }
+    },
+};
+
+const lest::test accumulation[] =
+{
+    "quantity_accumulator sums quantities", []
+    {
+        quantity_accumulator<energy_d> acc;
+
+        acc += 3 * joule;
+        acc += 4 * joule;
+        acc -= 2 * joule;
+
+        EXPECT( acc.value() == 5 * joule );
+        EXPECT( quantity<energy_d>( acc ) == 5 * joule );
+        EXPECT( quantity_accumulator<energy_d>( 2 * joule ).value() == 2 * joule );
+    },
+
+    "quantity_accumulator compensates the rounding error", []
+    {
+        quantity_accumulator<length_d> acc( 1e16 * meter );
+        quantity<length_d> plain( 1e16 * meter );
+
+        for ( int i = 0; i < 1000; ++i )
+        {
+            acc   += 1 * meter;
+            plain += 1 * meter;
+        }
+
+        EXPECT( plain       == 1e16 * meter );
+        EXPECT( acc.value() == ( 1e16 + 1000 ) * meter );
+        EXPECT( acc.compensation() == 1000 * meter );
+    },
+
+    "quantity_accumulator compensates addends larger than the sum", []
+    {
+        quantity_accumulator<length_d> acc;
+
+        acc += 1 * meter;
+        acc += 1e100 * meter;
+        acc += 1 * meter;
+        acc -= 1e100 * meter;
+
+        EXPECT( acc.value() == 2 * meter );
+    },
+
+    "quantity_accumulators can be merged", []
+    {
+        quantity_accumulator<length_d> a( 1e16 * meter );
+        quantity_accumulator<length_d> b;
+
+        for ( int i = 0; i < 10; ++i )
+        {
+            a += 1 * meter;
+            b += 1 * meter;
+        }
+
+        a += b;
+
+        EXPECT( a.value() == ( 1e16 + 20 ) * meter );
+    },
+};
+
+const lest::test span[] =
+{
+    "quantity_span views raw magnitudes without copying", []
+    {
+        double raw[] = { 1, 2, 3, 4 };
+
+        quantity_span<length_d, double> const s = make_span<length_d>( raw, 4 );
+
+        EXPECT( s.size() == 4u );
+        EXPECT( s.magnitudes() == raw );
+        EXPECT( ( s[1] == 2 * meter ) );
+
+        s[0] = 5 * meter;
+
+        EXPECT( raw[0] == 5.0 );
+        EXPECT( ( sum( s.begin(), s.end() ) == 14 * meter ) );
+
+        quantity_span<length_d, double const> const r = s.subspan( 1, 2 );
+
+        EXPECT( r.size() == 2u );
+        EXPECT( ( r[0] == 2 * meter ) );
+        EXPECT( ( *( r.end() - 1 ) == 3 * meter ) );
+    },
+
+    "quantity_span views the elements of a quantity_vector", []
+    {
+        quantity_vector<length_d> v = { 1 * meter, 2 * meter };
+        quantity_vector<length_d> const & cv = v;
+
+        quantity_span<length_d> const s( v );
+        quantity_span<length_d, double const> const r( cv );
+
+        EXPECT( s.data() == v.data() );
+        EXPECT( r.data() == v.data() );
+        EXPECT( r.size() == 2u );
+    },
+#if PHYS_UNITS_HAVE_MMAP
+    "map_span views the magnitudes in a mapped file", []
+    {
+        char const * const path = "test_quantity_span.tmp";
+        double const raw[] = { 1, 2, 3 };
+        {
+            std::ofstream os( path, std::ios::binary );
+            os.write( reinterpret_cast<char const *>( raw ), sizeof raw );
+        }
+        {
+            mapped_file const file( path );
+
+            quantity_span<pressure_d, double const> const all  = map_span<pressure_d, double>( file );
+            quantity_span<pressure_d, double const> const part = map_span<pressure_d, double>( file, sizeof( double ), 2 );
+
+            EXPECT( file.size() == sizeof raw );
+            EXPECT( all.size() == 3u );
+            EXPECT( ( all[2] == 3 * pascal ) );
+            EXPECT( ( part[0] == 2 * pascal ) );
+
+            EXPECT_THROWS_AS( ( map_span<pressure_d, double>( file, 0, 4 ).size() ), std::out_of_range );
+            EXPECT_THROWS_AS( ( map_span<pressure_d, double>( file, 1 ).size() ), std::out_of_range );
+        }
+        std::remove( path );
+
+        EXPECT_THROWS_AS( mapped_file( path ).size(), std::system_error );
+    },
+#endif
+};
+
+using inertia_d = dimensions< 2, 1, 0 >;
+
+const lest::test fixed_size[] =
+{
+    "quantity_vec stores its magnitudes in an unpadded array", []
+    {
+        vec3< quantity<force_d> > f( 1 * newton, 2 * newton, 3 * newton );
+
+        EXPECT( sizeof f == 3 * sizeof( double ) );
+        EXPECT( alignof( quantity_vec<force_d> ) == alignof( double ) );
+        EXPECT( sizeof( mat3< quantity<force_d> > ) == 9 * sizeof( double ) );
+        EXPECT( ( f[2] == 3 * newton ) );
+        EXPECT( f.magnitudes()[1] == 2.0 );
+
+        f[0] = 4 * newton;
+        f += f;
+        f -= quantity_vec<force_d>( 1 * newton, 1 * newton, 1 * newton );
+
+        EXPECT( ( f == quantity_vec<force_d>( 7 * newton, 3 * newton, 5 * newton ) ) );
+        EXPECT( ( -f != f ) );
+    },
+
+    "quantity_vec products have the dimensions of the product", []
+    {
+        quantity_vec<length_d> const r( 1 * meter, 0 * meter, 0 * meter );
+        quantity_vec<force_d > const f( 0 * newton, 2 * newton, 0 * newton );
+
+        quantity_vec<torque_d> const tau = cross( r, f );
+        quantity<energy_d> const w = dot( r + r, quantity_vec<force_d>( 1 * newton, 0 * newton, 0 * newton ) * 2.0 );
+
+        EXPECT( ( tau == quantity_vec<torque_d>( 0 * joule, 0 * joule, 2 * joule ) ) );
+        EXPECT( ( w == 4 * joule ) );
+        EXPECT( ( norm( f ) == 2 * newton ) );
+        EXPECT( ( dot( r, r ) / ( 1 * meter * meter ) == 1.0 ) );
+
+        quantity_vec<acceleration_d> const a = f / ( 2 * kilogram );
+        quantity_vec<force_d> const g = 2 * kilogram * a;
+
+        EXPECT( ( g == f ) );
+    },
+
+    "quantity_mat multiplies matrices and vectors", []
+    {
+        typedef quantity<inertia_d> inertia;
+
+        mat3<inertia> const i = mat3<inertia>::diagonal( 2 * kilogram * meter * meter );
+
+        quantity_vec<angular_velocity_d> const omega( 1 / second, 2 / second, 3 / second );
+        quantity_vec< dimensions<2, 1, -1> > const l = i * omega;
+
+        EXPECT( ( l[2] == 6 * kilogram * meter * meter / second ) );
+
+        quantity_mat<length_d, double, 2, 3> m;
+
+        m( 0, 1 ) = 1 * meter;
+        m( 1, 2 ) = 2 * meter;
+
+        quantity_mat<length_d, double, 3, 2> const t = transpose( m );
+        quantity_mat<area_d, double, 2, 2> const p = m * t;
+
+        EXPECT( ( t( 1, 0 ) == 1 * meter ) );
+        EXPECT( ( p( 0, 0 ) == 1 * meter * meter ) );
+        EXPECT( ( p( 1, 1 ) == 4 * meter * meter ) );
+        EXPECT( ( p( 0, 1 ) == 0 * meter * meter ) );
+        EXPECT( ( 2.0 * m - m == m ) );
+    },
+};
+
+typedef std::tuple< quantity<length_d>, quantity<speed_d> > oscillator_state;
+
+// harmonic oscillator with an angular frequency of 1/s: x'' = -x / s2.
+
+struct oscillator
+{
+    void operator()( oscillator_state const & y, state_derivative<oscillator_state, quantity<time_interval_d> >::type & dydt, quantity<time_interval_d> ) const
+    {
+        std::get<0>( dydt ) = std::get<1>( y );
+        std::get<1>( dydt ) = -std::get<0>( y ) / ( 1 * second * second );
+    }
+};
+
+const lest::test integration[] =
+{
+    "the derivative of a state tuple is a tuple of quotients", []
+    {
+        typedef state_derivative< oscillator_state, quantity<time_interval_d> >::type derivative;
+        typedef state_derivative< quantity_vec<length_d>, quantity<time_interval_d> >::type velocity;
+
+        EXPECT( ( std::is_same< std::tuple_element<0, derivative>::type, quantity<speed_d> >::value ) );
+        EXPECT( ( std::is_same< std::tuple_element<1, derivative>::type, quantity<acceleration_d> >::value ) );
+        EXPECT( ( std::is_same< velocity, quantity_vec<speed_d> >::value ) );
+    },
+
+    "rk4 integrates a harmonic oscillator over a period", []
+    {
+        double const pi = 3.14159265358979323846;
+
+        oscillator_state y( 1 * meter, 0 * meter / second );
+        rk4<oscillator_state> stepper;
+
+        std::size_t const n = stepper.integrate( oscillator(), y, 0 * second, 2 * pi * second, 0.01 * second );
+
+        EXPECT( n == 629u );
+        EXPECT( std::abs( std::get<0>( y ).magnitude() - 1 ) < 1e-9 );
+        EXPECT( std::abs( std::get<1>( y ).magnitude() ) < 1e-9 );
+    },
+
+    "rk45 keeps the error within the tolerance with few steps", []
+    {
+        quantity<length_d> y = 1 * meter;
+        rk45< quantity<length_d> > stepper( 1e-10 * meter, 1e-10 );
+
+        auto decay = []( quantity<length_d> const & x, quantity<speed_d> & dxdt, quantity<time_interval_d> ) { dxdt = -x / ( 2 * second ); };
+
+        std::size_t const n = stepper.integrate( decay, y, 0 * second, 10 * second, 0.1 * second );
+
+        EXPECT( std::abs( y.magnitude() - std::exp( -5.0 ) ) < 1e-9 );
+        EXPECT( n < 200u );
+    },
+
+    "rk45 integrates a batch of systems in a quantity_vector", []
+    {
+        quantity_vector<length_d> y( 1000, 1 * meter );
+        quantity_vector<frequency_d> rate( 1000 );
+
+        for ( std::size_t i = 0; i < rate.size(); ++i )
+            rate[i] = ( 0.001 * i ) / second;
+
+        auto decay = [&rate]( quantity_vector<length_d> const & x, quantity_vector<speed_d> & dxdt, quantity<time_interval_d> ) { dxdt = -( rate * x ); };
+
+        rk45< quantity_vector<length_d> > stepper( 1e-10 * meter, 1e-10 );
+        stepper.integrate( decay, y, 0 * second, 1 * second, 0.1 * second );
+
+        EXPECT( std::abs( y[0].magnitude() - 1 ) < 1e-9 );
+        EXPECT( std::abs( y[999].magnitude() - std::exp( -0.999 ) ) < 1e-9 );
+    },
+
+    "velocity_verlet keeps the energy of an oscillator bounded", []
+    {
+        quantity_vec<length_d> x( 1 * meter, 0 * meter, 0 * meter );
+        quantity_vec<speed_d > v( 0 * meter / second, 1 * meter / second, 0 * meter / second );
+
+        auto spring = []( quantity_vec<length_d> const & r, quantity_vec<acceleration_d> & a, quantity<time_interval_d> ) { a = r / ( -1 * second * second ); };
+
+        velocity_verlet< quantity_vec<length_d> > stepper;
+        stepper.integrate( spring, x, v, 0 * second, 1000 * second, 0.05 * second );
+
+        double const energy = ( dot( x, x ) / ( 1 * meter * meter ) + dot( v, v ) / ( 1 * meter * meter / second / second ) ) / 2;
+
+        EXPECT( std::abs( energy - 1 ) < 1e-3 );
+        EXPECT( std::abs( norm( x ).magnitude() - 1 ) < 1e-2 );
+    },
+
+    "rk45 throws ode_error when the step size underflows", []
+    {
+        quantity<length_d> y = 1 * meter;
+        quantity<time_interval_d> t  = 1 * second;
+        quantity<time_interval_d> dt = 0 * second;
+        rk45< quantity<length_d> > stepper( 1e-10 * meter, 1e-10 );
+
+        auto decay = []( quantity<length_d> const & x, quantity<speed_d> & dxdt, quantity<time_interval_d> ) { dxdt = -x / second; };
+
+        EXPECT_THROWS_AS( stepper.try_step( decay, y, t, dt ), ode_error );
+    },
+};
+
+int main()
+{
+    const int total = 0
+    + lest::run( container )
+    + lest::run( arithmetic )
+    + lest::run( expression )
+    + lest::run( reduction )
+    + lest::run( accumulation )
+    + lest::run( span )
+    + lest::run( fixed_size )
+    + lest::run( integration )
+    ;
+
+    if ( total )
+    {
+        std::cout << "Grand total of " << total << " failed " << lest::pluralise(total, "test") << "." << std::endl;
+    }
+
+    return total;
+}
+
+// g++ -Wall -Wextra -Weffc++ -std=c++11 -I../../ -o test_quantity_vector.exe test_quantity_vector.cpp && test_quantity_vector.exe
@@ -20,6 +20,7 @@
 
 #include <iomanip>
 #include <sstream>
+#include <system_error>
 
 // define to_string(dimensions<>) before inclusion of lest.hpp:
 
@@ -41,6 +42,11 @@ std::string to_string( ::phys::units::quantity<D,T> const & q )
     return os.str();
 }
 
+inline std::string to_string( std::errc const & ec )
+{
+    return std::make_error_code( ec ).message();
+}
+
 } // namespace lest
 
 inline std::string
@@ -0,0 +1,1162 @@
+//
+// time_benchmark.cpp - performance measurement for quantity library
+//
+// This code is provided as-is, with no warrantee of correctness.
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This program verifies that quantity computations are as fast as the
+// equivalent computations on the underlying double, and measures
+// formatting and parsing. It succeeds the work loop of time_performance.cpp
+// by Michael S. Kenniston.
+//
+// Each benchmark runs a quantity kernel and its baseline on double a number
+// of times and reports the median ns/op, the quantity/baseline ratio and
+// the spread of the measurements, as a table or as JSON (--json).
+// With --max-ratio=R, the program fails if the ratio of a benchmark that
+// should have no overhead exceeds R; use this to gate compiler or library
+// upgrades. Run with --help for all options.
+
+#include "phys/units/quantity.hpp"
+#include "phys/units/dynamic_quantity.hpp"
+#include "phys/units/fixed_point.hpp"
+#include "phys/units/float16.hpp"
+#include "phys/units/other_units.hpp"
+#include "phys/units/quantity_accumulator.hpp"
+#include "phys/units/quantity_algorithm.hpp"
+#include "phys/units/quantity_convert.hpp"
+#include "phys/units/quantity_io.hpp"
+#include "phys/units/quantity_io_binary.hpp"
+#include "phys/units/quantity_io_csv.hpp"
+#include "phys/units/quantity_io_engineering.hpp"
+#include "phys/units/quantity_io_input.hpp"
+#include "phys/units/quantity_ode.hpp"
+#include "phys/units/quantity_point.hpp"
+#include "phys/units/quantity_span.hpp"
+#include "phys/units/quantity_vec.hpp"
+#include "phys/units/scaled_quantity.hpp"
+#include "phys/units/unit_registry.hpp"
+
+#include "time_benchmark.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace phys::units;
+
+namespace {
+
+// Start values are read from volatiles so that the compiler cannot
+// evaluate the kernels at compile time.
+
+volatile double seed1 = 0.1;
+volatile double seed2 = 0.2;
+volatile double seed3 = 0.3;
+
+const long meg = 1000000;
+
+// Arithmetic: the work loop of time_performance.cpp.
+
+double arithmetic_double( long const n )
+{
+    double const v2 = seed2;
+    double x1 = seed1, x2 = seed2, x3 = seed3;
+
+    for ( long i = 0; i < n; ++i )
+    {
+        x2 = -x2 - v2;
+        x3 *= 1.00002;
+        x1 += x2 / x3;
+    }
+    return x1;
+}
+
+double arithmetic_quantity( long const n )
+{
+    quantity<length_d> const v2 = seed2 * meter;
+    quantity<speed_d> x1 = seed1 * meter / second;
+    quantity<length_d> x2 = v2;
+    quantity<time_interval_d> x3 = seed3 * second;
+
+    for ( long i = 0; i < n; ++i )
+    {
+        x2 = -x2 - v2;
+        x3 *= 1.00002;
+        x1 += x2 / x3;
+    }
+    return x1.magnitude();
+}
+
+// Arithmetic with intermediate dimensions: ohm * siemens is dimensionless.
+
+double mixed_double( long const n )
+{
+    double const biga = 2, bigb = 0.5;
+    double const v2 = seed2;
+    double x1 = seed1, x2 = seed2, x3 = seed3;
+
+    for ( long i = 0; i < n; ++i )
+    {
+        x2 = -x2 - v2;
+        x3 *= biga * 1.00002 * bigb;
+        x1 += x2 / x3;
+    }
+    return x1;
+}
+
+double mixed_quantity( long const n )
+{
+    quantity<electric_resistance_d> const biga = 2 * ohm;
+    quantity<electric_conductance_d> const bigb = siemens / 2;
+    quantity<length_d> const v2 = seed2 * meter;
+    quantity<speed_d> x1 = seed1 * meter / second;
+    quantity<length_d> x2 = v2;
+    quantity<time_interval_d> x3 = seed3 * second;
+
+    for ( long i = 0; i < n; ++i )
+    {
+        x2 = -x2 - v2;
+        x3 *= biga * 1.00002 * bigb;
+        x1 += x2 / x3;
+    }
+    return x1.magnitude();
+}
+
+// Powers and roots, compared with what one would write for a double.
+
+double cube_double( long const n )
+{
+    double x = seed1, sum = 0;
+
+    for ( long i = 0; i < n; ++i, x += 1e-9 )
+        sum += x * x * x;
+
+    return sum;
+}
+
+double cube_quantity( long const n )
+{
+    quantity<length_d> x = seed1 * meter;
+    quantity<volume_d> sum;
+
+    for ( long i = 0; i < n; ++i, x += 1e-9 * meter )
+        sum += cube( x );
+
+    return sum.magnitude();
+}
+
+double nth_power_quantity( long const n )
+{
+    quantity<length_d> x = seed1 * meter;
+    quantity<volume_d> sum;
+
+    for ( long i = 0; i < n; ++i, x += 1e-9 * meter )
+        sum += nth_power<3>( x );
+
+    return sum.magnitude();
+}
+
+double fourth_double( long const n )
+{
+    double x = seed1, sum = 0;
+
+    for ( long i = 0; i < n; ++i, x += 1e-9 )
+        sum += x * x * x * x;
+
+    return sum;
+}
+
+double fourth_quantity( long const n )
+{
+    quantity<length_d> x = seed1 * meter;
+    quantity<dimensions<4,0,0> > sum;
+
+    for ( long i = 0; i < n; ++i, x += 1e-9 * meter )
+        sum += nth_power<4>( x );
+
+    return sum.magnitude();
+}
+
+double sqrt_double( long const n )
+{
+    double x = seed1, sum = 0;
+
+    for ( long i = 0; i < n; ++i, x += 1e-9 )
+        sum += std::sqrt( x );
+
+    return sum;
+}
+
+double sqrt_quantity( long const n )
+{
+    quantity<area_d> x = seed1 * square( meter );
+    quantity<length_d> sum;
+
+    for ( long i = 0; i < n; ++i, x += 1e-9 * square( meter ) )
+        sum += sqrt( x );
+
+    return sum.magnitude();
+}
+
+double cbrt_double( long const n )
+{
+    double x = seed1, sum = 0;
+
+    for ( long i = 0; i < n; ++i, x += 1e-9 )
+        sum += std::cbrt( x );
+
+    return sum;
+}
+
+double nth_root_quantity( long const n )
+{
+    quantity<volume_d> x = seed1 * cube( meter );
+    quantity<length_d> sum;
+
+    for ( long i = 0; i < n; ++i, x += 1e-9 * cube( meter ) )
+        sum += nth_root<3>( x );
+
+    return sum.magnitude();
+}
+
+// Conversions through other_units.hpp: miles per hour to feet per minute.
+
+double convert_double( long const n )
+{
+    double x = seed1, sum = 0;
+
+    for ( long i = 0; i < n; ++i, x += 1e-9 )
+        sum += ( x * 1609.344 / 3600 ) / ( 0.3048 / 60 );
+
+    return sum;
+}
+
+double convert_quantity( long const n )
+{
+    double x = seed1, sum = 0;
+
+    for ( long i = 0; i < n; ++i, x += 1e-9 )
+        sum += ( x * mile / hour ) / ( foot / minute );
+
+    return sum;
+}
+
+// Data kept in feet: scaled_quantity converts with a multiplication by a
+// compile-time factor, quantity::to() divides by the unit.
+
+typedef scaled_quantity<length_d, scales::foot> feet;
+
+double feet_to_meter_double( long const n )
+{
+    double x = seed1, sum = 0;
+
+    for ( long i = 0; i < n; ++i, x += 1e-9 )
+        sum += x * 0.3048;
+
+    return sum;
+}
+
+double feet_to_meter_quantity( long const n )
+{
+    double x = seed1, sum = 0;
+
+    for ( long i = 0; i < n; ++i, x += 1e-9 )
+        sum += feet( detail::magnitude_tag, x ).si().magnitude();
+
+    return sum;
+}
+
+double meter_to_feet_to( long const n )
+{
+    double x = seed1, sum = 0;
+
+    for ( long i = 0; i < n; ++i, x += 1e-9 )
+        sum += ( x * meter ).to( foot );
+
+    return sum;
+}
+
+double meter_to_feet_quantity( long const n )
+{
+    double x = seed1, sum = 0;
+
+    for ( long i = 0; i < n; ++i, x += 1e-9 )
+        sum += feet( x * meter ).magnitude();
+
+    return sum;
+}
+
+// Scaling a float array by a literal: literals::f32 keeps the loop in float,
+// so that it vectorizes; the default long double literal does not.
+// On Intel processors affected by the JCC erratum, the ratio of these tight
+// loops also depends on code placement; -Wa,-mbranches-within-32B-boundaries
+// removes that effect.
+
+const int block = 1000;
+
+float in_float[block], out_float[block];
+
+quantity<length_d, float> in_length[block];
+quantity<area_d  , float> out_area[block];
+
+void fill_inputs()
+{
+    for ( int k = 0; k < block; ++k )
+    {
+        in_float[k]  = static_cast<float>( seed1 * k );
+        in_length[k] = in_float[k] * quantity<length_d, float>( meter );
+    }
+}
+
+double scale_float_double( long const n )
+{
+    fill_inputs();
+
+    for ( long i = 0; i < n; i += block )
+    {
+        for ( int k = 0; k < block; ++k )
+            out_float[k] = in_float[k] * 0.0254f;
+    }
+    return out_float[n % block];
+}
+
+double scale_f32_quantity( long const n )
+{
+    using namespace literals::f32;
+
+    fill_inputs();
+
+    for ( long i = 0; i < n; i += block )
+    {
+        for ( int k = 0; k < block; ++k )
+            out_area[k] = in_length[k] * 2.54_cm;
+    }
+    return out_area[n % block].magnitude();
+}
+
+double scale_default_quantity( long const n )
+{
+    using namespace literals;
+
+    fill_inputs();
+
+    for ( long i = 0; i < n; i += block )
+    {
+        for ( int k = 0; k < block; ++k )
+            out_area[k] = in_length[k] * 2.54_cm;
+    }
+    return out_area[n % block].magnitude();
+}
+
+// 16-bit storage: narrowing float samples to half with convert(), compared
+// with the same conversion on plain arrays; and a mean over a history that
+// does not fit in the cache, stored as half and as float.
+
+std::uint16_t out_bits[block];
+
+quantity<length_d, half> out_half[block];
+
+double narrow_bits( long const n )
+{
+    fill_inputs();
+
+    for ( long i = 0; i < n; i += block )
+    {
+        for ( int k = 0; k < block; ++k )
+            out_bits[k] = detail::half_from_float( in_float[k] );
+    }
+    return out_bits[n % block];
+}
+
+double narrow_quantity( long const n )
+{
+    fill_inputs();
+
+    for ( long i = 0; i < n; i += block )
+    {
+        convert( in_length, in_length + block, out_half );
+    }
+    return out_half[n % block].magnitude().bits();
+}
+
+const std::size_t history = std::size_t( 1000 ) << 14;
+
+double history_float( long const n )
+{
+    static std::vector<float> v( history, static_cast<float>( seed1 ) );
+
+    float sum = 0;
+
+    for ( long i = 0; i < n; i += block )
+    {
+        std::size_t const first = i % history;
+
+        for ( int k = 0; k < block; ++k )
+            sum += v[first + k];
+    }
+    return sum / n;
+}
+
+double history_half( long const n )
+{
+    static std::vector< quantity<pressure_d, half> > v( history, quantity<pressure_d, half>( seed1 * pascal ) );
+
+    quantity<pressure_d, float> buffer[block];
+    quantity<pressure_d, float> sum;
+
+    for ( long i = 0; i < n; i += block )
+    {
+        std::size_t const first = i % history;
+
+        convert( &v[first], &v[first] + block, buffer );
+
+        for ( int k = 0; k < block; ++k )
+            sum += buffer[k];
+    }
+    return sum.magnitude() / n;
+}
+
+// Batch conversion: 10^8 pressures in psi converted to bar in blocks, one by
+// one with to(), which divides, compared with convert(), which multiplies by
+// a factor computed once.
+
+const std::size_t feed_block = 16384;
+
+double feed_to( long const n )
+{
+    std::vector<double> const in( feed_block, double( seed1 ) );
+    std::vector<double> out( feed_block );
+    double sum = 0;
+
+    for ( long i = 0; i < n; i += static_cast<long>( feed_block ) )
+    {
+        for ( std::size_t k = 0; k < feed_block; ++k )
+            out[k] = ( in[k] * psi ).to( bar );
+
+        sum += out[ std::size_t( i ) % feed_block ];
+    }
+    return sum;
+}
+
+double feed_convert( long const n )
+{
+    std::vector<double> const in( feed_block, double( seed1 ) );
+    std::vector<double> out( feed_block );
+    double sum = 0;
+
+    for ( long i = 0; i < n; i += static_cast<long>( feed_block ) )
+    {
+        convert( in, psi, bar, out );
+
+        sum += out[ std::size_t( i ) % feed_block ];
+    }
+    return sum;
+}
+
+// Temperature points: 10^8 sensor samples in degree Fahrenheit converted to
+// kelvin in blocks, with the textbook formula, compared with convert_points(),
+// which takes one multiply-add with a factor and a term folded at compile time.
+
+double sensor_formula( long const n )
+{
+    std::vector<double> const in( feed_block, double( seed1 ) );
+    std::vector<double> out( feed_block );
+    double sum = 0;
+
+    for ( long i = 0; i < n; i += static_cast<long>( feed_block ) )
+    {
+        for ( std::size_t k = 0; k < feed_block; ++k )
+            out[k] = ( in[k] - 32.0 ) * 5.0 / 9.0 + 273.15;
+
+        sum += out[ std::size_t( i ) % feed_block ];
+    }
+    return sum;
+}
+
+double sensor_convert( long const n )
+{
+    std::vector<double> const in( feed_block, double( seed1 ) );
+    std::vector<double> out( feed_block );
+    double sum = 0;
+
+    for ( long i = 0; i < n; i += static_cast<long>( feed_block ) )
+    {
+        convert_points<origins::fahrenheit, origins::kelvin>( in.data(), in.data() + feed_block, out.data() );
+
+        sum += out[ std::size_t( i ) % feed_block ];
+    }
+    return sum;
+}
+
+// Dynamic dimensions: the arithmetic kernel with the dimensions checked at
+// run time, compared with static quantities.
+
+double arithmetic_dynamic( long const n )
+{
+    dynamic_quantity<> const v2 = seed2 * meter;
+    dynamic_quantity<> x1 = seed1 * meter / second;
+    dynamic_quantity<> x2 = v2;
+    dynamic_quantity<> x3 = seed3 * second;
+
+    for ( long i = 0; i < n; ++i )
+    {
+        x2 = -x2 - v2;
+        x3 *= 1.00002;
+        x1 += x2 / x3;
+    }
+    return x1.magnitude();
+}
+
+// Zero-copy views: sensor blocks of raw doubles copied into quantities one
+// by one, compared with viewing them in place with a quantity_span.
+
+const std::size_t sensor_block = 4096;
+
+std::vector<double> const & sensor_data()
+{
+    static std::vector<double> const v( sensor_block * 16, double( seed1 ) );
+    return v;
+}
+
+double sensor_copy( long const n )
+{
+    std::vector<double> const & raw = sensor_data();
+    quantity<pressure_d> sum;
+
+    for ( long i = 0; i < n; i += static_cast<long>( sensor_block ) )
+    {
+        double const * const block = &raw[ std::size_t( i ) % raw.size() ];
+
+        std::vector< quantity<pressure_d> > q;
+        q.reserve( sensor_block );
+
+        for ( std::size_t k = 0; k < sensor_block; ++k )
+            q.push_back( quantity<pressure_d>( detail::magnitude_tag, block[k] ) );
+
+        for ( quantity<pressure_d> const & p : q )
+            sum += p;
+    }
+    return sum.magnitude();
+}
+
+double sensor_span( long const n )
+{
+    std::vector<double> const & raw = sensor_data();
+    quantity<pressure_d> sum;
+
+    for ( long i = 0; i < n; i += static_cast<long>( sensor_block ) )
+    {
+        quantity_span<pressure_d, double const> const q = make_span<pressure_d>( &raw[ std::size_t( i ) % raw.size() ], sensor_block );
+
+        for ( quantity<pressure_d> const & p : q )
+            sum += p;
+    }
+    return sum.magnitude();
+}
+
+// Fixed-size vectors: Euler's equations of a rigid body, dw = I^-1 ( t - w x I w ) dt,
+// written out by hand on double[3] and with quantity_vec and quantity_mat.
+
+double rigid_body_double( long const n )
+{
+    double const inertia[9]  = { 2, 0.1, 0, 0.1, 3, 0, 0, 0, 4 };
+    double const inverse[9]  = { 0.5, 0, 0, 0, 1.0 / 3, 0, 0, 0, 0.25 };
+    double const torque[3]   = { seed1, seed2, seed3 };
+    double w[3] = { seed3, seed2, seed1 };
+
+    for ( long i = 0; i < n; ++i )
+    {
+        double l[3], t[3];
+
+        for ( int r = 0; r < 3; ++r )
+            l[r] = inertia[3 * r] * w[0] + inertia[3 * r + 1] * w[1] + inertia[3 * r + 2] * w[2];
+
+        t[0] = torque[0] - ( w[1] * l[2] - w[2] * l[1] );
+        t[1] = torque[1] - ( w[2] * l[0] - w[0] * l[2] );
+        t[2] = torque[2] - ( w[0] * l[1] - w[1] * l[0] );
+
+        for ( int r = 0; r < 3; ++r )
+            w[r] += ( inverse[3 * r] * t[0] + inverse[3 * r + 1] * t[1] + inverse[3 * r + 2] * t[2] ) * 1e-6;
+    }
+    return w[0] + w[1] + w[2];
+}
+
+double rigid_body_quantity( long const n )
+{
+    typedef dimensions< 2, 1, 0 > inertia_d;
+    typedef dimensions< -2, -1, 0 > inverse_inertia_d;
+
+    quantity<inertia_d> const kgm2 = kilogram * square( meter );
+    quantity<time_interval_d> const dt = 1e-6 * second;
+
+    mat3< quantity<inertia_d> > const inertia( 2 * kgm2, 0.1 * kgm2, 0 * kgm2, 0.1 * kgm2, 3 * kgm2, 0 * kgm2, 0 * kgm2, 0 * kgm2, 4 * kgm2 );
+    mat3< quantity<inverse_inertia_d> > const inverse( 0.5 / kgm2, 0 / kgm2, 0 / kgm2, 0 / kgm2, ( 1.0 / 3 ) / kgm2, 0 / kgm2, 0 / kgm2, 0 / kgm2, 0.25 / kgm2 );
+    vec3< quantity<energy_d> > const torque( seed1 * newton * meter, seed2 * newton * meter, seed3 * newton * meter );
+    vec3< quantity<angular_velocity_d> > w( seed3 / second, seed2 / second, seed1 / second );
+
+    for ( long i = 0; i < n; ++i )
+    {
+        w += inverse * ( torque - cross( w, inertia * w ) ) * dt;
+    }
+    return ( w[0] + w[1] + w[2] ).magnitude();
+}
+
+// Batched integration: 4096 independent harmonic oscillators with their own
+// frequency, one RK4 step for all of them per 4096 operations, written out by
+// hand on arrays of double and with rk4 on a tuple of quantity_vectors.
+
+const std::size_t batch_size = 4096;
+
+double batch_double( long const n )
+{
+    std::vector<double> w2( batch_size ), x( batch_size, double( seed1 ) ), v( batch_size, double( seed2 ) );
+    std::vector<double> k1x( batch_size ), k1v( batch_size ), k2x( batch_size ), k2v( batch_size );
+    std::vector<double> k3x( batch_size ), k3v( batch_size ), k4x( batch_size ), k4v( batch_size );
+
+    for ( std::size_t i = 0; i < batch_size; ++i )
+        w2[i] = 1.0 + 0.001 * i;
+
+    double const h = 1e-3;
+
+    for ( long step = 0; step < n; step += static_cast<long>( batch_size ) )
+    {
+        for ( std::size_t i = 0; i < batch_size; ++i )
+        {
+            k1x[i] = v[i];
+            k1v[i] = -w2[i] * x[i];
+            k2x[i] = v[i] + 0.5 * h * k1v[i];
+            k2v[i] = -w2[i] * ( x[i] + 0.5 * h * k1x[i] );
+            k3x[i] = v[i] + 0.5 * h * k2v[i];
+            k3v[i] = -w2[i] * ( x[i] + 0.5 * h * k2x[i] );
+            k4x[i] = v[i] + h * k3v[i];
+            k4v[i] = -w2[i] * ( x[i] + h * k3x[i] );
+            x[i] += h / 6 * ( k1x[i] + 2 * k2x[i] + 2 * k3x[i] + k4x[i] );
+            v[i] += h / 6 * ( k1v[i] + 2 * k2v[i] + 2 * k3v[i] + k4v[i] );
+        }
+    }
+    return x[0] + x[batch_size - 1];
+}
+
+typedef std::tuple< quantity_vector<length_d>, quantity_vector<speed_d> > batch_state;
+
+double batch_quantity( long const n )
+{
+    typedef state_derivative< batch_state, quantity<time_interval_d> >::type batch_derivative;
+
+    quantity_vector< dimensions< 0, 0, -2 > > w2( batch_size );
+    batch_state y( quantity_vector<length_d>( batch_size, seed1 * meter ), quantity_vector<speed_d>( batch_size, seed2 * meter / second ) );
+
+    for ( std::size_t i = 0; i < batch_size; ++i )
+        w2[i] = ( 1.0 + 0.001 * i ) / square( second );
+
+    auto const sys = [&w2]( batch_state const & s, batch_derivative & dsdt, quantity<time_interval_d> )
+    {
+        std::get<0>( dsdt ) = std::get<1>( s );
+        std::get<1>( dsdt ) = -( w2 * std::get<0>( s ) );
+    };
+
+    rk4<batch_state> stepper;
+    quantity<time_interval_d> const h = 1e-3 * second;
+
+    for ( long step = 0; step < n; step += static_cast<long>( batch_size ) )
+        stepper.do_step( sys, y, step * h, h );
+
+    return ( std::get<0>( y )[0] + std::get<0>( y )[batch_size - 1] ).magnitude();
+}
+
+// Fixed point: an oscillator in Q16.16 as firmware without FPU runs it,
+// written out by hand on std::int32_t with the same rounding and saturation,
+// and on float, which such a target emulates in software.
+
+const double omega   = 0.5;
+const double dt      = 0.0625;
+
+std::int32_t q16_saturate( std::int64_t const x )
+{
+    return x > INT32_MAX ? INT32_MAX : x < INT32_MIN ? INT32_MIN : static_cast<std::int32_t>( x );
+}
+
+std::int32_t q16_mul( std::int32_t const x, std::int32_t const y )
+{
+    return q16_saturate( ( std::int64_t( x ) * y + 0x8000 ) >> 16 );
+}
+
+double oscillator_int32( long const n )
+{
+    std::int32_t const w2 = q16_mul( q16_16( omega ).raw(), q16_16( omega ).raw() );
+    std::int32_t const h  = q16_16( dt ).raw();
+
+    std::int32_t x = q16_16( seed1 ).raw(), v = 0;
+
+    for ( long i = 0; i < n; ++i )
+    {
+        v = q16_saturate( std::int64_t( v ) - q16_mul( q16_mul( x, w2 ), h ) );
+        x = q16_saturate( std::int64_t( x ) + q16_mul( v, h ) );
+    }
+    return x / 65536.0;
+}
+
+double oscillator_float( long const n )
+{
+    float const w2 = static_cast<float>( omega * omega );
+    float const h  = static_cast<float>( dt );
+
+    float x = static_cast<float>( seed1 ), v = 0;
+
+    for ( long i = 0; i < n; ++i )
+    {
+        v -= x * w2 * h;
+        x += v * h;
+    }
+    return x;
+}
+
+double oscillator_quantity( long const n )
+{
+    quantity<frequency_d, q16_16> const w = omega * hertz;
+    quantity<time_interval_d, q16_16> const h = dt * second;
+
+    auto const w2 = w * w;
+
+    quantity<length_d, q16_16> x = seed1 * meter;
+    quantity<speed_d, q16_16> v;
+
+    for ( long i = 0; i < n; ++i )
+    {
+        v -= x * w2 * h;
+        x += v * h;
+    }
+    return static_cast<double>( x.magnitude() );
+}
+
+// Reductions: a plain loop on double, compared with compensated summation,
+// sequentially and with a thread_executor.
+
+std::vector<double> const & samples()
+{
+    static std::vector<double> v;
+
+    if ( v.empty() )
+    {
+        for ( int i = 0; i < 1 << 20; ++i )
+            v.push_back( seed1 * ( i % 1000 ) );
+    }
+    return v;
+}
+
+std::vector< quantity<power_d> > const & power_samples()
+{
+    static std::vector< quantity<power_d> > v;
+
+    if ( v.empty() )
+    {
+        for ( double x : samples() )
+            v.push_back( x * watt );
+    }
+    return v;
+}
+
+double sum_double( long const n )
+{
+    std::vector<double> const & v = samples();
+    double sum = 0;
+
+    for ( long i = 0; i < n; i += v.size() )
+    {
+        for ( double x : v )
+            sum += x;
+    }
+    return sum;
+}
+
+// a pool of four threads, whatever the number of cores.
+
+struct four_thread_executor : thread_executor
+{
+    four_thread_executor() : thread_executor( 4 ) { }
+};
+
+template< typename Executor >
+double sum_quantity( long const n )
+{
+    static Executor const exec;
+
+    std::vector< quantity<power_d> > const & v = power_samples();
+    quantity<power_d> total;
+
+    for ( long i = 0; i < n; i += v.size() )
+        total += sum( v.begin(), v.end(), exec );
+
+    return total.magnitude();
+}
+
+// A long running sum: accumulating in long double, the usual remedy for
+// lost digits, compared with quantity_accumulator on double.
+
+double accumulate_long_double( long const n )
+{
+    long double sum = seed1, x = seed2;
+
+    for ( long i = 0; i < n; ++i, x += 1e-9L )
+        sum += x;
+
+    return static_cast<double>( sum );
+}
+
+double accumulate_quantity( long const n )
+{
+    quantity_accumulator<energy_d> sum( seed1 * joule );
+    quantity<energy_d> x = seed2 * joule;
+
+    for ( long i = 0; i < n; ++i, x += 1e-9 * joule )
+        sum += x;
+
+    return sum.value().magnitude();
+}
+
+// Formatting and parsing, compared with the C library.
+
+std::vector<double> const & values()
+{
+    static std::vector<double> v;
+
+    if ( v.empty() )
+    {
+        std::srand( 42 );
+
+        for ( int i = 0; i < 1024; ++i )
+            v.push_back( std::rand() / 1024.0 );
+    }
+    return v;
+}
+
+// values with full 53-bit mantissas, as from measurements.
+
+std::vector<double> const & mantissa_values()
+{
+    static std::vector<double> v;
+
+    if ( v.empty() )
+    {
+        std::mt19937_64 random( 42 );
+        std::uniform_real_distribution<double> distribution( 0, 1000 );
+
+        for ( int i = 0; i < 1024; ++i )
+            v.push_back( distribution( random ) );
+    }
+    return v;
+}
+
+std::vector<std::string> const & fields()
+{
+    static std::vector<std::string> f;
+
+    if ( f.empty() )
+    {
+        for ( double v : values() )
+        {
+            char text[64];
+            std::snprintf( text, sizeof text, "%.17g m", v );
+            f.push_back( text );
+        }
+    }
+    return f;
+}
+
+double snprintf_double( long const n )
+{
+    std::vector<double> const & v = mantissa_values();
+    char text[64];
+    double sum = 0;
+
+    for ( long i = 0; i < n; ++i )
+        sum += std::snprintf( text, sizeof text, "%.17g m", v[i % v.size()] );
+
+    return sum;
+}
+
+double to_chars_quantity( long const n )
+{
+    std::vector<double> const & v = mantissa_values();
+    char text[64];
+    double sum = 0;
+
+    for ( long i = 0; i < n; ++i )
+        sum += to_chars( text, text + sizeof text, v[i % v.size()] * meter ).ptr - text;
+
+    return sum;
+}
+
+double eng_snprintf_double( long const n )
+{
+    std::vector<double> const & v = values();
+    char text[64];
+    double sum = 0;
+
+    for ( long i = 0; i < n; ++i )
+        sum += std::snprintf( text, sizeof text, "%.2f km", v[i % v.size()] / 1000 );
+
+    return sum;
+}
+
+double eng_to_chars_quantity( long const n )
+{
+    std::vector<double> const & v = values();
+    char text[64];
+    double sum = 0;
+
+    for ( long i = 0; i < n; ++i )
+        sum += to_engineering_chars( text, text + sizeof text, v[i % v.size()] * meter ).ptr - text;
+
+    return sum;
+}
+
+double strtod_double( long const n )
+{
+    std::vector<std::string> const & f = fields();
+    double sum = 0;
+
+    for ( long i = 0; i < n; ++i )
+        sum += std::strtod( f[i % f.size()].c_str(), nullptr );
+
+    return sum;
+}
+
+double from_chars_quantity( long const n )
+{
+    std::vector<std::string> const & f = fields();
+    double sum = 0;
+
+    for ( long i = 0; i < n; ++i )
+    {
+        std::string const & s = f[i % f.size()];
+        quantity<length_d> q;
+        from_chars( s.data(), s.data() + s.size(), q );
+        sum += q.magnitude();
+    }
+    return sum;
+}
+
+// Persistence: a series of lengths written and read back as text, one per
+// line with io::to_string() and from_chars(), compared with the binary
+// column format of quantity_io_binary.hpp.
+
+double round_trip_text( long const n )
+{
+    std::vector<double> const & v = values();
+    double sum = 0;
+
+    for ( long i = 0; i < n; i += static_cast<long>( v.size() ) )
+    {
+        std::ostringstream os;
+
+        for ( double x : v )
+            os << io::to_string( x * meter ) << '\n';
+
+        std::string const text = os.str();
+        char const * first = text.data();
+        char const * const last = first + text.size();
+
+        while ( first != last )
+        {
+            quantity<length_d> q;
+            first = from_chars( first, last, q ).ptr + 1;
+            sum += q.magnitude();
+        }
+    }
+    return sum;
+}
+
+double round_trip_column( long const n )
+{
+    std::vector<double> const & v = values();
+    quantity_vector<length_d> const series( detail::magnitude_tag, v.data(), v.data() + v.size() );
+    double sum = 0;
+
+    for ( long i = 0; i < n; i += static_cast<long>( v.size() ) )
+    {
+        std::stringstream ss;
+
+        write_column( ss, series );
+
+        for ( quantity<length_d> const q : read_column<length_d, double>( ss ) )
+            sum += q.magnitude();
+    }
+    return sum;
+}
+
+// CSV ingestion: rows of time, speed in km/h and force in kN, the numeric
+// cells converted with strtod() in a hand-written loop, compared with a
+// csv_reader that reads speed and force into quantity_vectors in chunks.
+
+const std::size_t csv_rows = 100000;
+
+std::string const & csv_text()
+{
+    static std::string text;
+
+    if ( text.empty() )
+    {
+        std::vector<double> const & v = values();
+        text = "time [s],speed [km/h],force [kN]\n";
+
+        for ( std::size_t i = 0; i < csv_rows; ++i )
+        {
+            char row[96];
+            std::snprintf( row, sizeof row, "%zu,%.3f,%.4f\n", i, v[i % v.size()], v[( i + 7 ) % v.size()] / 1000 );
+            text += row;
+        }
+    }
+    return text;
+}
+
+double csv_strtod( long const n )
+{
+    std::string const & text = csv_text();
+    std::vector<double> speed( 65536 ), force( 65536 );
+    double sum = 0;
+
+    for ( long i = 0; i < n; i += static_cast<long>( csv_rows ) )
+    {
+        char const * p = std::strchr( text.c_str(), '\n' ) + 1;
+        std::size_t rows = 0;
+
+        while ( *p )
+        {
+            char * end;
+            std::strtod( p, &end );
+            speed[rows] = std::strtod( end + 1, &end ) / 3.6;
+            force[rows] = std::strtod( end + 1, &end ) * 1000;
+            p = end + 1;
+
+            if ( ++rows == speed.size() || !*p )
+            {
+                sum += speed[0] + force[rows - 1];
+                rows = 0;
+            }
+        }
+    }
+    return sum;
+}
+
+double csv_quantity( long const n )
+{
+    quantity_vector<speed_d> speed;
+    quantity_vector<force_d> force;
+    double sum = 0;
+
+    for ( long i = 0; i < n; i += static_cast<long>( csv_rows ) )
+    {
+        std::istringstream is( csv_text() );
+        csv_reader reader( is );
+
+        reader.bind( "speed", speed );
+        reader.bind( "force", force );
+
+        while ( std::size_t const rows = reader.read( 65536 ) )
+            sum += speed[0].magnitude() + force[rows - 1].magnitude();
+    }
+    return sum;
+}
+
+// Unit lookup: the units of a few column headers, parsed with parse_unit()
+// each time, compared with looked up in a unit_registry that memoized them.
+
+char const * const header_units[] = { "kg m/s^2", "km/h", "kW h", "N m" };
+
+double unit_parse( long const n )
+{
+    double sum = 0;
+
+    for ( long i = 0; i < n; ++i )
+    {
+        char const * const text = header_units[ i & 3 ];
+
+        detail::unit_value unit;
+        detail::parse_unit( text, text + std::strlen( text ), unit );
+
+        sum += static_cast<double>( unit.factor ) + unit.dims[2];
+    }
+    return sum;
+}
+
+double unit_lookup( long const n )
+{
+    unit_registry registry;
+    double sum = 0;
+
+    for ( long i = 0; i < n; ++i )
+    {
+        char const * const text = header_units[ i & 3 ];
+
+        registered_unit const & unit = registry.intern( text, text + std::strlen( text ) );
+
+        sum += static_cast<double>( unit.factor ) + unit.key.exponent( 2 );
+    }
+    return sum;
+}
+
+} // anonymous namespace
+
+int main( int argc, char * argv[] )
+{
+    bench::options opt;
+
+    if ( !bench::parse_options( argc, argv, opt ) )
+        return EXIT_FAILURE;
+
+    std::vector<bench::benchmark> const benchmarks =
+    {
+        { "arithmetic"                 , arithmetic_double     , arithmetic_quantity               ,  20 * meg, true  },
+        { "arithmetic, ohm*siemens"    , mixed_double          , mixed_quantity                    ,  20 * meg, true  },
+        { "cube"                       , cube_double           , cube_quantity                     ,  20 * meg, true  },
+        { "nth_power<3>"               , cube_double           , nth_power_quantity                ,  20 * meg, true  },
+        { "nth_power<4>"               , fourth_double         , fourth_quantity                   ,  20 * meg, true  },
+        { "sqrt"                       , sqrt_double           , sqrt_quantity                     ,  10 * meg, true  },
+        { "nth_root<3>"                , cbrt_double           , nth_root_quantity                 ,   5 * meg, true  },
+        { "convert mph to ft/min"      , convert_double        , convert_quantity                  ,  20 * meg, true  },
+        { "feet to meter"              , feet_to_meter_double  , feet_to_meter_quantity            ,  20 * meg, true  },
+        { "meter to feet, vs to()"     , meter_to_feet_to      , meter_to_feet_quantity            ,  20 * meg, false },
+        { "convert psi to bar, vs to()", feed_to               , feed_convert                      , 100 * meg, false },
+        { "fahrenheit to kelvin"       , sensor_formula        , sensor_convert                    , 100 * meg, false },
+        { "float * literals::f32"      , scale_float_double    , scale_f32_quantity                ,  50 * meg, true  },
+        { "float * default literal"    , scale_float_double    , scale_default_quantity            ,  50 * meg, false },
+        { "float to half, vs bits"     , narrow_bits           , narrow_quantity                   ,  20 * meg, true  },
+        { "mean of half, vs float"     , history_float         , history_half                      ,  20 * meg, false },
+        { "dynamic_quantity arithmetic", arithmetic_quantity   , arithmetic_dynamic                ,  20 * meg, false },
+        { "quantity_span, vs copy"     , sensor_copy           , sensor_span                       ,  20 * meg, false },
+        { "quantity_vec, rigid body"   , rigid_body_double     , rigid_body_quantity               ,  10 * meg, true  },
+        { "rk4 batch, vs fused loop"   , batch_double          , batch_quantity                    ,  20 * meg, false },
+        { "fixed point, vs int32_t"    , oscillator_int32      , oscillator_quantity               ,  20 * meg, true  },
+        { "fixed point, vs float"      , oscillator_float      , oscillator_quantity               ,  20 * meg, false },
+        { "sum"                        , sum_double            , sum_quantity<sequential_executor> , 100 * meg, false },
+        { "sum, thread_executor"       , sum_double            , sum_quantity<thread_executor>     , 100 * meg, false },
+        { "sum, four threads"          , sum_double            , sum_quantity<four_thread_executor>, 100 * meg, false },
+        { "accumulate, vs long double" , accumulate_long_double, accumulate_quantity               ,  20 * meg, false },
+        { "to_chars"                   , snprintf_double       , to_chars_quantity                 ,       meg, false },
+        { "to_engineering_chars"       , eng_snprintf_double   , eng_to_chars_quantity             ,       meg, false },
+        { "from_chars"                 , strtod_double         , from_chars_quantity               ,       meg, false },
+        { "csv_reader, vs strtod"      , csv_strtod            , csv_quantity                      ,       meg, false },
+        { "column i/o, vs text"        , round_trip_text       , round_trip_column                 ,       meg, false },
+        { "unit lookup, vs parse"      , unit_parse            , unit_lookup                       ,  10 * meg, false },
+    };
+
+    std::vector<bench::result> const results = bench::run( benchmarks, opt );
+
+    if ( opt.json )
+        bench::print_json( std::cout, results, opt );
+    else
+        bench::print_table( std::cout, results, opt );
+
+    return bench::regressions( results, opt ) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// g++ -Wall -Wextra -Weffc++ -std=c++11 -O2 -pthread -I../../ -o time_benchmark.exe time_benchmark.cpp && time_benchmark.exe
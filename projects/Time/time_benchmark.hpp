@@ -0,0 +1,255 @@
+/**
+ * \file time_benchmark.hpp
+ *
+ * \brief   utilities for quantity library benchmarks.
+ * \author  Martin Moene
+ * \date    16 October 2026
+ * \since   1.2
+ *
+ * This code is provided as-is, with no warrantee of correctness.
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See accompanying
+ * file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#ifndef TIME_BENCHMARK_HPP_INCLUDED
+#define TIME_BENCHMARK_HPP_INCLUDED
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/// prevent the compiler from optimizing away the computation of value.
+
+template< typename T >
+inline void do_not_optimize( T const & value )
+{
+#if defined( __GNUC__ )
+    asm volatile( "" : : "r,m"( value ) : "memory" );
+#else
+    static volatile char sink;
+    sink = *reinterpret_cast<char const volatile *>( &value );
+#endif
+}
+
+/// a loop of n operations; returns a value that depends on all of them.
+
+typedef double (*kernel)( long n );
+
+/// statistics over repeated measurements, in ns/op.
+
+struct statistics
+{
+    double median;
+    double mean;
+    double min;
+    double stddev;
+};
+
+inline statistics summarize( std::vector<double> samples )
+{
+    std::sort( samples.begin(), samples.end() );
+
+    std::size_t const n = samples.size();
+
+    double sum = 0, sum2 = 0;
+    for ( double s : samples ) { sum += s; sum2 += s * s; }
+
+    double const mean = sum / n;
+    double const var  = n > 1 ? std::max( 0.0, ( sum2 - n * mean * mean ) / ( n - 1 ) ) : 0;
+
+    return statistics{ n % 2 ? samples[n / 2] : ( samples[n / 2 - 1] + samples[n / 2] ) / 2, mean, samples[0], std::sqrt( var ) };
+}
+
+/// ns/op of one run of the kernel over n operations.
+
+inline double measure( kernel f, long const n )
+{
+    typedef std::chrono::steady_clock clock;
+
+    clock::time_point const start = clock::now();
+    do_not_optimize( f( n ) );
+    clock::time_point const stop = clock::now();
+
+    return std::chrono::duration<double, std::nano>( stop - start ).count() / n;
+}
+
+/// a quantity kernel and the equivalent computation on plain values.
+
+struct benchmark
+{
+    char const * name;
+    kernel baseline;
+    kernel quantity;
+    long operations;        ///< operations per run, before scaling.
+    bool zero_overhead;     ///< the ratio must be (close to) one.
+};
+
+struct result
+{
+    std::string name;
+    statistics baseline;
+    statistics quantity;
+    double ratio;
+    bool zero_overhead;
+};
+
+/// command line options.
+
+struct options
+{
+    options()
+    : json( false ), repetitions( 10 ), scale( 1.0 ), max_ratio( 0.0 ), filter() {}
+
+    bool json;
+    int repetitions;
+    double scale;
+    double max_ratio;
+    std::string filter;
+};
+
+inline bool option( char const * arg, char const * name, char const *& value )
+{
+    std::size_t const length = std::strlen( name );
+
+    if ( std::strncmp( arg, name, length ) != 0 || arg[length] != '=' )
+        return false;
+
+    value = arg + length + 1;
+    return true;
+}
+
+inline bool parse_options( int argc, char * argv[], options & opt )
+{
+    for ( int i = 1; i < argc; ++i )
+    {
+        char const * value = nullptr;
+
+        if      ( 0 == std::strcmp( argv[i], "--json" ) ) opt.json = true;
+        else if ( option( argv[i], "--repetitions", value ) ) opt.repetitions = std::max( 1, std::atoi( value ) );
+        else if ( option( argv[i], "--scale"      , value ) ) opt.scale = std::atof( value );
+        else if ( option( argv[i], "--max-ratio"  , value ) ) opt.max_ratio = std::atof( value );
+        else if ( option( argv[i], "--filter"     , value ) ) opt.filter = value;
+        else
+        {
+            std::cerr <<
+                "Usage: " << argv[0] << " [--json] [--repetitions=N] [--scale=F] [--filter=text] [--max-ratio=R]\n"
+                "\n"
+                "  --json            print the results as JSON\n"
+                "  --repetitions=N   measure each benchmark N times (default 10)\n"
+                "  --scale=F         multiply the number of operations per run by F\n"
+                "  --filter=text     only run benchmarks whose name contains text\n"
+                "  --max-ratio=R     fail if a zero-overhead benchmark's median ratio exceeds R\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+/// run the benchmarks; baseline and quantity runs are interleaved to share disturbances.
+
+inline std::vector<result> run( std::vector<benchmark> const & benchmarks, options const & opt )
+{
+    std::vector<result> results;
+
+    for ( benchmark const & b : benchmarks )
+    {
+        if ( std::string( b.name ).find( opt.filter ) == std::string::npos )
+            continue;
+
+        long const n = std::max( 1L, static_cast<long>( b.operations * opt.scale ) );
+
+        // warm up:
+        measure( b.baseline, n );
+        measure( b.quantity, n );
+
+        std::vector<double> tb, tq;
+
+        for ( int i = 0; i < opt.repetitions; ++i )
+        {
+            tb.push_back( measure( b.baseline, n ) );
+            tq.push_back( measure( b.quantity, n ) );
+        }
+
+        statistics const sb = summarize( tb );
+        statistics const sq = summarize( tq );
+
+        results.push_back( result{ b.name, sb, sq, sb.median > 0 ? sq.median / sb.median : 0, b.zero_overhead } );
+    }
+    return results;
+}
+
+inline void print_table( std::ostream & os, std::vector<result> const & results, options const & opt )
+{
+    os << "Median ns/op over " << opt.repetitions << " repetitions (+- standard deviation)\n\n" <<
+        std::left << std::setw( 28 ) << "benchmark" << std::right <<
+        std::setw( 20 ) << "baseline" << std::setw( 20 ) << "quantity" << std::setw( 8 ) << "ratio" << "\n" <<
+        std::string( 76, '-' ) << "\n";
+
+    for ( result const & r : results )
+    {
+        os << std::fixed << std::setprecision( 2 ) <<
+            std::left << std::setw( 28 ) << r.name << std::right <<
+            std::setw( 11 ) << r.baseline.median << " +- " << std::setw( 6 ) << r.baseline.stddev <<
+            std::setw( 11 ) << r.quantity.median << " +- " << std::setw( 6 ) << r.quantity.stddev <<
+            std::setw( 8 ) << r.ratio << ( r.zero_overhead ? "" : " *" ) << "\n";
+    }
+    if ( std::any_of( results.begin(), results.end(), []( result const & r ) { return !r.zero_overhead; } ) )
+        os << "\n* baseline is a different implementation; the ratio need not be one.\n";
+}
+
+inline void print_statistics( std::ostream & os, char const * name, statistics const & s )
+{
+    os << "\"" << name << "\": { \"median\": " << s.median << ", \"mean\": " << s.mean <<
+        ", \"min\": " << s.min << ", \"stddev\": " << s.stddev << " }";
+}
+
+inline void print_json( std::ostream & os, std::vector<result> const & results, options const & opt )
+{
+    os << std::setprecision( 6 ) << "{\n  \"unit\": \"ns/op\",\n  \"repetitions\": " << opt.repetitions << ",\n  \"benchmarks\": [\n";
+
+    for ( std::size_t i = 0; i < results.size(); ++i )
+    {
+        result const & r = results[i];
+
+        os << "    { \"name\": \"" << r.name << "\", \"zero_overhead\": " << ( r.zero_overhead ? "true" : "false" ) << ",\n      ";
+        print_statistics( os, "baseline", r.baseline );
+        os << ",\n      ";
+        print_statistics( os, "quantity", r.quantity );
+        os << ",\n      \"ratio\": " << r.ratio << " }" << ( i + 1 < results.size() ? "," : "" ) << "\n";
+    }
+    os << "  ]\n}\n";
+}
+
+/// number of zero-overhead benchmarks with a ratio above opt.max_ratio, if given.
+
+inline int regressions( std::vector<result> const & results, options const & opt )
+{
+    int count = 0;
+
+    for ( result const & r : results )
+    {
+        if ( opt.max_ratio > 0 && r.zero_overhead && r.ratio > opt.max_ratio )
+        {
+            std::cerr << "regression: " << r.name << ": ratio " << r.ratio << " exceeds " << opt.max_ratio << "\n";
+            ++count;
+        }
+    }
+    return count;
+}
+
+} // namespace bench
+
+#endif // TIME_BENCHMARK_HPP_INCLUDED
+
+/*
+ * end of file
+ */
@@ -0,0 +1,232 @@
+//
+// time_compile.cpp - compile-time performance measurement for quantity library
+//
+// This code is provided as-is, with no warrantee of correctness.
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This program generates a translation unit that uses N distinct dimension
+// combinations in products, quotients, powers and roots, and an equivalent
+// translation unit that uses double. It compiles both with the front end
+// only (-fsyntax-only) and reports the time and, where available, the peak
+// memory use of the compiler, so that changes to the type generators in
+// quantity.hpp can be measured.
+//
+// With --max-ratio=R, the program fails if the quantity translation unit
+// takes more than R times as long as the double one.
+// Run with --help for all options.
+
+#include "time_benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+# include <sys/resource.h>
+# define TIME_COMPILE_HAVE_RUSAGE  1
+#else
+# define TIME_COMPILE_HAVE_RUSAGE  0
+#endif
+
+#ifndef TIME_COMPILE_CXX
+# define TIME_COMPILE_CXX  "g++"
+#endif
+
+#ifndef TIME_COMPILE_INCLUDE_DIR
+# define TIME_COMPILE_INCLUDE_DIR  "../../"
+#endif
+
+namespace {
+
+/// exponents of the i-th combination: the digits of i in base 5, offset by -2.
+
+std::string dimensions_of( int i )
+{
+    std::string text = "dimensions<";
+
+    for ( int k = 0; k < 7; ++k, i /= 5 )
+    {
+        text += std::to_string( i % 5 - 2 ) + ( k < 6 ? "," : ">" );
+    }
+    return text;
+}
+
+void generate_quantity( std::ostream & os, int const count )
+{
+    os << "#include \"phys/units/quantity.hpp\"\n\nusing namespace phys::units;\n\n";
+
+    for ( int i = 0; i < count; ++i )
+    {
+        os <<
+            "double f" << i << "( quantity<" << dimensions_of( i ) << "> const & x, quantity<" << dimensions_of( i + count ) << "> const & y )\n"
+            "{\n"
+            "    return ( x * y ).magnitude() + ( x / y ).magnitude() + nth_power<2>( x ).magnitude() + sqrt( x * x ).magnitude();\n"
+            "}\n\n";
+    }
+}
+
+void generate_double( std::ostream & os, int const count )
+{
+    os << "#include \"phys/units/quantity.hpp\"\n\n#include <cmath>\n\n";
+
+    for ( int i = 0; i < count; ++i )
+    {
+        os <<
+            "double f" << i << "( double const & x, double const & y )\n"
+            "{\n"
+            "    return ( x * y ) + ( x / y ) + std::pow( x, 2.0 ) + std::sqrt( x * x );\n"
+            "}\n\n";
+    }
+}
+
+struct measurement
+{
+    double seconds;
+    long   max_rss_kb;
+};
+
+/// compile file with the front end only; seconds < 0 on failure.
+
+measurement compile( std::string const & compiler, std::string const & flags, std::string const & file )
+{
+    std::string const command = compiler + " -std=c++11 -fsyntax-only " + flags + " -I" TIME_COMPILE_INCLUDE_DIR " " + file;
+
+    typedef std::chrono::steady_clock clock;
+
+    clock::time_point const start = clock::now();
+    int const status = std::system( command.c_str() );
+    clock::time_point const stop = clock::now();
+
+    long max_rss_kb = 0;
+#if TIME_COMPILE_HAVE_RUSAGE
+    rusage usage;
+    if ( 0 == getrusage( RUSAGE_CHILDREN, &usage ) )
+    {
+# if defined( __APPLE__ )
+        max_rss_kb = usage.ru_maxrss / 1024;
+# else
+        max_rss_kb = usage.ru_maxrss;
+# endif
+    }
+#endif
+
+    return measurement{ status == 0 ? std::chrono::duration<double>( stop - start ).count() : -1, max_rss_kb };
+}
+
+} // anonymous namespace
+
+int main( int argc, char * argv[] )
+{
+    int count = 1000;
+    int repetitions = 3;
+    double max_ratio = 0;
+    bool json = false;
+    std::string compiler = TIME_COMPILE_CXX;
+    std::string flags;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        char const * value = nullptr;
+
+        if      ( 0 == std::strcmp( argv[i], "--json" ) ) json = true;
+        else if ( bench::option( argv[i], "--count"      , value ) ) count = std::max( 1, std::atoi( value ) );
+        else if ( bench::option( argv[i], "--repetitions", value ) ) repetitions = std::max( 1, std::atoi( value ) );
+        else if ( bench::option( argv[i], "--max-ratio"  , value ) ) max_ratio = std::atof( value );
+        else if ( bench::option( argv[i], "--compiler"   , value ) ) compiler = value;
+        else if ( bench::option( argv[i], "--flags"      , value ) ) flags = value;
+        else
+        {
+            std::cerr <<
+                "Usage: " << argv[0] << " [--json] [--count=N] [--repetitions=N] [--compiler=cxx] [--flags=text] [--max-ratio=R]\n"
+                "\n"
+                "  --json            print the results as JSON\n"
+                "  --count=N         number of distinct dimension combinations (default 1000)\n"
+                "  --repetitions=N   compile each translation unit N times (default 3)\n"
+                "  --compiler=cxx    compiler to use (default " TIME_COMPILE_CXX ")\n"
+                "  --flags=text      additional compiler flags\n"
+                "  --max-ratio=R     fail if quantity takes more than R times as long as double\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    char const * const file_double   = "time_compile_double.cpp";
+    char const * const file_quantity = "time_compile_quantity.cpp";
+
+    {
+        std::ofstream os_double( file_double );
+        std::ofstream os_quantity( file_quantity );
+
+        generate_double( os_double, count );
+        generate_quantity( os_quantity, count );
+    }
+
+    std::vector<double> td, tq;
+    long rss_double = 0, rss_quantity = 0;
+
+    for ( int i = 0; i < repetitions; ++i )
+    {
+        // Peak memory of children is cumulative, so compile the smaller unit first.
+        measurement const md = compile( compiler, flags, file_double );
+        measurement const mq = compile( compiler, flags, file_quantity );
+
+        if ( md.seconds < 0 || mq.seconds < 0 )
+        {
+            std::cerr << argv[0] << ": compilation failed\n";
+            return EXIT_FAILURE;
+        }
+
+        td.push_back( md.seconds );
+        tq.push_back( mq.seconds );
+
+        if ( i == 0 )
+        {
+            rss_double   = md.max_rss_kb;
+            rss_quantity = mq.max_rss_kb;
+        }
+    }
+
+    std::remove( file_double );
+    std::remove( file_quantity );
+
+    bench::statistics const sd = bench::summarize( td );
+    bench::statistics const sq = bench::summarize( tq );
+
+    double const ratio = sq.median / sd.median;
+
+    if ( json )
+    {
+        std::cout << std::setprecision( 6 ) <<
+            "{\n  \"unit\": \"s\",\n  \"count\": " << count << ",\n  \"repetitions\": " << repetitions << ",\n  ";
+        bench::print_statistics( std::cout, "double", sd );
+        std::cout << ",\n  ";
+        bench::print_statistics( std::cout, "quantity", sq );
+        std::cout << ",\n  \"max_rss_kb\": { \"double\": " << rss_double << ", \"quantity\": " << rss_quantity << " },\n" <<
+            "  \"ratio\": " << ratio << "\n}\n";
+    }
+    else
+    {
+        std::cout << std::fixed << std::setprecision( 3 ) <<
+            "Front-end time of " << count << " distinct dimension combinations, median over " << repetitions << " repetitions\n\n" <<
+            "double:   " << sd.median << " s +- " << sd.stddev << ( rss_double   ? ", max RSS " + std::to_string( rss_double   / 1024 ) + " MB" : std::string() ) << "\n" <<
+            "quantity: " << sq.median << " s +- " << sq.stddev << ( rss_quantity ? ", max RSS " + std::to_string( rss_quantity / 1024 ) + " MB" : std::string() ) << "\n" <<
+            "ratio:    " << ratio << ", " << 1e3 * ( sq.median - sd.median ) / count << " ms per combination\n";
+    }
+
+    if ( max_ratio > 0 && ratio > max_ratio )
+    {
+        std::cerr << "regression: ratio " << ratio << " exceeds " << max_ratio << "\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+// g++ -Wall -Wextra -Weffc++ -std=c++11 -O2 -I../../ -o time_compile.exe time_compile.cpp && time_compile.exe
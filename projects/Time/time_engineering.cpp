@@ -0,0 +1,166 @@
+//
+// time_engineering.cpp - performance of engineering notation for quantity library
+//
+// This code is provided as-is, with no warrantee of correctness.
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This program compares to_engineering_chars() and to_engineering_string()
+// with the previous implementation that used log10(), pow() and
+// std::ostringstream, and verifies that both produce the same text.
+
+#include "phys/units/quantity.hpp"
+#include "phys/units/quantity_io_engineering.hpp"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <time.h>
+
+using namespace phys::units;
+using namespace std;
+
+const int meg = 1000000;
+const int k = 1; // scale factor - make it bigger for faster machines
+
+// previous implementation, for reference.
+
+std::string stream_engineering_string( double const value, int const digits = 3, bool exponential = false, bool const showpos = false, std::string const unit = "" )
+{
+    using namespace detail;
+
+    if      ( std::isnan( value ) ) return "NaN";
+    else if ( std::isinf( value ) ) return "INFINITE";
+
+    const int degree = degree_of( value );
+
+    std::string factor;
+
+    if ( std::abs( degree ) < prefix_count )
+    {
+        factor = std::string( exponential || 0 == degree ? "" : " " ) + prefixes[ exponential ][ sign(degree) > 0 ][ std::abs( degree ) ];
+    }
+    else
+    {
+        exponential = true;
+        std::ostringstream os;
+        os << "e" << 3 * degree;
+        factor = os.str();
+    }
+
+    std::ostringstream os;
+
+    const double scaled = value * std::pow( 1000.0, -degree );
+
+    const std::string space = ( 0 == degree || exponential ) && unit.length() ? " ":"";
+
+    const std::string bracketed = std::string::npos != unit.find_first_of( "+- " ) ? "(" + unit + ")" : unit;
+
+    os << std::fixed << (showpos ? std::showpos : std::noshowpos) << std::setprecision( precision(scaled, digits) ) << scaled << factor << space << bracketed;
+
+    return os.str();
+}
+
+/// values of all magnitudes, including powers of ten and halfway cases.
+
+std::vector<double> make_values( int const n )
+{
+    std::vector<double> values;
+
+    for ( int e = -30; e <= 30; ++e )
+    {
+        double const p = std::pow( 10.0, e );
+
+        for ( double m : { 1.0, 0.9995, 0.99995, 1.0005, 1.25, 1.5, 2.5, 9.995, 99.95, 999.5 } )
+        {
+            values.push_back(  m * p );
+            values.push_back( -m * p );
+        }
+    }
+
+    values.push_back( 0.0 );
+    values.push_back( -0.0 );
+
+    std::srand( 42 );
+
+    while ( values.size() < std::size_t( n ) )
+    {
+        double const mantissa = double( std::rand() ) / RAND_MAX;
+        int    const exponent = std::rand() % 61 - 30;
+
+        values.push_back( ( std::rand() % 2 ? 1 : -1 ) * mantissa * std::pow( 10.0, exponent ) );
+    }
+
+    return values;
+}
+
+int verify( std::vector<double> const & values )
+{
+    int mismatches = 0;
+
+    for ( double v : values )
+    {
+        for ( int digits = 0; digits <= 6; ++digits )
+        {
+            for ( int flags = 0; flags < 4; ++flags )
+            {
+                bool const exponential = flags & 1;
+                bool const showpos     = flags & 2;
+
+                std::string const expect = stream_engineering_string( v, digits, exponential, showpos, "m/s" );
+                std::string const actual = to_engineering_string( v, digits, exponential, showpos, "m/s" );
+
+                if ( expect != actual && ++mismatches <= 10 )
+                {
+                    cout << setprecision( 17 ) << v << ", digits " << digits << ": '" << expect << "' != '" << actual << "'\n";
+                }
+            }
+        }
+    }
+    return mismatches;
+}
+
+template< typename F >
+double time_format( F format, std::vector<double> const & values, std::size_t & total )
+{
+    clock_t start = clock();
+    for ( double v : values )
+    {
+        total += format( v );
+    }
+    clock_t stop = clock();
+
+    return double( stop - start ) / CLOCKS_PER_SEC;
+}
+
+int main()
+{
+    std::vector<double> const values = make_values( k * meg );
+
+    const int mismatches = verify( std::vector<double>( values.begin(), values.begin() + values.size() / 10 ) );
+
+    std::size_t total1 = 0, total2 = 0, total3 = 0;
+
+    const double t_stream = time_format( []( double v ) { return stream_engineering_string( v, 3, false, false, "N" ).size(); }, values, total1 );
+    const double t_string = time_format( []( double v ) { return to_engineering_string( v, 3, false, false, "N" ).size(); }, values, total2 );
+    const double t_chars  = time_format( []( double v ) { char text[64]; return std::size_t( to_engineering_chars( text, text + sizeof text, v, 3, false, false, "N" ).ptr - text ); }, values, total3 );
+
+    const int n = values.size();
+
+    cout << fixed << setprecision( 1 ) <<
+        "values: " << n << ", mismatches: " << mismatches << "\n" <<
+        "std::ostringstream:     " << 1e9 * t_stream / n << " ns/op\n" <<
+        "to_engineering_string:  " << 1e9 * t_string / n << " ns/op\n" <<
+        "to_engineering_chars:   " << 1e9 * t_chars  / n << " ns/op\n";
+
+    if ( total1 != total2 || total1 != total3 )
+        cout << "(unexpected length)" << endl;
+
+    return mismatches != 0;
+}
+
+// g++ -Wall -Wextra -Weffc++ -std=c++11 -O2 -I../../ -o time_engineering.exe time_engineering.cpp && time_engineering.exe
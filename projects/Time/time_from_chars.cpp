@@ -0,0 +1,109 @@
+//
+// time_from_chars.cpp - parsing throughput for quantity library
+//
+// This code is provided as-is, with no warrantee of correctness.
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This program measures the throughput of from_chars() on unit-annotated
+// fields such as "12.5 km/h" and compares it with std::regex and std::stod.
+
+#include "phys/units/quantity.hpp"
+#include "phys/units/quantity_io_input.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <vector>
+#include <time.h>
+
+using namespace phys::units;
+using namespace std;
+
+const int meg = 1000000;
+const int k = 2; // scale factor - make it bigger for faster machines
+
+/// newline-separated fields.
+
+std::string make_fields( int const n )
+{
+    char const * const units[] = { "km/h", "m/s", "m s-1", "mm/ms" };
+
+    std::string text;
+    for ( int i = 0; i < n; ++i )
+    {
+        text += std::to_string( ( i % 1000 ) * 0.125 ) + " " + units[ i % 4 ] + "\n";
+    }
+    return text;
+}
+
+double time_from_chars( std::string const & text, Rep & sum )
+{
+    char const * p = text.data();
+    char const * const last = p + text.size();
+
+    clock_t start = clock();
+    while ( p != last )
+    {
+        quantity<speed_d> v;
+        auto const result = from_chars( p, last, v );
+
+        if ( result.ec != std::errc() )
+        {
+            cout << "parse error at: " << std::string( p, std::min( p + 20, last ) ) << endl;
+            break;
+        }
+        sum += v.magnitude();
+        p = result.ptr + 1;
+    }
+    clock_t stop = clock();
+
+    return double( stop - start ) / CLOCKS_PER_SEC;
+}
+
+double time_regex_stod( std::string const & text, Rep & sum )
+{
+    std::regex const field( "([-+0-9.eE]+) *([^\\n]*)\\n" );
+
+    clock_t start = clock();
+    for ( std::sregex_iterator it( text.begin(), text.end(), field ), end; it != end; ++it )
+    {
+        Rep const value = std::stod( ( *it )[1].str() );
+        std::string const unit = ( *it )[2].str();
+
+        sum += unit == "km/h" ? value / 3.6 : unit == "mm/ms" ? value : value;
+    }
+    clock_t stop = clock();
+
+    return double( stop - start ) / CLOCKS_PER_SEC;
+}
+
+int main()
+{
+    const int n = k * meg;
+
+    std::string const text = make_fields( n );
+    std::string const part = text.substr( 0, text.find( '\n', text.size() / 20 ) + 1 );
+
+    Rep sum1 = 0, sum2 = 0;
+
+    const double t_parse = time_from_chars( text, sum1 );
+    const double t_regex = time_regex_stod( part, sum2 );
+
+    const double mb_text = text.size() / 1e6;
+    const double mb_part = part.size() / 1e6;
+
+    cout << fixed << setprecision( 1 ) <<
+        "fields: " << n << ", " << mb_text << " MB\n" <<
+        "from_chars:        " << mb_text / t_parse << " MB/s, " << 1e9 * t_parse / n << " ns/field\n" <<
+        "std::regex + stod: " << mb_part / t_regex << " MB/s\n";
+
+    if ( sum1 == 0 || sum2 == 0 )
+        cout << "(unexpected sum)" << endl;
+
+    return 0;
+}
+
+// g++ -Wall -Wextra -Weffc++ -std=c++11 -O2 -I../../ -o time_from_chars.exe time_from_chars.cpp && time_from_chars.exe
@@ -0,0 +1,118 @@
+//
+// time_prefix.cpp - performance of prefix lookup for quantity library
+//
+// This code is provided as-is, with no warrantee of correctness.
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This program compares the table-based prefix() of quantity_io.hpp
+// with the previous implementation that built a std::map on every call.
+
+#include "phys/units/quantity.hpp"
+#include "phys/units/quantity_io.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <time.h>
+
+using namespace phys::units;
+using namespace std;
+
+const int meg = 1000000;
+const int k = 1; // scale factor - make it bigger for faster machines
+
+// previous implementation, for reference.
+
+Rep map_prefix( std::string const prefix_ )
+{
+    std::map< std::string, Rep > prefixes;
+
+    prefixes["E"] = exa;
+    prefixes["P"] = peta;
+    prefixes["T"] = tera;
+    prefixes["G"] = giga;
+    prefixes["M"] = mega;
+    prefixes["k"] = kilo;
+    prefixes["h"] = hecto;
+    prefixes["da"]= deka;
+    prefixes["d"] = deci;
+    prefixes["c"] = centi;
+    prefixes["m"] = milli;
+    prefixes["u"] = micro;
+    prefixes["n"] = nano;
+    prefixes["p"] = pico;
+    prefixes["f"] = femto;
+    prefixes["a"] = atto;
+    prefixes["Y"] = yotta;
+    prefixes["Z"] = zetta;
+    prefixes["z"] = zepto;
+    prefixes["y"] = yocto;
+
+    if ( prefixes.count( prefix_ ) )
+    {
+        return prefixes[ prefix_ ];
+    }
+    else
+    {
+        throw prefix_error( "quantity: unrecognized prefix '" + prefix_ + "'" );
+    }
+}
+
+const std::string symbols[] = { "k", "M", "m", "u", "da", "n", "G", "c" };
+const int nsymbols = sizeof symbols / sizeof symbols[0];
+
+template< typename F >
+double time_lookup( F lookup, int const n )
+{
+    Rep sum = 0;
+
+    clock_t start = clock();
+    for ( int i = 0; i < n; ++i )
+    {
+        sum += lookup( symbols[ i % nsymbols ] );
+    }
+    clock_t stop = clock();
+
+    if ( sum == 0 )
+        cout << "(unexpected sum)" << endl;
+
+    return double( stop - start ) / CLOCKS_PER_SEC;
+}
+
+Rep table_prefix( std::string const & s )
+{
+    return prefix( s.data(), s.size() );
+}
+
+Rep table_prefix_ec( std::string const & s )
+{
+    std::error_code ec;
+    return prefix( s.data(), s.size(), ec );
+}
+
+int main()
+{
+    const int n = k * meg;
+
+    const double t_map   = time_lookup( map_prefix, n );
+    const double t_table = time_lookup( table_prefix, n );
+    const double t_ec    = time_lookup( table_prefix_ec, n );
+
+    cout << fixed << setprecision( 3 ) <<
+        "prefix lookups: " << n << "\n" <<
+        "std::map per call:         " << t_map   << " s, " << 1e9 * t_map   / n << " ns/op\n" <<
+        "table:                     " << t_table << " s, " << 1e9 * t_table / n << " ns/op\n" <<
+        "table, error_code variant: " << t_ec    << " s, " << 1e9 * t_ec    / n << " ns/op\n";
+
+    if ( t_table > 0 )
+    {
+        cout << "speedup: " << setprecision( 1 ) << t_map / t_table << "x" << endl;
+    }
+
+    return 0;
+}
+
+// g++ -Wall -Wextra -Weffc++ -std=c++11 -O2 -I../../ -o time_prefix.exe time_prefix.cpp && time_prefix.exe
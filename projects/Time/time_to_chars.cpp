@@ -0,0 +1,94 @@
+//
+// time_to_chars.cpp - formatting throughput for quantity library
+//
+// This code is provided as-is, with no warrantee of correctness.
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This program compares to_chars() with io::to_string(), which formats
+// via std::ostringstream.
+
+#include "phys/units/quantity.hpp"
+#include "phys/units/quantity_io.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <time.h>
+
+using namespace phys::units;
+using namespace std;
+
+const int meg = 1000000;
+const int k = 1; // scale factor - make it bigger for faster machines
+
+typedef quantity< dimensions< 1, 1, -1 > > momentum;
+
+// magnitudes with full 53-bit mantissas, as from measurements.
+
+std::vector<double> magnitudes()
+{
+    std::mt19937_64 random( 42 );
+    std::uniform_real_distribution<double> distribution( 0, 1000 );
+
+    std::vector<double> v( 1024 );
+
+    for ( double & x : v )
+        x = distribution( random );
+
+    return v;
+}
+
+std::vector<double> const values = magnitudes();
+
+double time_to_chars( int const n, std::size_t & total )
+{
+    char text[64];
+
+    clock_t start = clock();
+    for ( int i = 0; i < n; ++i )
+    {
+        auto const result = to_chars( text, text + sizeof text, momentum( detail::magnitude_tag, values[i % values.size()] ) );
+        total += result.ptr - text;
+    }
+    clock_t stop = clock();
+
+    return double( stop - start ) / CLOCKS_PER_SEC;
+}
+
+double time_to_string( int const n, std::size_t & total )
+{
+    clock_t start = clock();
+    for ( int i = 0; i < n; ++i )
+    {
+        total += io::to_string( momentum( detail::magnitude_tag, values[i % values.size()] ) ).size();
+    }
+    clock_t stop = clock();
+
+    return double( stop - start ) / CLOCKS_PER_SEC;
+}
+
+int main()
+{
+    const int n = k * meg;
+
+    std::size_t total1 = 0, total2 = 0;
+
+    const double t_chars  = time_to_chars ( n, total1 );
+    const double t_string = time_to_string( n, total2 );
+
+    cout << fixed << setprecision( 1 ) <<
+        "quantities: " << n << "\n" <<
+        "to_chars:      " << 1e9 * t_chars  / n << " ns/op, " << n / t_chars  / 1e6 << " M/s\n" <<
+        "io::to_string: " << 1e9 * t_string / n << " ns/op, " << n / t_string / 1e6 << " M/s\n";
+
+    if ( total1 == 0 || total2 == 0 )
+        cout << "(unexpected length)" << endl;
+
+    return 0;
+}
+
+// g++ -Wall -Wextra -Weffc++ -std=c++11 -O2 -I../../ -o time_to_chars.exe time_to_chars.cpp && time_to_chars.exe
@@ -40,7 +40,7 @@ goto :EOF
 :COMPILE
 setlocal
 set OPT=%*
-g++ -Wall -Wextra -Weffc++ -std=c++11 %G_OPT% %OPT% -I../../../ -o time_performance.exe ../../Time/time_performance.cpp && time_performance
+g++ -Wall -Wextra -Weffc++ -std=c++11 -pthread %G_OPT% %OPT% -I../../../ -o time_benchmark.exe ../../Time/time_benchmark.cpp && time_benchmark
 endlocal & goto :EOF
 
 :MSGNONOPT